@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 
 #ifndef BIT
 #define BIT(x) (((uint64_t)1) << (x))
@@ -31,6 +32,10 @@
 
 #include "runtime/aub_mem_dump/aub_data.h"
 
+namespace OCLRT {
+class AubFileWriter;
+}
+
 namespace AubMemDump {
 #include "aub_services.h"
 
@@ -121,6 +126,8 @@ struct AubStream {
 };
 
 struct AubFileStream : public AubStream {
+    AubFileStream();
+    ~AubFileStream() override;
     void open(const char *filePath) override;
     void close() override;
     bool init(uint32_t stepping, uint32_t device) override;
@@ -136,6 +143,9 @@ struct AubFileStream : public AubStream {
     MOCKABLE_VIRTUAL bool addComment(const char *message);
 
     std::ofstream fileHandle;
+    std::unique_ptr<OCLRT::AubFileWriter> writer;
+    // identifies the file being written, changes every time the stream is (re)opened
+    uint32_t fileId = 0;
 };
 
 template <int addressingBits>
@@ -21,6 +21,7 @@
  */
 
 #include "aub_mem_dump.h"
+#include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/memory_constants.h"
@@ -132,8 +133,9 @@ template <typename Traits>
 void AubDump<Traits>::reserveAddressGGTTAndWriteMmeory(typename Traits::Stream &stream, uintptr_t gfxAddress, const void *memory, uint64_t physAddress, size_t size, size_t offset, uint64_t additionalBits) {
     auto vmAddr = (gfxAddress + offset) & ~(MemoryConstants::pageSize - 1);
     auto pAddr = physAddress & ~(MemoryConstants::pageSize - 1);
+    auto reservedSize = alignUp(static_cast<size_t>(physAddress - pAddr) + size, MemoryConstants::pageSize);
 
-    AubDump<Traits>::reserveAddressPPGTT(stream, vmAddr, MemoryConstants::pageSize, pAddr, additionalBits);
+    AubDump<Traits>::reserveAddressPPGTT(stream, vmAddr, reservedSize, pAddr, additionalBits);
 
     AubDump<Traits>::addMemoryWrite(stream, physAddress,
                                     reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(memory) + offset),
@@ -23,6 +23,7 @@
 #include "runtime/built_ins/sip.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/command_queue/command_queue_hw.h"
+#include "runtime/command_queue/kernel_stats_aggregator.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
@@ -89,6 +90,11 @@ CommandQueue::CommandQueue(Context *context,
 
     commandQueueProperties = getCmdQueueProperties<cl_command_queue_properties>(properties);
     flushStamp.reset(new FlushStampTracker(true));
+
+    for (auto &heap : indirectHeap) {
+        heap = nullptr;
+    }
+    ownsIndirectHeaps = device && DebugManager.flags.EnableParallelCommandRecording.get();
 }
 
 CommandQueue::~CommandQueue() {
@@ -108,6 +114,17 @@ CommandQueue::~CommandQueue() {
         }
         delete commandStream;
 
+        for (int i = 0; i < IndirectHeap::NUM_TYPES; i++) {
+            if (indirectHeap[i] == nullptr) {
+                continue;
+            }
+            auto allocation = indirectHeap[i]->getGraphicsAllocation();
+            if (allocation) {
+                memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
+            }
+            delete indirectHeap[i];
+        }
+
         if (perfConfigurationData) {
             delete perfConfigurationData;
         }
@@ -154,6 +171,10 @@ void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushS
 
     DEBUG_BREAK_IF(getHwTag() < taskCountToWait);
     latestTaskCountWaited = taskCountToWait;
+
+    if (auto kernelStatsAggregator = device->getKernelStatsAggregator()) {
+        kernelStatsAggregator->collectMeasurements();
+    }
     WAIT_LEAVE()
 }
 
@@ -222,8 +243,11 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
     // Make sure we have enough room for any CSR additions
     minRequiredSize += CSRequirements::minCommandQueueCommandStreamSize;
 
-    if (commandStream->getAvailableSpace() < minRequiredSize) {
+    if (!commandStreamReceiver.obtainRingSpace(*commandStream, minRequiredSize)) {
         // If not, allocate a new block. allocate full pages
+        if (commandStreamReceiver.isRingBufferReuseEnabled()) {
+            minRequiredSize = std::max(minRequiredSize, static_cast<size_t>(CSRequirements::minCommandQueueRingSize));
+        }
         minRequiredSize = alignUp(minRequiredSize, MemoryConstants::pageSize);
 
         auto requiredSize = minRequiredSize + CSRequirements::csOverfetchSize;
@@ -244,6 +268,7 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
         }
         commandStream->replaceBuffer(allocation->getUnderlyingBuffer(), minRequiredSize - CSRequirements::minCommandQueueCommandStreamSize);
         commandStream->replaceGraphicsAllocation(allocation);
+        commandStreamReceiver.resetRingTracker(*commandStream, commandStreamRingTracker);
     }
 
     return *commandStream;
@@ -583,7 +608,29 @@ bool CommandQueue::setupDebugSurface(Kernel *kernel) {
 }
 
 IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType, size_t minRequiredSize) {
-    return this->getDevice().getCommandStreamReceiver().getIndirectHeap(heapType, minRequiredSize);
+    auto &commandStreamReceiver = this->getDevice().getCommandStreamReceiver();
+    if (!ownsIndirectHeaps) {
+        return commandStreamReceiver.getIndirectHeap(heapType, minRequiredSize);
+    }
+
+    DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= ARRAY_COUNT(indirectHeap));
+    auto &heap = indirectHeap[heapType];
+    GraphicsAllocation *heapMemory = nullptr;
+
+    if (heap)
+        heapMemory = heap->getGraphicsAllocation();
+
+    if (heapMemory && !commandStreamReceiver.obtainRingSpace(*heap, minRequiredSize)) {
+        commandStreamReceiver.getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heapMemory = nullptr;
+    }
+
+    if (!heapMemory) {
+        commandStreamReceiver.allocateHeapMemory(heapType, minRequiredSize, heap);
+        commandStreamReceiver.resetRingTracker(*heap, indirectHeapRingTracker[heapType]);
+    }
+
+    return *heap;
 }
 
 void CommandQueue::allocateHeapMemory(IndirectHeap::Type heapType, size_t minRequiredSize, IndirectHeap *&indirectHeap) {
@@ -591,7 +638,25 @@ void CommandQueue::allocateHeapMemory(IndirectHeap::Type heapType, size_t minReq
 }
 
 void CommandQueue::releaseIndirectHeap(IndirectHeap::Type heapType) {
-    this->getDevice().getCommandStreamReceiver().releaseIndirectHeap(heapType);
+    auto &commandStreamReceiver = this->getDevice().getCommandStreamReceiver();
+    if (!ownsIndirectHeaps) {
+        commandStreamReceiver.releaseIndirectHeap(heapType);
+        return;
+    }
+
+    DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= ARRAY_COUNT(indirectHeap));
+    auto &heap = indirectHeap[heapType];
+
+    if (heap) {
+        auto heapMemory = heap->getGraphicsAllocation();
+        if (heapMemory != nullptr)
+            commandStreamReceiver.getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heap->replaceBuffer(nullptr, 0);
+        heap->replaceGraphicsAllocation(nullptr);
+        if (heap->getRingTracker()) {
+            heap->getRingTracker()->reset();
+        }
+    }
 }
 
 } // namespace OCLRT
@@ -22,6 +22,8 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/fill_pattern_pool.h"
+#include "runtime/command_stream/ring_buffer_tracker.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/properties_helper.h"
@@ -29,6 +31,7 @@
 #include "runtime/os_interface/performance_counters.h"
 #include <atomic>
 #include <cstdint>
+#include <mutex>
 
 namespace OCLRT {
 class Buffer;
@@ -332,6 +335,7 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     Context *getContextPtr() { return context; }
 
     LinearStream &getCS(size_t minRequiredSize = 1024u);
+    FillPatternPool &getFillPatternPool() { return fillPatternPool; }
     IndirectHeap &getIndirectHeap(IndirectHeap::Type heapType,
                                   size_t minRequiredSize);
 
@@ -340,6 +344,9 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     MOCKABLE_VIRTUAL void releaseIndirectHeap(IndirectHeap::Type heapType);
 
+    bool peekOwnsIndirectHeaps() const { return ownsIndirectHeaps; }
+    RingBufferTracker *getCommandStreamRingTracker() const { return commandStreamRingTracker.get(); }
+
     cl_command_queue_properties getCommandQueueProperties() const {
         return commandQueueProperties;
     }
@@ -431,6 +438,16 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     bool perfCountersRegsCfgPending;
 
     LinearStream *commandStream;
+    FillPatternPool fillPatternPool;
+
+    // Queue owning its heaps records commands without holding the device,
+    // recordingMtx serializes enqueues on this queue instead.
+    bool ownsIndirectHeaps = false;
+    IndirectHeap *indirectHeap[IndirectHeap::NUM_TYPES];
+    std::mutex recordingMtx;
+
+    std::unique_ptr<RingBufferTracker> commandStreamRingTracker;
+    std::unique_ptr<RingBufferTracker> indirectHeapRingTracker[IndirectHeap::NUM_TYPES];
 
     bool mapDcFlushRequired = false;
     bool isSpecialCommandQueue = false;
@@ -65,6 +65,10 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
         *eventsRequest.outEvent = outEventObj;
     }
 
+    std::unique_lock<std::mutex> recordingLock(recordingMtx, std::defer_lock);
+    if (ownsIndirectHeaps) {
+        recordingLock.lock();
+    }
     TakeOwnershipWrapper<Device> deviceOwnership(*device);
     TakeOwnershipWrapper<CommandQueue> queueOwnership(*this);
 
@@ -96,6 +100,9 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
 
     queueOwnership.unlock();
     deviceOwnership.unlock();
+    if (recordingLock.owns_lock()) {
+        recordingLock.unlock();
+    }
 
     // read/write buffers are always blocking
     if (!blockQueue || transferProperties.blocking) {
@@ -27,6 +27,8 @@
 #include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/command_queue/kernel_stats_aggregator.h"
+#include "runtime/command_queue/lws_autotuner.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/event/event_builder.h"
 #include "runtime/gtpin/gtpin_notify.h"
@@ -42,6 +44,9 @@
 #include "runtime/program/printf_handler.h"
 #include "runtime/program/block_kernel_manager.h"
 #include "runtime/utilities/range.h"
+#include "runtime/utilities/runtime_tracer.h"
+#include "runtime/utilities/tag_allocator.h"
+#include <algorithm>
 #include <memory>
 #include <new>
 
@@ -87,6 +92,14 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface *(&surfaces)[surfaceCount
             forceDispatchScheduler(multiDispatchInfo);
         } else {
             if (kernel->getKernelInfo().builtinDispatchBuilder == nullptr) {
+                size_t tunedLocalWorkSizes[3];
+                auto lwsAutotuner = device->getLwsAutotuner();
+                if (lwsAutotuner && localWorkSizesIn == nullptr && commandType == CL_COMMAND_NDRANGE_KERNEL && !kernel->isParentKernel &&
+                    kernel->getKernelInfo().reqdWorkGroupSize[0] == WorkloadInfo::undefinedOffset) {
+                    if (lwsAutotuner->getLocalWorkSize(*kernel, workDim, workItems, tunedLocalWorkSizes)) {
+                        localWorkSizesIn = tunedLocalWorkSizes;
+                    }
+                }
                 DispatchInfoBuilder<SplitDispatch::Dim::d3D, SplitDispatch::SplitMode::WalkerSplit> builder;
                 builder.setDispatchGeometry(workDim, workItems, localWorkSizesIn, globalOffsets);
                 builder.setKernel(kernel);
@@ -149,6 +162,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
         return;
     }
 
+    TRACE_SCOPE(Enqueue, "enqueueHandler");
     bool executionModelKernel = multiDispatchInfo.empty() ? false : multiDispatchInfo.begin()->getKernel()->isParentKernel;
     Kernel *parentKernel = executionModelKernel ? multiDispatchInfo.begin()->getKernel() : nullptr;
     auto devQueue = this->getContext().getDefaultDeviceQueue();
@@ -156,7 +170,31 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     HwTimeStamps *hwTimeStamps = nullptr;
 
-    TakeOwnershipWrapper<Device> deviceOwnership(*device);
+    // A queue owning its heaps records commands without the device lock when nothing can block it,
+    // the device is taken only around submission. The blocked state is checked under the queue ownership,
+    // as event unblocking updates it. Kernels with debug surfaces keep the device lock, the surface is owned
+    // by the command stream receiver.
+    std::unique_lock<std::mutex> recordingLock(recordingMtx, std::defer_lock);
+    TakeOwnershipWrapper<Device> deviceOwnership(*device, false);
+    TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this, false);
+    bool recordWithoutDevice = false;
+    if (ownsIndirectHeaps) {
+        recordingLock.lock();
+        bool kernelDebugEnabled = commandType == CL_COMMAND_NDRANGE_KERNEL &&
+                                  multiDispatchInfo.begin()->getKernel()->getProgram()->isKernelDebugEnabled();
+        if (!executionModelKernel && !gtpinIsGTPinInitialized() && !kernelDebugEnabled) {
+            queueOwnership.lock();
+            recordWithoutDevice = !isQueueBlocked() &&
+                                  (getTaskLevelFromWaitList(0u, numEventsInWaitList, eventWaitList) != Event::eventNotReady);
+            if (!recordWithoutDevice) {
+                queueOwnership.unlock();
+            }
+        }
+    }
+    if (!recordWithoutDevice) {
+        deviceOwnership.lock();
+        queueOwnership.lock();
+    }
 
     TimeStampData queueTimeStamp;
     if (isProfilingEnabled() && event) {
@@ -185,11 +223,28 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
     bool slmUsed = false;
     EngineType engineType = device->getEngineType();
     auto preemption = PreemptionHelper::taskPreemptionMode(*device, multiDispatchInfo);
-    TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
 
     auto blockQueue = false;
     auto taskLevel = 0u;
     obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, commandType);
+    DEBUG_BREAK_IF(recordWithoutDevice && blockQueue);
+
+    // shapes under autotuning are timed even when the application does not profile them
+    TagNode<HwTimeStamps> *lwsTuningTimeStamps = nullptr;
+    auto lwsAutotuner = device->getLwsAutotuner();
+    if (lwsAutotuner && commandType == CL_COMMAND_NDRANGE_KERNEL && !profilingRequired && !blockQueue && multiDispatchInfo.size() == 1) {
+        auto &dispatchInfo = *multiDispatchInfo.begin();
+        lwsTuningTimeStamps = lwsAutotuner->obtainTimeStamps(*dispatchInfo.getKernel(), dispatchInfo.getGWS(), dispatchInfo.getLocalWorkgroupSize());
+        profilingRequired = lwsTuningTimeStamps != nullptr;
+    }
+
+    // kernels timed neither for the application nor for autotuning feed the runtime statistics
+    KernelStatsAggregator::Measurement *kernelStatsMeasurement = nullptr;
+    auto kernelStatsAggregator = device->getKernelStatsAggregator();
+    if (kernelStatsAggregator && commandType == CL_COMMAND_NDRANGE_KERNEL && !profilingRequired && !blockQueue && !executionModelKernel && multiDispatchInfo.size() == 1) {
+        kernelStatsMeasurement = kernelStatsAggregator->obtainMeasurement(multiDispatchInfo.begin()->getKernel()->getKernelInfo());
+        profilingRequired = kernelStatsMeasurement != nullptr;
+    }
 
     auto &commandStream = getCommandStream<GfxFamily, commandType>(*this, profilingRequired, perfCountersRequired, multiDispatchInfo);
     auto commandStreamStart = commandStream.getUsed();
@@ -206,6 +261,22 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             ;
     }
 
+    // Queues owning their heaps may record the same kernel concurrently, so its cross-thread data, printf and
+    // debug surfaces are guarded by the kernel ownership while recording. Kernels are taken in address order,
+    // after the device and queue. With GTPin every enqueue records under the device lock and the kernel is
+    // already owned by clEnqueueNDRangeKernel.
+    std::vector<Kernel *> recordedKernels;
+    if (ownsIndirectHeaps && !gtpinIsGTPinInitialized() && multiDispatchInfo.empty() == false) {
+        for (auto &dispatchInfo : multiDispatchInfo) {
+            recordedKernels.push_back(dispatchInfo.getKernel());
+        }
+        std::sort(recordedKernels.begin(), recordedKernels.end());
+        recordedKernels.erase(std::unique(recordedKernels.begin(), recordedKernels.end()), recordedKernels.end());
+        for (auto kernel : recordedKernels) {
+            kernel->takeOwnership(true);
+        }
+    }
+
     enqueueHandlerHook(commandType, multiDispatchInfo);
 
     if (multiDispatchInfo.empty() == false) {
@@ -231,6 +302,10 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                 //PERF COUNTER: copy current configuration from queue to event
                 eventBuilder.getEvent()->copyPerfCounters(this->getPerfCountersConfigData());
             }
+        } else if (lwsTuningTimeStamps) {
+            hwTimeStamps = lwsTuningTimeStamps->tag;
+        } else if (kernelStatsMeasurement) {
+            hwTimeStamps = kernelStatsMeasurement->timeStamps->tag;
         }
 
         if (executionModelKernel) {
@@ -256,6 +331,28 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             blockQueue,
             commandType);
 
+        slmUsed = multiDispatchInfo.usesSlm();
+
+        for (auto kernel : recordedKernels) {
+            kernel->releaseOwnership();
+        }
+    }
+
+    if (recordWithoutDevice) {
+        // keep the device -> queue lock order used by event unblocking
+        queueOwnership.unlock();
+        deviceOwnership.lock();
+        queueOwnership.lock();
+    }
+
+    if (multiDispatchInfo.empty() == false) {
+        if (lwsTuningTimeStamps) {
+            commandStreamReceiver.makeResident(*lwsTuningTimeStamps->getGraphicsAllocation());
+        }
+        if (kernelStatsMeasurement) {
+            commandStreamReceiver.makeResident(*kernelStatsMeasurement->timeStamps->getGraphicsAllocation());
+        }
+
         if (DebugManager.flags.AddPatchInfoCommentsForAUBDump.get()) {
             for (auto &dispatchInfo : multiDispatchInfo) {
                 for (auto &patchInfoData : dispatchInfo.getKernel()->getPatchInfoDataList()) {
@@ -265,8 +362,6 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
         }
 
         commandStreamReceiver.setRequiredScratchSize(multiDispatchInfo.getRequiredScratchSize());
-
-        slmUsed = multiDispatchInfo.usesSlm();
     }
 
     CompletionStamp completionStamp;
@@ -326,6 +421,10 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                 slmUsed,
                 printfHandler.get());
 
+            if (kernelStatsMeasurement) {
+                kernelStatsAggregator->setSubmitted(kernelStatsMeasurement);
+            }
+
             if (eventBuilder.getEvent()) {
                 eventBuilder.getEvent()->flushStamp->replaceStampObject(this->flushStamp->getStampReference());
             }
@@ -406,6 +505,9 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     queueOwnership.unlock();
     deviceOwnership.unlock();
+    if (recordingLock.owns_lock()) {
+        recordingLock.unlock();
+    }
 
     if (blocking) {
         if (blockQueue) {
@@ -483,6 +585,7 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
     bool slmUsed,
     PrintfHandler *printfHandler) {
 
+    TRACE_SCOPE(Enqueue, "enqueueNonBlocked");
     UNRECOVERABLE_IF(multiDispatchInfo.empty());
 
     auto &commandStreamReceiver = device->getCommandStreamReceiver();
@@ -598,6 +701,7 @@ void CommandQueueHw<GfxFamily>::enqueueBlocked(
     EventBuilder &externalEventBuilder,
     std::unique_ptr<PrintfHandler> printfHandler) {
 
+    TRACE_SCOPE(Enqueue, "enqueueBlocked");
     auto &commandStreamReceiver = device->getCommandStreamReceiver();
 
     TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
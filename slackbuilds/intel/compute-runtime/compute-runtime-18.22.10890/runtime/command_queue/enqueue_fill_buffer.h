@@ -46,18 +46,15 @@ cl_int CommandQueueHw<GfxFamily>::enqueueFillBuffer(
     auto memoryManager = getDevice().getMemoryManager();
     DEBUG_BREAK_IF(nullptr == memoryManager);
 
-    auto patternAllocation = memoryManager->allocateGraphicsMemory(alignUp(patternSize, MemoryConstants::cacheLineSize), MemoryConstants::preferredAlignment);
-    patternAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN);
-
-    if (patternSize == 1) {
-        int patternInt = (uint32_t)((*(uint8_t *)pattern << 24) | (*(uint8_t *)pattern << 16) | (*(uint8_t *)pattern << 8) | *(uint8_t *)pattern);
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), sizeof(int), &patternInt, sizeof(int));
-    } else if (patternSize == 2) {
-        int patternInt = (uint32_t)((*(uint16_t *)pattern << 16) | *(uint16_t *)pattern);
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), sizeof(int), &patternInt, sizeof(int));
-    } else {
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), patternSize, pattern, patternSize);
+    auto patternSlot = fillPatternPool.obtainSlot(*memoryManager, patternSize, getHwTag());
+    GraphicsAllocation *patternAllocation = fillPatternPool.peekAllocation();
+    void *patternStorage = patternSlot;
+    if (!patternSlot) {
+        patternAllocation = memoryManager->allocateGraphicsMemory(alignUp(patternSize, MemoryConstants::cacheLineSize), MemoryConstants::preferredAlignment);
+        patternAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN);
+        patternStorage = patternAllocation->getUnderlyingBuffer();
     }
+    FillPatternPool::writePattern(patternStorage, pattern, patternSize);
 
     MultiDispatchInfo dispatchInfo;
 
@@ -67,8 +64,8 @@ cl_int CommandQueueHw<GfxFamily>::enqueueFillBuffer(
     builder.takeOwnership(this->context);
 
     BuiltinDispatchInfoBuilder::BuiltinOpParams dc;
-    MemObj patternMemObj(this->context, 0, 0, alignUp(patternSize, 4), patternAllocation->getUnderlyingBuffer(),
-                         patternAllocation->getUnderlyingBuffer(), patternAllocation, false, false, true);
+    MemObj patternMemObj(this->context, 0, 0, alignUp(patternSize, 4), patternStorage,
+                         patternStorage, patternAllocation, false, false, true);
     dc.srcMemObj = &patternMemObj;
     dc.dstMemObj = buffer;
     dc.dstOffset = {offset, 0, 0};
@@ -87,7 +84,11 @@ cl_int CommandQueueHw<GfxFamily>::enqueueFillBuffer(
         eventWaitList,
         event);
 
-    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(patternAllocation), TEMPORARY_ALLOCATION, taskCount);
+    if (patternSlot) {
+        fillPatternPool.releaseSlot(patternSlot, taskCount);
+    } else {
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(patternAllocation), TEMPORARY_ALLOCATION, taskCount);
+    }
 
     builder.releaseOwnership();
 
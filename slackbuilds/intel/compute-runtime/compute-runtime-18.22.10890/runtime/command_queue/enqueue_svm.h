@@ -239,25 +239,21 @@ cl_int CommandQueueHw<GfxFamily>::enqueueSVMMemFill(void *svmPtr,
     auto memoryManager = getDevice().getMemoryManager();
     DEBUG_BREAK_IF(nullptr == memoryManager);
 
-    TakeOwnershipWrapper<Device> deviceOwnership(getDevice());
-    auto patternAllocation = memoryManager->obtainReusableAllocation(patternSize, false).release();
-    deviceOwnership.unlock();
-
-    if (!patternAllocation) {
-        patternAllocation = memoryManager->allocateGraphicsMemory(patternSize, MemoryConstants::preferredAlignment);
-    }
-
-    patternAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN);
-
-    if (patternSize == 1) {
-        int patternInt = (uint32_t)((*(uint8_t *)pattern << 24) | (*(uint8_t *)pattern << 16) | (*(uint8_t *)pattern << 8) | *(uint8_t *)pattern);
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), sizeof(int), &patternInt, sizeof(int));
-    } else if (patternSize == 2) {
-        int patternInt = (uint32_t)((*(uint16_t *)pattern << 16) | *(uint16_t *)pattern);
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), sizeof(int), &patternInt, sizeof(int));
-    } else {
-        memcpy_s(patternAllocation->getUnderlyingBuffer(), patternSize, pattern, patternSize);
+    auto patternSlot = fillPatternPool.obtainSlot(*memoryManager, patternSize, getHwTag());
+    GraphicsAllocation *patternAllocation = fillPatternPool.peekAllocation();
+    void *patternStorage = patternSlot;
+    if (!patternSlot) {
+        TakeOwnershipWrapper<Device> deviceOwnership(getDevice());
+        patternAllocation = memoryManager->obtainReusableAllocation(patternSize, false).release();
+        deviceOwnership.unlock();
+
+        if (!patternAllocation) {
+            patternAllocation = memoryManager->allocateGraphicsMemory(patternSize, MemoryConstants::preferredAlignment);
+        }
+        patternAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN);
+        patternStorage = patternAllocation->getUnderlyingBuffer();
     }
+    FillPatternPool::writePattern(patternStorage, pattern, patternSize);
 
     MultiDispatchInfo dispatchInfo;
 
@@ -267,8 +263,8 @@ cl_int CommandQueueHw<GfxFamily>::enqueueSVMMemFill(void *svmPtr,
     builder.takeOwnership(this->context);
 
     BuiltinDispatchInfoBuilder::BuiltinOpParams operationParams;
-    MemObj patternMemObj(this->context, 0, 0, alignUp(patternSize, 4), patternAllocation->getUnderlyingBuffer(),
-                         patternAllocation->getUnderlyingBuffer(), patternAllocation, false, false, true);
+    MemObj patternMemObj(this->context, 0, 0, alignUp(patternSize, 4), patternStorage,
+                         patternStorage, patternAllocation, false, false, true);
     operationParams.srcMemObj = &patternMemObj;
     operationParams.dstPtr = svmPtr;
     operationParams.dstSvmAlloc = pSvmAlloc;
@@ -288,7 +284,11 @@ cl_int CommandQueueHw<GfxFamily>::enqueueSVMMemFill(void *svmPtr,
         eventWaitList,
         event);
 
-    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(patternAllocation), REUSABLE_ALLOCATION, taskCount);
+    if (patternSlot) {
+        fillPatternPool.releaseSlot(patternSlot, taskCount);
+    } else {
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(patternAllocation), REUSABLE_ALLOCATION, taskCount);
+    }
 
     builder.releaseOwnership();
 
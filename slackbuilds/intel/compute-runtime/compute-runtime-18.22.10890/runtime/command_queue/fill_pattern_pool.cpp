@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/fill_pattern_pool.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include <algorithm>
+
+namespace OCLRT {
+FillPatternPool::~FillPatternPool() {
+    if (allocation) {
+        // slots may still be read by GPU, free together with other temporaries once last of them completes
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), TEMPORARY_ALLOCATION, lastTaskCount);
+    }
+}
+
+void *FillPatternPool::obtainSlot(MemoryManager &memoryManager, size_t patternSize, uint32_t completedTaskCount) {
+    if (patternSize > slotSize) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!allocation) {
+        allocation = memoryManager.allocateGraphicsMemory(slotsCount * slotSize, MemoryConstants::preferredAlignment);
+        if (!allocation) {
+            return nullptr;
+        }
+        allocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN);
+        this->memoryManager = &memoryManager;
+    }
+
+    // slots are used in order, when the oldest one is busy all others are too
+    auto slotIndex = nextSlot;
+    if (slotTaskCounts[slotIndex] > completedTaskCount) {
+        return nullptr;
+    }
+    nextSlot = (nextSlot + 1) % slotsCount;
+    slotTaskCounts[slotIndex] = slotInUse;
+    return ptrOffset(allocation->getUnderlyingBuffer(), slotIndex * slotSize);
+}
+
+void FillPatternPool::releaseSlot(void *slot, uint32_t taskCount) {
+    auto slotIndex = ptrDiff(slot, allocation->getUnderlyingBuffer()) / slotSize;
+    DEBUG_BREAK_IF(slotIndex >= slotsCount);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    slotTaskCounts[slotIndex] = taskCount;
+    lastTaskCount = std::max(lastTaskCount, taskCount);
+}
+
+void FillPatternPool::writePattern(void *patternStorage, const void *pattern, size_t patternSize) {
+    if (patternSize == 1) {
+        int patternInt = (uint32_t)((*(uint8_t *)pattern << 24) | (*(uint8_t *)pattern << 16) | (*(uint8_t *)pattern << 8) | *(uint8_t *)pattern);
+        memcpy_s(patternStorage, sizeof(int), &patternInt, sizeof(int));
+    } else if (patternSize == 2) {
+        int patternInt = (uint32_t)((*(uint16_t *)pattern << 16) | *(uint16_t *)pattern);
+        memcpy_s(patternStorage, sizeof(int), &patternInt, sizeof(int));
+    } else {
+        memcpy_s(patternStorage, patternSize, pattern, patternSize);
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+// Ring of fill pattern slots carved from a single long-lived allocation.
+// Slot is handed out again once the task that used it has completed,
+// fills don't have to create and destroy an allocation per enqueue.
+class FillPatternPool {
+  public:
+    // max pattern size accepted by clEnqueueFillBuffer and clEnqueueSVMMemFill
+    static const size_t slotSize = 128;
+    static const uint32_t slotsCount = 64;
+    static const uint32_t slotInUse = 0xFFFFFFFFu;
+
+    ~FillPatternPool();
+
+    // returns nullptr when pattern doesn't fit or the next slot is still used by GPU,
+    // the ring advances only when a slot is handed out
+    void *obtainSlot(MemoryManager &memoryManager, size_t patternSize, uint32_t completedTaskCount);
+    void releaseSlot(void *slot, uint32_t taskCount);
+
+    GraphicsAllocation *peekAllocation() const { return allocation; }
+    uint32_t peekSlotTaskCount(uint32_t slotIndex) const { return slotTaskCounts[slotIndex]; }
+
+    static void writePattern(void *patternStorage, const void *pattern, size_t patternSize);
+
+  protected:
+    MemoryManager *memoryManager = nullptr;
+    GraphicsAllocation *allocation = nullptr;
+    uint32_t slotTaskCounts[slotsCount] = {};
+    uint32_t nextSlot = 0;
+    uint32_t lastTaskCount = 0;
+    std::mutex mtx;
+};
+} // namespace OCLRT
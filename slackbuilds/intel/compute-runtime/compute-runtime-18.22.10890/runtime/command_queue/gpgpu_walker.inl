@@ -36,6 +36,7 @@
 #include "runtime/helpers/validators.h"
 #include "runtime/mem_obj/mem_obj.h"
 #include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include <algorithm>
 #include <cmath>
 
@@ -444,6 +445,7 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchWalker(
     bool blockQueue,
     uint32_t commandType) {
 
+    TRACE_SCOPE(Enqueue, "dispatchWalker");
     OCLRT::LinearStream *commandStream = nullptr;
     OCLRT::IndirectHeap *dsh = nullptr, *ioh = nullptr, *ssh = nullptr;
     bool executionModelKernel = multiDispatchInfo.begin()->getKernel()->isParentKernel;
@@ -495,6 +497,9 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchWalker(
         ssh = &getIndirectHeap<GfxFamily, IndirectHeap::SURFACE_STATE>(commandQueue, multiDispatchInfo);
     }
 
+    // commands below are written without atomics, within the space required by the whole dispatch
+    commandStream->reserveSpace(EnqueueOperation<GfxFamily>::getTotalSizeRequiredCS(hwTimeStamps != nullptr, hwPerfCounter != nullptr, commandQueue, multiDispatchInfo));
+
     using INTERFACE_DESCRIPTOR_DATA = typename GfxFamily::INTERFACE_DESCRIPTOR_DATA;
 
     dsh->align(KernelCommandsHelper<GfxFamily>::alignInterfaceDescriptorData);
@@ -616,30 +621,41 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchWalker(
         // Program the walker.  Invokes execution so all state should already be programmed
         typedef typename GfxFamily::GPGPU_WALKER GPGPU_WALKER;
         auto pGpGpuWalkerCmd = (GPGPU_WALKER *)commandStream->getSpace(sizeof(GPGPU_WALKER));
-        *pGpGpuWalkerCmd = GfxFamily::cmdInitGpgpuWalker;
 
-        size_t globalOffsets[3] = {offset.x, offset.y, offset.z};
-        size_t startWorkGroups[3] = {swgs.x, swgs.y, swgs.z};
-        size_t numWorkGroups[3] = {nwgs.x, nwgs.y, nwgs.z};
-        auto localWorkSize = GpgpuWalkerHelper<GfxFamily>::setGpgpuWalkerThreadData(pGpGpuWalkerCmd, globalOffsets, startWorkGroups, numWorkGroups, localWorkSizes, simd);
+        // Walker only depends on dispatch geometry, replay it when the kernel is enqueued the same way again
+        auto &walkerTemplate = kernel.getDispatchTemplates().walker;
+        WalkerTemplateKey walkerKey = {{lws.x, lws.y, lws.z}, {swgs.x, swgs.y, swgs.z}, {nwgs.x, nwgs.y, nwgs.z}, simd};
+        bool useDispatchTemplates = !DebugManager.flags.DisableDispatchTemplates.get();
+        if (!useDispatchTemplates || !walkerTemplate.lookup(walkerKey, *pGpGpuWalkerCmd)) {
+            *pGpGpuWalkerCmd = GfxFamily::cmdInitGpgpuWalker;
 
-        pGpGpuWalkerCmd->setIndirectDataStartAddress((uint32_t)offsetCrossThreadData);
-        DEBUG_BREAK_IF(offsetCrossThreadData % 64 != 0);
-        pGpGpuWalkerCmd->setInterfaceDescriptorOffset(interfaceDescriptorIndex++);
+            size_t globalOffsets[3] = {offset.x, offset.y, offset.z};
+            size_t startWorkGroups[3] = {swgs.x, swgs.y, swgs.z};
+            size_t numWorkGroups[3] = {nwgs.x, nwgs.y, nwgs.z};
+            auto localWorkSize = GpgpuWalkerHelper<GfxFamily>::setGpgpuWalkerThreadData(pGpGpuWalkerCmd, globalOffsets, startWorkGroups, numWorkGroups, localWorkSizes, simd);
 
-        auto threadPayload = kernel.getKernelInfo().patchInfo.threadPayload;
-        DEBUG_BREAK_IF(nullptr == threadPayload);
+            auto threadPayload = kernel.getKernelInfo().patchInfo.threadPayload;
+            DEBUG_BREAK_IF(nullptr == threadPayload);
 
-        auto numChannels = PerThreadDataHelper::getNumLocalIdChannels(*threadPayload);
-        auto localIdSizePerThread = PerThreadDataHelper::getLocalIdSizePerThread(simd, numChannels);
-        localIdSizePerThread = std::max(localIdSizePerThread, sizeof(GRF));
+            auto numChannels = PerThreadDataHelper::getNumLocalIdChannels(*threadPayload);
+            auto localIdSizePerThread = PerThreadDataHelper::getLocalIdSizePerThread(simd, numChannels);
+            localIdSizePerThread = std::max(localIdSizePerThread, sizeof(GRF));
 
-        auto sizePerThreadDataTotal = getThreadsPerWG(simd, localWorkSize) * localIdSizePerThread;
-        DEBUG_BREAK_IF(sizePerThreadDataTotal == 0); // Hardware requires at least 1 GRF of perThreadData for each thread in thread group
+            auto sizePerThreadDataTotal = getThreadsPerWG(simd, localWorkSize) * localIdSizePerThread;
+            DEBUG_BREAK_IF(sizePerThreadDataTotal == 0); // Hardware requires at least 1 GRF of perThreadData for each thread in thread group
 
-        auto sizeCrossThreadData = kernel.getCrossThreadDataSize();
-        auto IndirectDataLength = alignUp((uint32_t)(sizeCrossThreadData + sizePerThreadDataTotal), GPGPU_WALKER::INDIRECTDATASTARTADDRESS_ALIGN_SIZE);
-        pGpGpuWalkerCmd->setIndirectDataLength(IndirectDataLength);
+            auto sizeCrossThreadData = kernel.getCrossThreadDataSize();
+            auto IndirectDataLength = alignUp((uint32_t)(sizeCrossThreadData + sizePerThreadDataTotal), GPGPU_WALKER::INDIRECTDATASTARTADDRESS_ALIGN_SIZE);
+            pGpGpuWalkerCmd->setIndirectDataLength(IndirectDataLength);
+
+            if (useDispatchTemplates) {
+                walkerTemplate.record(walkerKey, *pGpGpuWalkerCmd);
+            }
+        }
+
+        pGpGpuWalkerCmd->setIndirectDataStartAddress((uint32_t)offsetCrossThreadData);
+        DEBUG_BREAK_IF(offsetCrossThreadData % 64 != 0);
+        pGpGpuWalkerCmd->setInterfaceDescriptorOffset(interfaceDescriptorIndex++);
 
         // Implement disabling special WA DisableLSQCROPERFforOCL if needed
         GpgpuWalkerHelper<GfxFamily>::applyWADisableLSQCROPERFforOCL(commandStream, kernel, false);
@@ -654,6 +670,8 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchWalker(
     if (hwPerfCounter != nullptr) {
         GpgpuWalkerHelper<GfxFamily>::dispatchPerfCountersCommandsEnd(commandQueue, *hwPerfCounter, commandStream);
     }
+
+    commandStream->commitReservedSpace();
 }
 
 template <typename GfxFamily>
@@ -857,6 +875,10 @@ size_t EnqueueOperation<GfxFamily>::getTotalSizeRequiredCS(bool reserveProfiling
     Device &device = commandQueue.getDevice();
     for (auto &dispatchInfo : multiDispatchInfo) {
         auto &kernel = *dispatchInfo.getKernel();
+        if (&dispatchInfo != &*multiDispatchInfo.begin()) {
+            // each further interface descriptor is selected with its own media state flush
+            size += sizeof(typename GfxFamily::MEDIA_STATE_FLUSH);
+        }
         size += sizeof(typename GfxFamily::GPGPU_WALKER);
         size += GpgpuWalkerHelper<GfxFamily>::getSizeForWADisableLSQCROPERFforOCL(&kernel);
         size += PreemptionHelper::getPreemptionWaCsSize<GfxFamily>(device);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/kernel_stats_aggregator.h"
+#include "runtime/event/event.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "runtime/program/kernel_info.h"
+#include "runtime/utilities/tag_allocator.h"
+
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+namespace OCLRT {
+
+const uint32_t KernelStatsAggregator::histogramBuckets;
+const size_t KernelStatsAggregator::maxPendingMeasurements;
+std::atomic<uint32_t> KernelStatsAggregator::dumpRequests{0};
+
+namespace {
+std::once_flag dumpSignalInstalled;
+
+#ifdef _WIN32
+void onDumpSignal(int signalNumber) {
+    // the handler is reset to the default one on delivery
+    std::signal(signalNumber, &onDumpSignal);
+    KernelStatsAggregator::requestDump(signalNumber);
+}
+#else
+struct sigaction previousDumpSignalAction = {};
+
+// chains to the handler installed before, unless it is the default or ignore disposition
+void onDumpSignal(int signalNumber, siginfo_t *info, void *context) {
+    KernelStatsAggregator::requestDump(signalNumber);
+    if (previousDumpSignalAction.sa_flags & SA_SIGINFO) {
+        if (previousDumpSignalAction.sa_sigaction) {
+            previousDumpSignalAction.sa_sigaction(signalNumber, info, context);
+        }
+    } else if (previousDumpSignalAction.sa_handler != SIG_DFL && previousDumpSignalAction.sa_handler != SIG_IGN) {
+        previousDumpSignalAction.sa_handler(signalNumber);
+    }
+}
+#endif
+} // namespace
+
+void KernelStatsAggregator::Histogram::add(uint64_t nanoseconds) {
+    min = (count == 0) ? nanoseconds : std::min(min, nanoseconds);
+    max = std::max(max, nanoseconds);
+    total += nanoseconds;
+    count++;
+    buckets[getBucket(nanoseconds)]++;
+}
+
+uint32_t KernelStatsAggregator::Histogram::getBucket(uint64_t nanoseconds) {
+    uint32_t bucket = 0;
+    while (nanoseconds >>= 1) {
+        bucket++;
+    }
+    return std::min(bucket, histogramBuckets - 1);
+}
+
+KernelStatsAggregator::KernelStatsAggregator(MemoryManager *memoryManager, OSTime *osTime, double timerResolution, uint32_t deviceId, const std::string &statsFilePath)
+    : memoryManager(memoryManager), osTime(osTime), timerResolution(timerResolution), deviceId(deviceId), statsFilePath(statsFilePath) {
+    measurements.reset(new Measurement[maxPendingMeasurements]);
+    for (size_t i = 0; i < maxPendingMeasurements; i++) {
+        measurements[i].next = freeMeasurements;
+        freeMeasurements = &measurements[i];
+    }
+    dumpRequestsHandled = dumpRequests.load();
+}
+
+KernelStatsAggregator::~KernelStatsAggregator() {
+    collectMeasurements();
+    dumpToFile();
+
+    auto allocator = memoryManager->getEventTsAllocator();
+    for (auto measurement = firstPendingMeasurement; measurement; measurement = measurement->next) {
+        allocator->returnTag(measurement->timeStamps);
+    }
+}
+
+// same KernelInfo address with a different name means the program was released and its memory reused
+KernelStatsAggregator::KernelStats *KernelStatsAggregator::obtainKernelStats(const KernelInfo &kernelInfo) {
+    auto &kernelStatsEntry = kernelStatsLookup[&kernelInfo];
+    if (kernelStatsEntry && kernelStatsEntry->kernelName == kernelInfo.name) {
+        return kernelStatsEntry;
+    }
+    kernelStats.emplace_back(new KernelStats);
+    kernelStatsEntry = kernelStats.back().get();
+    kernelStatsEntry->kernelName = kernelInfo.name;
+    return kernelStatsEntry;
+}
+
+KernelStatsAggregator::Measurement *KernelStatsAggregator::obtainMeasurement(const KernelInfo &kernelInfo) {
+    TimeStampData queueTimeStamp = {};
+    if (!osTime || !osTime->getCpuGpuTime(&queueTimeStamp)) {
+        return nullptr;
+    }
+
+    Measurement *measurement = nullptr;
+    for (int attempt = 0; attempt < 2 && !measurement; attempt++) {
+        if (attempt) {
+            collectMeasurements();
+        }
+        std::lock_guard<std::mutex> lock(kernelStatsMtx);
+        if (!freeMeasurements) {
+            continue;
+        }
+        measurement = freeMeasurements;
+        freeMeasurements = measurement->next;
+        measurement->kernelStats = obtainKernelStats(kernelInfo);
+    }
+    if (!measurement) {
+        return nullptr;
+    }
+
+    measurement->timeStamps = memoryManager->getEventTsAllocator()->getTag();
+    *measurement->timeStamps->tag = {};
+    measurement->queueTimeStamp = queueTimeStamp;
+    measurement->submitTimeStamp = 0;
+    measurement->submitted.store(false, std::memory_order_relaxed);
+    measurement->next = nullptr;
+
+    std::lock_guard<std::mutex> lock(kernelStatsMtx);
+    if (lastPendingMeasurement) {
+        lastPendingMeasurement->next = measurement;
+    } else {
+        firstPendingMeasurement = measurement;
+    }
+    lastPendingMeasurement = measurement;
+    return measurement;
+}
+
+void KernelStatsAggregator::setSubmitted(Measurement *measurement) {
+    osTime->getCpuTime(&measurement->submitTimeStamp);
+    measurement->submitted.store(true, std::memory_order_release);
+}
+
+void KernelStatsAggregator::collectMeasurements() {
+    std::unique_lock<std::mutex> lock(collectMtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    collectMeasurementsImpl();
+
+    // the signal handler only bumps the request counter, the dump is written here
+    auto requests = dumpRequests.load();
+    if (requests != dumpRequestsHandled) {
+        dumpRequestsHandled = requests;
+        dumpToFileImpl();
+    }
+}
+
+// measurements leave the in flight list only here, so the head stays valid while collectMtx is held
+void KernelStatsAggregator::collectMeasurementsImpl() {
+    auto allocator = memoryManager->getEventTsAllocator();
+    while (true) {
+        Measurement *measurement = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(kernelStatsMtx);
+            measurement = firstPendingMeasurement;
+        }
+        if (!measurement || !measurement->submitted.load(std::memory_order_acquire)) {
+            return;
+        }
+        volatile HwTimeStamps *timeStamps = measurement->timeStamps->tag;
+        if (timeStamps->ContextEndTS == 0) {
+            return;
+        }
+
+        // CpuTime = GpuTime * resolution + c0, c0 taken from the CPU / GPU pair read at enqueue
+        auto &queueTimeStamp = measurement->queueTimeStamp;
+        int64_t c0 = static_cast<int64_t>(queueTimeStamp.CPUTimeinNS) - static_cast<int64_t>(queueTimeStamp.GPUTimeStamp * timerResolution);
+        int64_t startTimeStamp = static_cast<int64_t>(timeStamps->GlobalStartTS * timerResolution) + c0;
+        int64_t submitTimeStamp = static_cast<int64_t>(measurement->submitTimeStamp);
+        uint64_t contextStart = timeStamps->ContextStartTS;
+        uint64_t contextEnd = timeStamps->ContextEndTS;
+
+        auto kernelStats = measurement->kernelStats;
+        kernelStats->queueToSubmit.add(measurement->submitTimeStamp > queueTimeStamp.CPUTimeinNS ? measurement->submitTimeStamp - queueTimeStamp.CPUTimeinNS : 0);
+        kernelStats->submitToStart.add(startTimeStamp > submitTimeStamp ? static_cast<uint64_t>(startTimeStamp - submitTimeStamp) : 0);
+        kernelStats->execution.add(static_cast<uint64_t>(Event::getDelta(contextStart, contextEnd) * timerResolution));
+        allocator->returnTag(measurement->timeStamps);
+
+        std::lock_guard<std::mutex> lock(kernelStatsMtx);
+        firstPendingMeasurement = measurement->next;
+        if (!firstPendingMeasurement) {
+            lastPendingMeasurement = nullptr;
+        }
+        measurement->next = freeMeasurements;
+        freeMeasurements = measurement;
+    }
+}
+
+bool KernelStatsAggregator::getKernelStats(const KernelInfo &kernelInfo, KernelStats &stats) {
+    std::lock_guard<std::mutex> collectLock(collectMtx);
+    std::lock_guard<std::mutex> lock(kernelStatsMtx);
+    auto it = kernelStatsLookup.find(&kernelInfo);
+    if (it == kernelStatsLookup.end() || it->second->kernelName != kernelInfo.name) {
+        return false;
+    }
+    stats = *it->second;
+    return true;
+}
+
+// histograms are only written under collectMtx, which the caller holds
+std::vector<KernelStatsAggregator::KernelStats *> KernelStatsAggregator::getCollectedKernelStats() {
+    std::vector<KernelStats *> collectedKernelStats;
+    std::lock_guard<std::mutex> lock(kernelStatsMtx);
+    for (auto &stats : kernelStats) {
+        if (stats->execution.count) {
+            collectedKernelStats.push_back(stats.get());
+        }
+    }
+    return collectedKernelStats;
+}
+
+void KernelStatsAggregator::dump(std::ostream &out) {
+    std::lock_guard<std::mutex> lock(collectMtx);
+    dumpImpl(out);
+}
+
+// one line per kernel and metric, durations in ns, histogram lists non empty log2 buckets as bucket:count
+void KernelStatsAggregator::dumpImpl(std::ostream &out) {
+    auto collectedKernelStats = getCollectedKernelStats();
+    out << "device=0x" << std::hex << deviceId << std::dec << " kernels=" << collectedKernelStats.size() << "\n";
+    for (auto stats : collectedKernelStats) {
+        const std::pair<const char *, const Histogram *> metrics[] = {
+            {"queueToSubmit", &stats->queueToSubmit},
+            {"submitToStart", &stats->submitToStart},
+            {"execution", &stats->execution}};
+        for (auto &metric : metrics) {
+            auto &histogram = *metric.second;
+            out << "kernel=" << stats->kernelName << " metric=" << metric.first
+                << " count=" << histogram.count
+                << " minNs=" << histogram.min
+                << " avgNs=" << (histogram.count ? histogram.total / histogram.count : 0)
+                << " maxNs=" << histogram.max
+                << " log2NsHistogram=";
+            bool first = true;
+            for (uint32_t bucket = 0; bucket < histogramBuckets; bucket++) {
+                if (histogram.buckets[bucket]) {
+                    out << (first ? "" : ",") << bucket << ":" << histogram.buckets[bucket];
+                    first = false;
+                }
+            }
+            out << "\n";
+        }
+    }
+}
+
+bool KernelStatsAggregator::dumpToFile() {
+    std::lock_guard<std::mutex> lock(collectMtx);
+    return dumpToFileImpl();
+}
+
+bool KernelStatsAggregator::dumpToFileImpl() {
+    if (statsFilePath.empty() || getCollectedKernelStats().empty()) {
+        return false;
+    }
+    std::ofstream statsFile(statsFilePath, std::ios::app);
+    if (!statsFile.is_open()) {
+        return false;
+    }
+    dumpImpl(statsFile);
+    return true;
+}
+
+void KernelStatsAggregator::installDumpSignal(int signalNumber) {
+    std::call_once(dumpSignalInstalled, [signalNumber]() {
+#ifdef _WIN32
+        std::signal(signalNumber, &onDumpSignal);
+#else
+        struct sigaction action = {};
+        action.sa_sigaction = &onDumpSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(signalNumber, &action, &previousDumpSignalAction);
+#endif
+    });
+}
+
+// only touches a lock free counter, the dump itself happens on the next collection
+void KernelStatsAggregator::requestDump(int signalNumber) {
+    dumpRequests++;
+}
+} // namespace OCLRT
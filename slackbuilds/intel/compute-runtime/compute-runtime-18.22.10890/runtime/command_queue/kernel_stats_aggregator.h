@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/event/hw_timestamps.h"
+#include "runtime/os_interface/os_time.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OCLRT {
+class MemoryManager;
+struct KernelInfo;
+template <typename TagType>
+struct TagNode;
+
+// Times every kernel dispatch that is not already profiled for the application
+// and keeps per kernel histograms of queue to submit, submit to start and
+// execution time. GPU timestamps are converted to CPU time with the OSTime
+// correlation taken at enqueue. Measurements are collected when a queue waits
+// for completion. Statistics are appended to a file when the device is destroyed
+// and on the first collection after the configured signal is raised.
+class KernelStatsAggregator {
+  public:
+    static const uint32_t histogramBuckets = 40;
+    static const size_t maxPendingMeasurements = 4096;
+
+    // bucket i counts durations in [2^i, 2^(i+1)) ns, the last bucket also takes longer ones
+    struct Histogram {
+        uint64_t count = 0;
+        uint64_t total = 0;
+        uint64_t min = 0;
+        uint64_t max = 0;
+        uint64_t buckets[histogramBuckets] = {};
+
+        void add(uint64_t nanoseconds);
+        static uint32_t getBucket(uint64_t nanoseconds);
+    };
+
+    struct KernelStats {
+        std::string kernelName;
+        Histogram queueToSubmit;
+        Histogram submitToStart;
+        Histogram execution;
+    };
+
+    // handle of a dispatch being timed, owned by the aggregator
+    struct Measurement {
+        KernelStats *kernelStats;
+        TagNode<HwTimeStamps> *timeStamps;
+        TimeStampData queueTimeStamp;
+        uint64_t submitTimeStamp;
+        std::atomic<bool> submitted;
+        Measurement *next;
+    };
+
+    KernelStatsAggregator(MemoryManager *memoryManager, OSTime *osTime, double timerResolution, uint32_t deviceId, const std::string &statsFilePath);
+    ~KernelStatsAggregator();
+
+    // queue time is taken here, nullptr when too many dispatches are in flight
+    Measurement *obtainMeasurement(const KernelInfo &kernelInfo);
+    void setSubmitted(Measurement *measurement);
+
+    // collects completed measurements in dispatch order and services pending dump requests,
+    // returns immediately when another thread is collecting
+    void collectMeasurements();
+    bool getKernelStats(const KernelInfo &kernelInfo, KernelStats &stats);
+    void dump(std::ostream &out);
+    bool dumpToFile();
+
+    static void installDumpSignal(int signalNumber);
+    static void requestDump(int signalNumber);
+
+  protected:
+    KernelStats *obtainKernelStats(const KernelInfo &kernelInfo);
+    void collectMeasurementsImpl();
+    std::vector<KernelStats *> getCollectedKernelStats();
+    void dumpImpl(std::ostream &out);
+    bool dumpToFileImpl();
+
+    MemoryManager *memoryManager;
+    OSTime *osTime;
+    double timerResolution;
+    uint32_t deviceId;
+    std::string statsFilePath;
+
+    // kernelStatsMtx guards the lookup and the in flight list, it is held only for constant time updates
+    std::mutex kernelStatsMtx;
+    std::unordered_map<const KernelInfo *, KernelStats *> kernelStatsLookup;
+    std::vector<std::unique_ptr<KernelStats>> kernelStats;
+    std::unique_ptr<Measurement[]> measurements;
+    Measurement *freeMeasurements = nullptr;
+    Measurement *firstPendingMeasurement = nullptr;
+    Measurement *lastPendingMeasurement = nullptr;
+
+    // collectMtx guards histograms, taken by the collecting thread and dumps
+    std::mutex collectMtx;
+    uint32_t dumpRequestsHandled = 0;
+
+    static std::atomic<uint32_t> dumpRequests;
+};
+} // namespace OCLRT
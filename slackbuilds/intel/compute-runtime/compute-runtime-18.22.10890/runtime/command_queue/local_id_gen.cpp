@@ -28,6 +28,7 @@ namespace OCLRT {
 
 struct uint16x8_t;
 struct uint16x16_t;
+struct uint16x32_t;
 
 // This is the initial value of SIMD for local ID
 // computation.  It correlates to the SIMD lane.
@@ -50,6 +51,12 @@ LocalIDHelper::LocalIDHelper() {
         LocalIDHelper::generateSimd16 = generateLocalIDsSimd<uint16x16_t, 16>;
         LocalIDHelper::generateSimd32 = generateLocalIDsSimd<uint16x16_t, 32>;
     }
+
+    // SIMD32 covers a whole thread with a single 512 bit register
+    bool supportsAVX512 = CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX512F | CpuInfo::featureAvX512Bw);
+    if (supportsAVX512) {
+        LocalIDHelper::generateSimd32 = generateLocalIDsSimd<uint16x32_t, 32>;
+    }
 }
 
 LocalIDHelper LocalIDHelper::initializer;
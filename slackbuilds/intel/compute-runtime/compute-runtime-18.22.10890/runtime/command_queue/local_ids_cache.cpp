@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/local_ids_cache.h"
+#include "runtime/command_queue/local_id_gen.h"
+#include "runtime/helpers/aligned_memory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace OCLRT {
+
+const size_t LocalIdsCache::maxEntries;
+const size_t LocalIdsCache::maxCachedSize;
+
+LocalIdsCache::LocalIdsCache() = default;
+
+LocalIdsCache::~LocalIdsCache() {
+    for (size_t i = 0; i < entriesCount; i++) {
+        alignedFree(entries[i].localIds);
+    }
+}
+
+size_t LocalIdsCache::getGeneratedSize(uint32_t simd, const size_t localWorkSizes[3]) {
+    auto localWorkSize = localWorkSizes[0] * localWorkSizes[1] * localWorkSizes[2];
+    return getThreadsPerWG(simd, localWorkSize) * getPerThreadSizeLocalIDs(simd);
+}
+
+void LocalIdsCache::generateLocalIds(void *buffer, size_t size, uint32_t simd, const size_t localWorkSizes[3]) {
+    auto cachedLocalIds = findEntry(size, simd, localWorkSizes);
+    if (cachedLocalIds) {
+        memcpy(buffer, cachedLocalIds, size);
+        return;
+    }
+
+    cachedLocalIds = addEntry(size, simd, localWorkSizes);
+    if (cachedLocalIds) {
+        memcpy(buffer, cachedLocalIds, size);
+        return;
+    }
+
+    auto generatedSize = getGeneratedSize(simd, localWorkSizes);
+    if (size >= generatedSize) {
+        generateLocalIDs(buffer, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+        return;
+    }
+    auto localIds = alignedMalloc(generatedSize, 64);
+    memset(localIds, 0, generatedSize);
+    generateLocalIDs(localIds, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+    memcpy(buffer, localIds, size);
+    alignedFree(localIds);
+}
+
+const void *LocalIdsCache::findEntry(size_t size, uint32_t simd, const size_t localWorkSizes[3]) {
+    auto count = entriesCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].matches(size, simd, localWorkSizes)) {
+            // published entries are never modified or released while the cache is alive
+            return entries[i].localIds;
+        }
+    }
+    return nullptr;
+}
+
+const void *LocalIdsCache::addEntry(size_t size, uint32_t simd, const size_t localWorkSizes[3]) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto cachedLocalIds = findEntry(size, simd, localWorkSizes);
+    if (cachedLocalIds) {
+        // another thread has already cached this shape
+        return cachedLocalIds;
+    }
+    auto count = entriesCount.load(std::memory_order_relaxed);
+    auto generatedSize = std::max(size, getGeneratedSize(simd, localWorkSizes));
+    if (count >= maxEntries || cachedSize + generatedSize > maxCachedSize) {
+        return nullptr;
+    }
+
+    // Unused SIMD lanes are zeroed so that cached blocks are deterministic
+    auto &entry = entries[count];
+    entry = {simd, {localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]}, size, alignedMalloc(generatedSize, 64)};
+    memset(entry.localIds, 0, generatedSize);
+    generateLocalIDs(entry.localIds, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+    cachedSize += generatedSize;
+    entriesCount.store(count + 1, std::memory_order_release);
+    return entry.localIds;
+}
+} // namespace OCLRT
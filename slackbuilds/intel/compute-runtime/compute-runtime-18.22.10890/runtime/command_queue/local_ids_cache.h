@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+// Keeps generated local ID blocks keyed by (simd, lws, size), so that enqueues
+// repeating a work group shape copy the block instead of regenerating it.
+// Size depends on number of local ID channels the kernel uses, while
+// generator always writes all three, so blocks are generated at full size
+// and only the requested prefix is copied out.
+// Entries are never evicted; once the cache is full new shapes are generated
+// directly into the destination. Lookups do not lock: entries are only appended
+// under mtx and published by entriesCount.
+class LocalIdsCache {
+  public:
+    static const size_t maxEntries = 64;
+    static const size_t maxCachedSize = 1024 * 1024;
+
+    LocalIdsCache();
+    ~LocalIdsCache();
+
+    void generateLocalIds(void *buffer, size_t size, uint32_t simd, const size_t localWorkSizes[3]);
+
+    size_t peekEntriesCount() const { return entriesCount; }
+    size_t peekCachedSize() const { return cachedSize; }
+
+  protected:
+    struct Entry {
+        uint32_t simd;
+        size_t localWorkSizes[3];
+        size_t size;
+        void *localIds;
+
+        bool matches(size_t size, uint32_t simd, const size_t localWorkSizes[3]) const {
+            return this->size == size &&
+                   this->simd == simd &&
+                   this->localWorkSizes[0] == localWorkSizes[0] &&
+                   this->localWorkSizes[1] == localWorkSizes[1] &&
+                   this->localWorkSizes[2] == localWorkSizes[2];
+        }
+    };
+
+    static size_t getGeneratedSize(uint32_t simd, const size_t localWorkSizes[3]);
+
+    const void *findEntry(size_t size, uint32_t simd, const size_t localWorkSizes[3]);
+    const void *addEntry(size_t size, uint32_t simd, const size_t localWorkSizes[3]);
+
+    Entry entries[maxEntries];
+    std::atomic<size_t> entriesCount{0};
+    size_t cachedSize = 0;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/command_queue/lws_autotuner.h"
+#include "runtime/device/device.h"
+#include "runtime/event/event.h"
+#include "runtime/kernel/kernel.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace OCLRT {
+
+const size_t LwsAutotuner::maxCandidates;
+const uint32_t LwsAutotuner::samplesPerCandidate;
+
+LwsAutotuner::LwsAutotuner(MemoryManager *memoryManager, uint32_t deviceId, const std::string &profileFilePath)
+    : memoryManager(memoryManager), deviceId(deviceId), profileFilePath(profileFilePath) {
+    loadProfiles();
+}
+
+LwsAutotuner::~LwsAutotuner() {
+    auto allocator = memoryManager->getEventTsAllocator();
+    for (auto &measurement : pendingMeasurements) {
+        allocator->returnTag(measurement.timeStamps);
+    }
+    pendingMeasurements.clear();
+
+    // profile file is written only here, keeping file I/O off the enqueue path
+    if (profilesDirty) {
+        saveProfiles();
+    }
+}
+
+std::vector<Vec3<size_t>> LwsAutotuner::generateCandidates(const Vec3<size_t> &gws, uint32_t workDim, const Vec3<size_t> &defaultLws,
+                                                           size_t maxWorkGroupSize, const size_t maxWorkItemSizes[3], uint32_t simd) {
+    const size_t workItems[3] = {gws.x, gws.y, gws.z};
+    std::vector<size_t> divisors[3];
+    for (uint32_t dim = 0; dim < 3; dim++) {
+        auto limit = dim < workDim ? std::min(maxWorkGroupSize, maxWorkItemSizes[dim]) : 1;
+        for (size_t divisor = 1; divisor <= std::min(limit, workItems[dim]); divisor++) {
+            if (workItems[dim] % divisor == 0) {
+                divisors[dim].push_back(divisor);
+            }
+        }
+    }
+
+    // shapes dividing gws evenly, ranked by SIMD lane utilization and then by size
+    struct RankedShape {
+        Vec3<size_t> lws;
+        size_t usedLanes;
+        size_t totalLanes;
+    };
+    std::vector<RankedShape> shapes;
+    for (auto x : divisors[0]) {
+        for (auto y : divisors[1]) {
+            for (auto z : divisors[2]) {
+                auto size = x * y * z;
+                if (size > maxWorkGroupSize) {
+                    continue;
+                }
+                auto threads = (size + simd - 1) / simd;
+                shapes.push_back({{x, y, z}, size, threads * simd});
+            }
+        }
+    }
+    std::stable_sort(shapes.begin(), shapes.end(), [](const RankedShape &a, const RankedShape &b) {
+        if (a.usedLanes * b.totalLanes != b.usedLanes * a.totalLanes) {
+            return a.usedLanes * b.totalLanes > b.usedLanes * a.totalLanes;
+        }
+        return a.usedLanes > b.usedLanes;
+    });
+
+    std::vector<Vec3<size_t>> candidates;
+    candidates.push_back(defaultLws);
+    for (auto &shape : shapes) {
+        if (candidates.size() == maxCandidates) {
+            break;
+        }
+        if (std::find(candidates.begin(), candidates.end(), shape.lws) == candidates.end()) {
+            candidates.push_back(shape.lws);
+        }
+    }
+    return candidates;
+}
+
+bool LwsAutotuner::getLocalWorkSize(Kernel &kernel, uint32_t workDim, const size_t workItems[3], size_t localWorkSize[3]) {
+    ProfileKey key = {kernel.getKernelInfo().getIsaHash(), {workItems[0], workDim > 1 ? workItems[1] : 1, workDim > 2 ? workItems[2] : 1}};
+    Vec3<size_t> lws(0, 0, 0);
+    if (!selectLocalWorkSize(key, lws)) {
+        Vec3<size_t> gws(key.gws);
+        DispatchInfo dispatchInfo(&kernel, workDim, gws, Vec3<size_t>(0, 0, 0), Vec3<size_t>(0, 0, 0));
+        auto defaultLws = computeWorkgroupSize(dispatchInfo);
+        auto &deviceInfo = kernel.getDevice().getDeviceInfo();
+        startTuning(key, generateCandidates(gws, workDim, defaultLws, deviceInfo.maxWorkGroupSize, deviceInfo.maxWorkItemSizes,
+                                            kernel.getKernelInfo().getMaxSimdSize()));
+        selectLocalWorkSize(key, lws);
+    }
+    if (lws.x == 0) {
+        return false;
+    }
+    localWorkSize[0] = lws.x;
+    localWorkSize[1] = lws.y;
+    localWorkSize[2] = lws.z;
+    return true;
+}
+
+TagNode<HwTimeStamps> *LwsAutotuner::obtainTimeStamps(const Kernel &kernel, const Vec3<size_t> &gws, const Vec3<size_t> &lws) {
+    ProfileKey key = {kernel.getKernelInfo().getIsaHash(), {gws.x, gws.y, gws.z}};
+    return obtainTimeStamps(key, lws);
+}
+
+bool LwsAutotuner::selectLocalWorkSize(const ProfileKey &key, Vec3<size_t> &lws) {
+    std::lock_guard<std::mutex> lock(mtx);
+    collectMeasurements();
+
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+    auto &entry = it->second;
+    if (entry.tuned) {
+        lws = entry.best;
+    } else if (entry.dispatchesIssued < entry.candidates.size() * samplesPerCandidate) {
+        lws = entry.candidates[entry.dispatchesIssued % entry.candidates.size()];
+    } else {
+        // every candidate is in flight, keep the heuristic choice until results arrive
+        lws = entry.candidates[0];
+    }
+    return true;
+}
+
+void LwsAutotuner::startTuning(const ProfileKey &key, const std::vector<Vec3<size_t>> &candidates) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto &entry = entries[key];
+    if (entry.tuned || !entry.candidates.empty()) {
+        return;
+    }
+    entry.candidates = candidates;
+    entry.durations.assign(candidates.size(), std::numeric_limits<uint64_t>::max());
+    if (candidates.size() <= 1) {
+        entry.best = candidates.empty() ? Vec3<size_t>(0, 0, 0) : candidates[0];
+        entry.tuned = true;
+    }
+}
+
+TagNode<HwTimeStamps> *LwsAutotuner::obtainTimeStamps(const ProfileKey &key, const Vec3<size_t> &lws) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.tuned) {
+        return nullptr;
+    }
+    auto &entry = it->second;
+    if (entry.dispatchesIssued >= entry.candidates.size() * samplesPerCandidate) {
+        return nullptr;
+    }
+    auto candidate = entry.dispatchesIssued % entry.candidates.size();
+    if (entry.candidates[candidate] != lws) {
+        return nullptr;
+    }
+
+    auto timeStamps = memoryManager->getEventTsAllocator()->getTag();
+    *timeStamps->tag = {};
+    pendingMeasurements.push_back({key, candidate, timeStamps});
+    entry.dispatchesIssued++;
+    return timeStamps;
+}
+
+void LwsAutotuner::collectMeasurements() {
+    auto allocator = memoryManager->getEventTsAllocator();
+    for (size_t i = 0; i < pendingMeasurements.size();) {
+        auto &measurement = pendingMeasurements[i];
+        volatile HwTimeStamps *timeStamps = measurement.timeStamps->tag;
+        if (timeStamps->ContextEndTS == 0) {
+            i++;
+            continue;
+        }
+
+        auto &entry = entries[measurement.key];
+        uint64_t start = timeStamps->ContextStartTS;
+        uint64_t end = timeStamps->ContextEndTS;
+        entry.durations[measurement.candidate] = std::min(entry.durations[measurement.candidate], Event::getDelta(start, end));
+        entry.measurementsDone++;
+        if (entry.measurementsDone == entry.candidates.size() * samplesPerCandidate) {
+            finishTuning(entry);
+        }
+
+        allocator->returnTag(measurement.timeStamps);
+        pendingMeasurements[i] = pendingMeasurements.back();
+        pendingMeasurements.pop_back();
+    }
+}
+
+void LwsAutotuner::finishTuning(TuningEntry &entry) {
+    auto fastest = std::min_element(entry.durations.begin(), entry.durations.end());
+    entry.best = entry.candidates[fastest - entry.durations.begin()];
+    entry.tuned = true;
+    entry.candidates.clear();
+    entry.durations.clear();
+    profilesDirty = true;
+}
+
+bool LwsAutotuner::loadProfiles() {
+    if (profileFilePath.empty()) {
+        return false;
+    }
+    std::ifstream file(profileFilePath);
+    if (!file.good()) {
+        return false;
+    }
+
+    // one profile per line: device id, kernel hash, gws and the selected lws
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        uint32_t profileDeviceId = 0;
+        ProfileKey key = {};
+        size_t lws[3] = {};
+        if (!(stream >> std::hex >> profileDeviceId >> key.kernelHash >> std::dec >> key.gws[0] >> key.gws[1] >> key.gws[2] >> lws[0] >> lws[1] >> lws[2])) {
+            continue;
+        }
+        if (profileDeviceId != deviceId) {
+            otherDevicesProfiles.push_back(line);
+            continue;
+        }
+        auto &entry = entries[key];
+        entry.best = lws;
+        entry.tuned = true;
+    }
+    return true;
+}
+
+bool LwsAutotuner::saveProfiles() {
+    profilesDirty = false;
+    if (profileFilePath.empty()) {
+        return false;
+    }
+
+    // unique across threads and processes saving profiles at the same time
+    std::stringstream tempFilePathStream;
+    tempFilePathStream << profileFilePath << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id())
+                       << "." << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    std::string tempFilePath = tempFilePathStream.str();
+    {
+        std::ofstream file(tempFilePath, std::ios::trunc);
+        if (!file.good()) {
+            return false;
+        }
+        for (auto &line : otherDevicesProfiles) {
+            file << line << "\n";
+        }
+        for (auto &profile : entries) {
+            if (!profile.second.tuned || profile.second.best.x == 0) {
+                continue;
+            }
+            auto &key = profile.first;
+            auto &lws = profile.second.best;
+            file << std::hex << deviceId << " " << key.kernelHash << std::dec
+                 << " " << key.gws[0] << " " << key.gws[1] << " " << key.gws[2]
+                 << " " << lws.x << " " << lws.y << " " << lws.z << "\n";
+        }
+        if (!file.good()) {
+            return false;
+        }
+    }
+    // readers only ever see complete files
+    if (std::rename(tempFilePath.c_str(), profileFilePath.c_str()) != 0) {
+        std::remove(tempFilePath.c_str());
+        return false;
+    }
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/event/hw_timestamps.h"
+#include "runtime/utilities/vec.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace OCLRT {
+class Kernel;
+class MemoryManager;
+template <typename TagType>
+struct TagNode;
+
+// Picks the local work size for kernels enqueued with NULL local size by
+// timing candidate shapes on their first executions. The fastest shape per
+// (kernel ISA, gws) is kept for the rest of the process and persisted in a
+// profile file shared by all devices when the autotuner is destroyed, so later
+// runs skip the tuning phase.
+class LwsAutotuner {
+  public:
+    static const size_t maxCandidates = 8;
+    static const uint32_t samplesPerCandidate = 2;
+
+    struct ProfileKey {
+        uint64_t kernelHash;
+        size_t gws[3];
+
+        bool operator<(const ProfileKey &other) const {
+            return std::tie(kernelHash, gws[0], gws[1], gws[2]) <
+                   std::tie(other.kernelHash, other.gws[0], other.gws[1], other.gws[2]);
+        }
+    };
+
+    LwsAutotuner(MemoryManager *memoryManager, uint32_t deviceId, const std::string &profileFilePath);
+    ~LwsAutotuner();
+
+    // returns false when the runtime heuristics should be used as is
+    bool getLocalWorkSize(Kernel &kernel, uint32_t workDim, const size_t workItems[3], size_t localWorkSize[3]);
+
+    // timestamps for the dispatch when it executes a shape that still needs a measurement, nullptr otherwise
+    TagNode<HwTimeStamps> *obtainTimeStamps(const Kernel &kernel, const Vec3<size_t> &gws, const Vec3<size_t> &lws);
+
+    bool selectLocalWorkSize(const ProfileKey &key, Vec3<size_t> &lws);
+    void startTuning(const ProfileKey &key, const std::vector<Vec3<size_t>> &candidates);
+    TagNode<HwTimeStamps> *obtainTimeStamps(const ProfileKey &key, const Vec3<size_t> &lws);
+
+    static std::vector<Vec3<size_t>> generateCandidates(const Vec3<size_t> &gws, uint32_t workDim, const Vec3<size_t> &defaultLws,
+                                                        size_t maxWorkGroupSize, const size_t maxWorkItemSizes[3], uint32_t simd);
+
+    bool loadProfiles();
+    bool saveProfiles();
+
+  protected:
+    struct TuningEntry {
+        std::vector<Vec3<size_t>> candidates;
+        std::vector<uint64_t> durations;
+        size_t dispatchesIssued = 0;
+        size_t measurementsDone = 0;
+        Vec3<size_t> best = {0, 0, 0};
+        bool tuned = false;
+    };
+
+    struct PendingMeasurement {
+        ProfileKey key;
+        size_t candidate;
+        TagNode<HwTimeStamps> *timeStamps;
+    };
+
+    void collectMeasurements();
+    void finishTuning(TuningEntry &entry);
+
+    MemoryManager *memoryManager;
+    uint32_t deviceId;
+    std::string profileFilePath;
+
+    std::map<ProfileKey, TuningEntry> entries;
+    std::vector<PendingMeasurement> pendingMeasurements;
+    std::vector<std::string> otherDevicesProfiles;
+    bool profilesDirty = false;
+    std::mutex mtx;
+};
+} // namespace OCLRT
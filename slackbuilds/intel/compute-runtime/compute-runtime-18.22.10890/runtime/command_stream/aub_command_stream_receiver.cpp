@@ -21,12 +21,16 @@
  */
 
 #include "runtime/command_stream/aub_command_stream_receiver.h"
+#include "runtime/command_stream/aub_file_writer.h"
+#include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc_base.h"
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <sstream>
 
@@ -72,15 +76,33 @@ static auto sizeMemoryWriteHeader = sizeof(CmdServicesMemTraceMemoryWrite) - siz
 
 extern const size_t g_dwordCountMax;
 
+static std::atomic<uint32_t> lastFileId{0};
+
+AubFileStream::AubFileStream() : fileId(++lastFileId) {}
+
+AubFileStream::~AubFileStream() = default;
+
 void AubFileStream::open(const char *filePath) {
     fileHandle.open(filePath, std::ofstream::binary);
+
+    fileId = ++lastFileId;
+
+    if (fileHandle.is_open() && OCLRT::DebugManager.flags.AubDumpBufferSizeMB.get() > 0) {
+        auto bufferSize = static_cast<size_t>(OCLRT::DebugManager.flags.AubDumpBufferSizeMB.get()) * MB;
+        writer.reset(new OCLRT::AubFileWriter(fileHandle, bufferSize));
+    }
 }
 
 void AubFileStream::close() {
+    writer.reset();
     fileHandle.close();
 }
 
 void AubFileStream::write(const char *data, size_t size) {
+    if (writer) {
+        writer->write(data, size);
+        return;
+    }
     fileHandle.write(data, size);
 }
 
@@ -144,7 +166,7 @@ void AubFileStream::writeMemoryWriteHeader(uint64_t physAddress, size_t size, ui
 }
 
 void AubFileStream::writeGTT(uint32_t gttOffset, uint64_t entry) {
-    fileHandle.write(reinterpret_cast<char *>(&entry), sizeof(entry));
+    write(reinterpret_cast<char *>(&entry), sizeof(entry));
 }
 
 void AubFileStream::writePTE(uint64_t physAddress, uint64_t entry) {
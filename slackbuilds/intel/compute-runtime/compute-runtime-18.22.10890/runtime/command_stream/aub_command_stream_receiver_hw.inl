@@ -23,11 +23,14 @@
 #include "hw_cmds.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/hash.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/gmm_helper/gmm_helper.h"
 #include "runtime/helpers/string.h"
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
 
 namespace OCLRT {
@@ -479,22 +482,37 @@ bool AUBCommandStreamReceiverHw<GfxFamily>::writeMemory(GraphicsAllocation &gfxA
     if ((size == 0) || gfxAllocation.isTypeAubNonWritable())
         return false;
 
-    {
-        std::ostringstream str;
-        str << "ppgtt: " << std::hex << std::showbase << gpuAddress;
-        stream->addComment(str.str().c_str());
-    }
-
     if (cpuAddress == nullptr) {
         DEBUG_BREAK_IF(gfxAllocation.isLocked());
         cpuAddress = this->getMemoryManager()->lockResource(&gfxAllocation);
         gfxAllocation.setLocked(true);
     }
 
-    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+    if (DebugManager.flags.AubDumpSkipUnchangedAllocations.get()) {
+        auto contentHash = Hash::hash(reinterpret_cast<const char *>(cpuAddress), size);
+        auto &aubDumpState = gfxAllocation.aubDumpState;
+        if (aubDumpState.fileId == stream->fileId && aubDumpState.size == size && aubDumpState.contentHash == contentHash) {
+            if (gfxAllocation.isLocked()) {
+                this->getMemoryManager()->unlockResource(&gfxAllocation);
+                gfxAllocation.setLocked(false);
+            }
+            return true;
+        }
+        aubDumpState.fileId = stream->fileId;
+        aubDumpState.size = size;
+        aubDumpState.contentHash = contentHash;
+    }
+
+    {
+        char comment[32];
+        snprintf(comment, sizeof(comment), "ppgtt: %#" PRIx64, static_cast<uint64_t>(gpuAddress));
+        stream->addComment(comment);
+    }
+
+    auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
         AUB::reserveAddressGGTTAndWriteMmeory(*stream, static_cast<uintptr_t>(gpuAddress), cpuAddress, physAddress, size, offset, getPPGTTAdditionalBits(&gfxAllocation));
     };
-    ppgtt.pageWalk(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
+    ppgtt.pageWalkRanges(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
 
     if (gfxAllocation.isLocked()) {
         this->getMemoryManager()->unlockResource(&gfxAllocation);
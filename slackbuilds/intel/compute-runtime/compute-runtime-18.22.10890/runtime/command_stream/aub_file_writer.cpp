@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/aub_file_writer.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/os_interface/os_thread.h"
+
+namespace OCLRT {
+const size_t AubFileWriter::maxPendingBuffers = 4;
+
+AubFileWriter::AubFileWriter(std::ostream &outputStream, size_t bufferSize)
+    : outputStream(outputStream), bufferSize(bufferSize) {
+    currentBuffer.reserve(bufferSize);
+    thread = Thread::create(writerProcess, reinterpret_cast<void *>(this));
+}
+
+AubFileWriter::~AubFileWriter() {
+    flush();
+
+    std::unique_lock<std::mutex> lock(writerMtx);
+    allowProcess = false;
+    writerCond.notify_all();
+    lock.unlock();
+
+    thread->join();
+}
+
+void AubFileWriter::write(const char *data, size_t size) {
+    currentBuffer.insert(currentBuffer.end(), data, data + size);
+    if (currentBuffer.size() >= bufferSize) {
+        submitCurrentBuffer();
+    }
+}
+
+void AubFileWriter::flush() {
+    if (!currentBuffer.empty()) {
+        submitCurrentBuffer();
+    }
+
+    std::unique_lock<std::mutex> lock(writerMtx);
+    writerCond.wait(lock, [this] { return pendingBuffers.empty() && !writing; });
+    outputStream.flush();
+}
+
+size_t AubFileWriter::peekPendingBuffersCount() {
+    std::lock_guard<std::mutex> lock(writerMtx);
+    return pendingBuffers.size();
+}
+
+void AubFileWriter::submitCurrentBuffer() {
+    std::unique_lock<std::mutex> lock(writerMtx);
+    // throttle producer when writer thread can't keep up with disk
+    writerCond.wait(lock, [this] { return pendingBuffers.size() < maxPendingBuffers; });
+
+    pendingBuffers.push_back(std::move(currentBuffer));
+    if (freeBuffers.empty()) {
+        currentBuffer = std::vector<char>();
+        currentBuffer.reserve(bufferSize);
+    } else {
+        currentBuffer = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+    }
+    writerCond.notify_all();
+}
+
+void AubFileWriter::writeToStream(const std::vector<char> &buffer) {
+    outputStream.write(buffer.data(), buffer.size());
+}
+
+void *AubFileWriter::writerProcess(void *arg) {
+    auto self = reinterpret_cast<AubFileWriter *>(arg);
+    std::unique_lock<std::mutex> lock(self->writerMtx);
+
+    while (true) {
+        self->writerCond.wait(lock, [self] { return !self->pendingBuffers.empty() || !self->allowProcess; });
+        if (self->pendingBuffers.empty()) {
+            break;
+        }
+
+        auto buffer = std::move(self->pendingBuffers.front());
+        self->pendingBuffers.pop_front();
+        self->writing = true;
+        lock.unlock();
+
+        self->writeToStream(buffer);
+        buffer.clear();
+
+        lock.lock();
+        self->writing = false;
+        if (self->freeBuffers.size() < maxPendingBuffers) {
+            self->freeBuffers.push_back(std::move(buffer));
+        }
+        self->writerCond.notify_all();
+    }
+    return nullptr;
+}
+} // namespace OCLRT
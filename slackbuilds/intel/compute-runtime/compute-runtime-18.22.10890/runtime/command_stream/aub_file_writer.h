@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace OCLRT {
+class Thread;
+
+// Buffers AUB records and writes them to the output stream from a background thread.
+// Full buffers are handed over to the writer thread so the flush path only copies data.
+class AubFileWriter {
+  public:
+    static const size_t maxPendingBuffers;
+
+    AubFileWriter(std::ostream &outputStream, size_t bufferSize);
+    virtual ~AubFileWriter();
+
+    void write(const char *data, size_t size);
+    void flush();
+
+    size_t peekBufferSize() const { return bufferSize; }
+    size_t peekPendingBuffersCount();
+
+  protected:
+    static void *writerProcess(void *arg);
+    void submitCurrentBuffer();
+    MOCKABLE_VIRTUAL void writeToStream(const std::vector<char> &buffer);
+
+    std::ostream &outputStream;
+    size_t bufferSize;
+    std::vector<char> currentBuffer;
+    std::deque<std::vector<char>> pendingBuffers;
+    std::vector<std::vector<char>> freeBuffers;
+
+    std::unique_ptr<Thread> thread;
+    std::mutex writerMtx;
+    std::condition_variable writerCond;
+    bool allowProcess = true;
+    bool writing = false;
+};
+} // namespace OCLRT
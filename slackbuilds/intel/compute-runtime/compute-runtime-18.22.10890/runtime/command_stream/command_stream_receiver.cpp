@@ -31,6 +31,7 @@
 #include "runtime/os_interface/os_interface.h"
 #include "runtime/event/event.h"
 #include "runtime/event/event_builder.h"
+#include "runtime/utilities/runtime_tracer.h"
 
 namespace OCLRT {
 // Global table of CommandStreamReceiver factories for HW and tests
@@ -43,12 +44,16 @@ CommandStreamReceiver::CommandStreamReceiver() {
         this->dispatchMode = (DispatchMode)DebugManager.flags.CsrDispatchMode.get();
     }
     flushStamp.reset(new FlushStampTracker(true));
+    tagWaiter.reset(new TagWaiter(*this));
     for (int i = 0; i < IndirectHeap::NUM_TYPES; ++i) {
         indirectHeap[i] = nullptr;
     }
+    ringBufferReuseEnabled = DebugManager.flags.EnableRingBufferReuse.get();
 }
 
 CommandStreamReceiver::~CommandStreamReceiver() {
+    closeSubmissionWorker();
+    tagWaiter->closeThread();
     for (int i = 0; i < IndirectHeap::NUM_TYPES; ++i) {
         if (indirectHeap[i] != nullptr) {
             auto allocation = indirectHeap[i]->getGraphicsAllocation();
@@ -204,22 +209,13 @@ void CommandStreamReceiver::cleanupResources() {
 }
 
 bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait) {
-    std::chrono::high_resolution_clock::time_point time1, time2;
-    int64_t timeDiff = 0;
-
+    TRACE_SCOPE(Wait, "waitForCompletionWithTimeout");
     uint32_t latestSentTaskCount = this->latestFlushedTaskCount;
     if (latestSentTaskCount < taskCountToWait) {
         this->flushBatchedSubmissions();
     }
 
-    time1 = std::chrono::high_resolution_clock::now();
-    while (*getTagAddress() < taskCountToWait && timeDiff <= timeoutMicroseconds) {
-        if (enableTimeout) {
-            time2 = std::chrono::high_resolution_clock::now();
-            timeDiff = std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
-        }
-    }
-    if (*getTagAddress() >= taskCountToWait) {
+    if (tagWaiter->waitForTag(taskCountToWait, enableTimeout, timeoutMicroseconds)) {
         if (gtpinIsGTPinInitialized()) {
             gtpinNotifyTaskCompletion(taskCountToWait);
         }
@@ -228,6 +224,32 @@ bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int
     return false;
 }
 
+void CommandStreamReceiver::waitForFlushedTaskCount(uint32_t taskCountToWait) {
+    TRACE_SCOPE(Wait, "waitForFlushedTaskCount");
+    DEBUG_BREAK_IF(taskCountToWait > latestFlushedTaskCount);
+    tagWaiter->waitForTag(taskCountToWait, false, 0);
+}
+
+void CommandStreamReceiver::dispatchBatchedSubmissions() {
+    if (batchedCommandBuffersCount == 0) {
+        return;
+    }
+    if (!submissionWorker) {
+        submissionWorker.reset(new SubmissionWorker(*this, dispatchMode));
+    }
+    if (submissionWorker->isSubmissionRequired()) {
+        this->flushBatchedSubmissions();
+        return;
+    }
+    submissionWorker->notifyWorkRecorded();
+}
+
+void CommandStreamReceiver::closeSubmissionWorker() {
+    if (submissionWorker) {
+        submissionWorker->closeThread();
+    }
+}
+
 void CommandStreamReceiver::setTagAllocation(GraphicsAllocation *allocation) {
     this->tagAllocation = allocation;
     this->tagAddress = allocation ? reinterpret_cast<uint32_t *>(allocation->getUnderlyingBuffer()) : nullptr;
@@ -254,13 +276,14 @@ IndirectHeap &CommandStreamReceiver::getIndirectHeap(IndirectHeap::Type heapType
     if (heap)
         heapMemory = heap->getGraphicsAllocation();
 
-    if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
+    if (heapMemory && !obtainRingSpace(*heap, minRequiredSize)) {
         memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
         heapMemory = nullptr;
     }
 
     if (!heapMemory) {
         allocateHeapMemory(heapType, minRequiredSize, heap);
+        resetRingTracker(*heap, heapRingTracker[heapType]);
     }
 
     return *heap;
@@ -318,6 +341,65 @@ void CommandStreamReceiver::releaseIndirectHeap(IndirectHeap::Type heapType) {
             memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
         heap->replaceBuffer(nullptr, 0);
         heap->replaceGraphicsAllocation(nullptr);
+        if (heap->getRingTracker()) {
+            heap->getRingTracker()->reset();
+        }
+    }
+}
+
+bool CommandStreamReceiver::obtainRingSpace(LinearStream &stream, size_t minRequiredSize) {
+    auto ringTracker = stream.getRingTracker();
+    if (!ringTracker || !stream.getGraphicsAllocation() || !tagAddress) {
+        return stream.getAvailableSpace() >= minRequiredSize;
+    }
+    if (minRequiredSize > stream.getMaxAvailableSpace()) {
+        return false;
+    }
+
+    uint32_t completedTaskCount = *tagAddress;
+    ringTracker->retire(completedTaskCount);
+
+    bool wrapRequired = stream.getAvailableSpace() < minRequiredSize;
+    if (wrapRequired && ringTracker->hasUnregisteredData(stream.getUsed())) {
+        return false;
+    }
+
+    auto taskCountToWait = wrapRequired ? ringTracker->getTaskCountToWrap(minRequiredSize)
+                                        : ringTracker->getTaskCountToReuse(stream.getUsed(), minRequiredSize);
+    if (taskCountToWait > completedTaskCount) {
+        // batched command buffers not sent yet still point into the ring, allocate instead of waiting for them.
+        // Queues owning their heaps get here without the device, so only flushed tasks are waited for,
+        // which never touches the batched submissions.
+        if (taskCountToWait > latestFlushedTaskCount) {
+            return false;
+        }
+        ringTracker->recordStall();
+        waitForFlushedTaskCount(taskCountToWait);
+        ringTracker->retire(taskCountToWait);
+    }
+
+    if (wrapRequired) {
+        ringTracker->wrap();
+        stream.replaceBuffer(stream.getCpuBase(), stream.getMaxAvailableSpace());
+    }
+    return true;
+}
+
+void CommandStreamReceiver::resetRingTracker(LinearStream &stream, std::unique_ptr<RingBufferTracker> &ringTracker) {
+    if (!ringBufferReuseEnabled) {
+        return;
+    }
+    if (!ringTracker) {
+        ringTracker.reset(new RingBufferTracker);
+    }
+    ringTracker->reset();
+    stream.setRingTracker(ringTracker.get());
+}
+
+void CommandStreamReceiver::registerRingSubmission(const LinearStream &stream) {
+    auto ringTracker = stream.getRingTracker();
+    if (ringTracker) {
+        ringTracker->registerSubmission(stream.getUsed(), taskCount);
     }
 }
 
@@ -21,9 +21,12 @@
  */
 
 #pragma once
+#include "runtime/command_stream/submission_worker.h"
 #include "runtime/command_stream/linear_stream.h"
+#include "runtime/command_stream/ring_buffer_tracker.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/command_stream/submissions_aggregator.h"
+#include "runtime/command_stream/tag_waiter.h"
 #include "runtime/helpers/completion_stamp.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/address_patch.h"
@@ -45,8 +48,8 @@ class GraphicsAllocation;
 enum class DispatchMode {
     DeviceDefault = 0,          //default for given device
     ImmediateDispatch,          //everything is submitted to the HW immediately
-    AdaptiveDispatch,           //dispatching is handled to async thread, which combines batch buffers basing on load (not implemented)
-    BatchedDispatchWithCounter, //dispatching is batched, after n commands there is implicit flush (not implemented)
+    AdaptiveDispatch,           //dispatching is handled to async thread, which combines batch buffers basing on load
+    BatchedDispatchWithCounter, //dispatching is batched, after n commands or deadline there is implicit flush
     BatchedDispatch             // dispatching is batched, explicit clFlush is required
 };
 
@@ -104,9 +107,14 @@ class CommandStreamReceiver {
 
     uint32_t peekLatestFlushedTaskCount() const { return latestFlushedTaskCount; }
 
+    uint32_t peekBatchedCommandBuffersCount() const { return batchedCommandBuffersCount; }
+
+    bool isGpuIdle() const { return *getTagAddress() >= latestFlushedTaskCount; }
+
     void enableNTo1SubmissionModel() { this->nTo1SubmissionModelEnabled = true; }
     bool isNTo1SubmissionModelEnabled() const { return this->nTo1SubmissionModelEnabled; }
     void overrideDispatchPolicy(DispatchMode overrideValue) { this->dispatchMode = overrideValue; }
+    void closeSubmissionWorker();
 
     virtual void overrideMediaVFEStateDirty(bool dirty) { mediaVfeStateDirty = dirty; }
 
@@ -123,6 +131,8 @@ class CommandStreamReceiver {
 
     virtual void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep) = 0;
     MOCKABLE_VIRTUAL bool waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait);
+    // waits for a task count that was already flushed, safe to call without the device ownership
+    MOCKABLE_VIRTUAL void waitForFlushedTaskCount(uint32_t taskCountToWait);
 
     void setSamplerCacheFlushRequired(SamplerCacheFlushState value) { this->samplerCacheFlushRequired = value; }
 
@@ -133,10 +143,17 @@ class CommandStreamReceiver {
     void allocateHeapMemory(IndirectHeap::Type heapType, size_t minRequiredSize, IndirectHeap *&indirectHeap);
     void releaseIndirectHeap(IndirectHeap::Type heapType);
 
+    bool obtainRingSpace(LinearStream &stream, size_t minRequiredSize);
+    void resetRingTracker(LinearStream &stream, std::unique_ptr<RingBufferTracker> &ringTracker);
+    bool isRingBufferReuseEnabled() const { return ringBufferReuseEnabled; }
+    RingBufferTracker *getHeapRingTracker(IndirectHeap::Type heapType) const { return heapRingTracker[heapType].get(); }
+
   protected:
     void setDisableL3Cache(bool val) {
         disableL3Cache = val;
     }
+    void dispatchBatchedSubmissions();
+    void registerRingSubmission(const LinearStream &stream);
 
     // taskCount - # of tasks submitted
     uint32_t taskCount = 0;
@@ -174,6 +191,9 @@ class CommandStreamReceiver {
     MemoryManager *memoryManager = nullptr;
     std::unique_ptr<OSInterface> osInterface;
     std::unique_ptr<SubmissionAggregator> submissionAggregator;
+    std::unique_ptr<SubmissionWorker> submissionWorker;
+    std::unique_ptr<TagWaiter> tagWaiter;
+    std::atomic<uint32_t> batchedCommandBuffersCount{0};
 
     bool nTo1SubmissionModelEnabled = false;
     DispatchMode dispatchMode = DispatchMode::ImmediateDispatch;
@@ -182,6 +202,8 @@ class CommandStreamReceiver {
     uint64_t totalMemoryUsed = 0u;
     SamplerCacheFlushState samplerCacheFlushRequired = SamplerCacheFlushState::samplerCacheFlushNotRequired;
     IndirectHeap *indirectHeap[IndirectHeap::NUM_TYPES];
+    std::unique_ptr<RingBufferTracker> heapRingTracker[IndirectHeap::NUM_TYPES];
+    bool ringBufferReuseEnabled = false;
     std::unique_ptr<FlatBatchBufferHelper> flatBatchBufferHelper;
 };
 
@@ -34,6 +34,7 @@
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include "command_stream_receiver_hw.h"
 
 namespace OCLRT {
@@ -133,6 +134,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
     const IndirectHeap &ssh,
     uint32_t taskLevel,
     DispatchFlags &dispatchFlags) {
+    TRACE_SCOPE(Flush, "flushTask");
     typedef typename GfxFamily::MI_BATCH_BUFFER_START MI_BATCH_BUFFER_START;
     typedef typename GfxFamily::MI_BATCH_BUFFER_END MI_BATCH_BUFFER_END;
     typedef typename GfxFamily::PIPE_CONTROL PIPE_CONTROL;
@@ -415,26 +417,35 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
             commandBuffer->pipeControlThatMayBeErasedLocation = currentPipeControlForNooping;
             commandBuffer->epiloguePipeControlLocation = epiloguePipeControlLocation;
             this->submissionAggregator->recordCommandBuffer(commandBuffer);
+            this->batchedCommandBuffersCount++;
         }
     } else {
         this->makeSurfacePackNonResident(nullptr);
     }
 
-    //check if we are not over the budget, if we are do implicit flush
+    //check if we are not over the budget, if we are give back recycled memory and do implicit flush
     if (getMemoryManager()->isMemoryBudgetExhausted()) {
+        getMemoryManager()->trimReusableAllocations(0);
         if (this->totalMemoryUsed >= device->getDeviceInfo().globalMemSize / 4) {
             dispatchFlags.implicitFlush = true;
         }
     }
 
-    if (this->dispatchMode == DispatchMode::BatchedDispatch && (dispatchFlags.blocking || dispatchFlags.implicitFlush)) {
+    if (this->dispatchMode != DispatchMode::ImmediateDispatch && (dispatchFlags.blocking || dispatchFlags.implicitFlush)) {
         this->flushBatchedSubmissions();
+    } else if (this->dispatchMode == DispatchMode::AdaptiveDispatch || this->dispatchMode == DispatchMode::BatchedDispatchWithCounter) {
+        this->dispatchBatchedSubmissions();
     }
 
     ++taskCount;
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "taskCount", taskCount);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", tagAddress ? *tagAddress : 0);
 
+    registerRingSubmission(commandStreamTask);
+    registerRingSubmission(dsh);
+    registerRingSubmission(ioh);
+    registerRingSubmission(ssh);
+
     CompletionStamp completionStamp = {
         taskCount,
         this->taskLevel,
@@ -456,6 +467,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
     if (this->dispatchMode == DispatchMode::ImmediateDispatch) {
         return;
     }
+    TRACE_SCOPE(Flush, "flushBatchedSubmissions");
     typedef typename GfxFamily::MI_BATCH_BUFFER_START MI_BATCH_BUFFER_START;
     typedef typename GfxFamily::PIPE_CONTROL PIPE_CONTROL;
     Device *device = this->getMemoryManager()->device;
@@ -535,6 +547,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             resourcePackage.clear();
         }
         this->totalMemoryUsed = 0;
+        this->batchedCommandBuffersCount = 0;
     }
 }
 
@@ -37,6 +37,8 @@ namespace CSRequirements {
 
 constexpr auto minCommandQueueCommandStreamSize = 2 * MemoryConstants::cacheLineSize;
 constexpr auto csOverfetchSize = MemoryConstants::pageSize;
+//command stream reused as a ring has to hold a number of enqueues to avoid stalling on each wrap
+constexpr auto minCommandQueueRingSize = 16 * MemoryConstants::pageSize;
 } // namespace CSRequirements
 
 namespace TimeoutControls {
@@ -29,6 +29,7 @@
 #include <atomic>
 
 namespace OCLRT {
+class RingBufferTracker;
 
 class LinearStream {
   public:
@@ -45,6 +46,14 @@ class LinearStream {
     void replaceBuffer(void *buffer, size_t bufferSize);
     GraphicsAllocation *getGraphicsAllocation() const;
     void replaceGraphicsAllocation(GraphicsAllocation *gfxAllocation);
+    RingBufferTracker *getRingTracker() const { return ringTracker; }
+    void setRingTracker(RingBufferTracker *tracker) { ringTracker = tracker; }
+
+    // Single producer emission: space is checked once here and getSpace advances
+    // a plain cursor until commitReservedSpace publishes it.
+    void reserveSpace(size_t size);
+    void commitReservedSpace();
+    bool isSpaceReserved() const { return spaceReserved; }
 
     template <typename Cmd>
     Cmd *getSpaceForCmd() {
@@ -57,6 +66,10 @@ class LinearStream {
     size_t maxAvailableSpace;
     void *buffer;
     GraphicsAllocation *graphicsAllocation;
+    RingBufferTracker *ringTracker = nullptr;
+    bool spaceReserved = false;
+    size_t reservedUsed = 0;
+    size_t reservedEnd = 0;
 };
 
 inline void *LinearStream::getCpuBase() const {
@@ -64,6 +77,13 @@ inline void *LinearStream::getCpuBase() const {
 }
 
 inline void *LinearStream::getSpace(size_t size) {
+    if (spaceReserved) {
+        DEBUG_BREAK_IF(reservedUsed + size > reservedEnd);
+        UNRECOVERABLE_IF(reservedUsed + size > maxAvailableSpace);
+        auto memory = ptrOffset(buffer, reservedUsed);
+        reservedUsed += size;
+        return memory;
+    }
     UNRECOVERABLE_IF(sizeUsed + size > maxAvailableSpace);
     auto memory = ptrOffset(buffer, sizeUsed);
     sizeUsed += size;
@@ -75,12 +95,27 @@ inline size_t LinearStream::getMaxAvailableSpace() const {
 }
 
 inline size_t LinearStream::getAvailableSpace() const {
-    DEBUG_BREAK_IF(sizeUsed > maxAvailableSpace);
-    return maxAvailableSpace - sizeUsed;
+    auto used = getUsed();
+    DEBUG_BREAK_IF(used > maxAvailableSpace);
+    return maxAvailableSpace - used;
 }
 
 inline size_t LinearStream::getUsed() const {
-    return sizeUsed;
+    return spaceReserved ? reservedUsed : sizeUsed.load();
+}
+
+inline void LinearStream::reserveSpace(size_t size) {
+    DEBUG_BREAK_IF(spaceReserved);
+    reservedUsed = sizeUsed;
+    UNRECOVERABLE_IF(reservedUsed + size > maxAvailableSpace);
+    reservedEnd = reservedUsed + size;
+    spaceReserved = true;
+}
+
+inline void LinearStream::commitReservedSpace() {
+    DEBUG_BREAK_IF(!spaceReserved);
+    spaceReserved = false;
+    sizeUsed = reservedUsed;
 }
 
 inline void LinearStream::overrideMaxSize(size_t newMaxSize) {
@@ -88,6 +123,7 @@ inline void LinearStream::overrideMaxSize(size_t newMaxSize) {
 }
 
 inline void LinearStream::replaceBuffer(void *buffer, size_t bufferSize) {
+    DEBUG_BREAK_IF(spaceReserved);
     this->buffer = buffer;
     maxAvailableSpace = bufferSize;
     sizeUsed = 0;
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/ring_buffer_tracker.h"
+
+namespace OCLRT {
+
+void RingBufferTracker::registerSubmission(size_t usedOffset, uint32_t taskCount) {
+    if (usedOffset <= registeredOffset) {
+        return;
+    }
+    submissions.push_back({registeredOffset, usedOffset, taskCount});
+    registeredOffset = usedOffset;
+}
+
+void RingBufferTracker::retire(uint32_t completedTaskCount) {
+    while (!submissions.empty() && submissions.front().taskCount <= completedTaskCount) {
+        submissions.pop_front();
+        if (previousLapSubmissions > 0) {
+            previousLapSubmissions--;
+        }
+    }
+}
+
+uint32_t RingBufferTracker::getTaskCountToReuse(size_t offset, size_t size) const {
+    uint32_t taskCountToWait = 0;
+    for (size_t i = 0; i < previousLapSubmissions; i++) {
+        auto &submission = submissions[i];
+        if (submission.start < offset + size && submission.end > offset) {
+            taskCountToWait = submission.taskCount;
+        }
+    }
+    return taskCountToWait;
+}
+
+uint32_t RingBufferTracker::getTaskCountToWrap(size_t size) const {
+    uint32_t taskCountToWait = 0;
+    for (size_t i = 0; i < submissions.size(); i++) {
+        auto &submission = submissions[i];
+        // whatever is left from the previous lap has to retire before the current one becomes previous
+        if (i < previousLapSubmissions || submission.start < size) {
+            taskCountToWait = submission.taskCount;
+        }
+    }
+    return taskCountToWait;
+}
+
+void RingBufferTracker::wrap() {
+    previousLapSubmissions = submissions.size();
+    registeredOffset = 0;
+    wrapCount++;
+}
+
+void RingBufferTracker::reset() {
+    submissions.clear();
+    previousLapSubmissions = 0;
+    registeredOffset = 0;
+}
+} // namespace OCLRT
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace OCLRT {
+
+// Tracks which parts of a command stream or heap reused as a ring are still referenced by submitted tasks.
+// Regions are registered in submission order, so the first entries are always the oldest.
+class RingBufferTracker {
+  public:
+    void registerSubmission(size_t usedOffset, uint32_t taskCount);
+    void retire(uint32_t completedTaskCount);
+    uint32_t getTaskCountToReuse(size_t offset, size_t size) const;
+    uint32_t getTaskCountToWrap(size_t size) const;
+    void wrap();
+    void reset();
+
+    bool hasUnregisteredData(size_t usedOffset) const { return usedOffset > registeredOffset; }
+    void recordStall() { stallCount++; }
+
+    uint32_t peekWrapCount() const { return wrapCount; }
+    uint32_t peekStallCount() const { return stallCount; }
+    size_t peekSubmissionsCount() const { return submissions.size(); }
+
+  protected:
+    struct Submission {
+        size_t start;
+        size_t end;
+        uint32_t taskCount;
+    };
+
+    std::deque<Submission> submissions;
+    size_t previousLapSubmissions = 0;
+    size_t registeredOffset = 0;
+    uint32_t wrapCount = 0;
+    uint32_t stallCount = 0;
+};
+} // namespace OCLRT
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/submission_worker.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/os_interface/os_thread.h"
+#include <algorithm>
+
+namespace OCLRT {
+const std::chrono::microseconds SubmissionWorker::gpuIdlePollInterval(50);
+
+SubmissionWorker::SubmissionWorker(CommandStreamReceiver &commandStreamReceiver, DispatchMode dispatchMode)
+    : commandStreamReceiver(commandStreamReceiver), dispatchMode(dispatchMode) {
+    int32_t depth = DebugManager.flags.AdaptiveDispatchQueueDepth.get();
+    int32_t delay = DebugManager.flags.AdaptiveDispatchMaxDelayMicroseconds.get();
+    if (dispatchMode == DispatchMode::BatchedDispatchWithCounter) {
+        depth = DebugManager.flags.BatchedDispatchCounterLimit.get();
+        delay = DebugManager.flags.BatchedDispatchDeadlineMicroseconds.get();
+    }
+    queueDepth = static_cast<uint32_t>(std::max(depth, 1));
+    maxSubmissionDelay = std::chrono::microseconds(std::max(delay, 0));
+}
+
+SubmissionWorker::~SubmissionWorker() {
+    closeThread();
+}
+
+bool SubmissionWorker::isSubmissionRequired() const {
+    if (dispatchMode == DispatchMode::AdaptiveDispatch && commandStreamReceiver.isGpuIdle()) {
+        //GPU would starve waiting for more work
+        return true;
+    }
+    return commandStreamReceiver.peekBatchedCommandBuffersCount() >= queueDepth;
+}
+
+void SubmissionWorker::notifyWorkRecorded() {
+    std::unique_lock<std::mutex> lock(workerMtx);
+    //Create on first use
+    openThread();
+
+    workPending = true;
+    workerCond.notify_one();
+}
+
+bool SubmissionWorker::isSubmissionWindowOpen(std::chrono::high_resolution_clock::time_point waitStart) {
+    if (isSubmissionRequired()) {
+        return true;
+    }
+    return std::chrono::high_resolution_clock::now() - waitStart >= maxSubmissionDelay;
+}
+
+void SubmissionWorker::waitForSubmissionWindow() {
+    auto waitStart = std::chrono::high_resolution_clock::now();
+    auto deadline = waitStart + maxSubmissionDelay;
+    std::unique_lock<std::mutex> lock(workerMtx, std::defer_lock);
+    while (allowProcess && !isSubmissionWindowOpen(waitStart)) {
+        auto wakeUp = deadline;
+        if (dispatchMode == DispatchMode::AdaptiveDispatch) {
+            //GPU idleness can only be polled, recorded work and shutdown wake the worker earlier
+            wakeUp = std::min(wakeUp, std::chrono::high_resolution_clock::now() + gpuIdlePollInterval);
+        }
+        lock.lock();
+        if (allowProcess) {
+            workerCond.wait_until(lock, wakeUp);
+        }
+        lock.unlock();
+    }
+}
+
+void *SubmissionWorker::workerProcess(void *arg) {
+    auto self = reinterpret_cast<SubmissionWorker *>(arg);
+    std::unique_lock<std::mutex> lock(self->workerMtx, std::defer_lock);
+
+    while (true) {
+        lock.lock();
+        if (!self->workPending && self->allowProcess) {
+            self->workerCond.wait(lock);
+        }
+        self->workPending = false;
+        lock.unlock();
+
+        if (!self->allowProcess) {
+            break;
+        }
+        if (self->commandStreamReceiver.peekBatchedCommandBuffersCount() == 0) {
+            continue;
+        }
+
+        self->waitForSubmissionWindow();
+        if (!self->allowProcess) {
+            // pending command buffers are flushed by the owner during shutdown
+            break;
+        }
+        self->commandStreamReceiver.flushBatchedSubmissions();
+    }
+    return nullptr;
+}
+
+void SubmissionWorker::closeThread() {
+    std::unique_lock<std::mutex> lock(workerMtx);
+    if (allowProcess) {
+        allowProcess = false;
+        workerCond.notify_one();
+        lock.unlock();
+        thread.get()->join();
+        thread.reset(nullptr);
+    }
+}
+
+void SubmissionWorker::openThread() {
+    if (!thread.get()) {
+        DEBUG_BREAK_IF(allowProcess);
+        allowProcess = true;
+        thread = Thread::create(workerProcess, reinterpret_cast<void *>(this));
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+class Thread;
+enum class DispatchMode;
+
+// Submits command buffers batched by CSR without explicit flush.
+// AdaptiveDispatch: work recorded while GPU is busy is flushed as one submission
+// once GPU becomes idle, queue depth is reached or max delay expires.
+// BatchedDispatchWithCounter: work is flushed when counter limit is reached or deadline expires.
+class SubmissionWorker {
+  public:
+    SubmissionWorker(CommandStreamReceiver &commandStreamReceiver, DispatchMode dispatchMode);
+    virtual ~SubmissionWorker();
+
+    bool isSubmissionRequired() const;
+    void notifyWorkRecorded();
+    void closeThread();
+
+    uint32_t peekQueueDepth() const { return queueDepth; }
+    std::chrono::microseconds peekMaxSubmissionDelay() const { return maxSubmissionDelay; }
+
+    static const std::chrono::microseconds gpuIdlePollInterval;
+
+  protected:
+    static void *workerProcess(void *arg);
+    void waitForSubmissionWindow();
+    MOCKABLE_VIRTUAL bool isSubmissionWindowOpen(std::chrono::high_resolution_clock::time_point waitStart);
+    MOCKABLE_VIRTUAL void openThread();
+
+    CommandStreamReceiver &commandStreamReceiver;
+    DispatchMode dispatchMode;
+    uint32_t queueDepth;
+    std::chrono::microseconds maxSubmissionDelay;
+
+    std::unique_ptr<Thread> thread;
+    std::mutex workerMtx;
+    std::condition_variable workerCond;
+    std::atomic<bool> allowProcess{false};
+    bool workPending = false;
+};
+} // namespace OCLRT
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/tag_waiter.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/os_interface/os_thread.h"
+#include <algorithm>
+#include <immintrin.h>
+#include <thread>
+
+namespace OCLRT {
+TagWaiter::TagWaiter(CommandStreamReceiver &commandStreamReceiver)
+    : commandStreamReceiver(commandStreamReceiver) {
+    int32_t spin = DebugManager.flags.WaitSpinMicroseconds.get();
+    spinTime = std::chrono::microseconds(spin < 0 ? -1 : spin);
+    pollInterval = std::chrono::microseconds(std::max(DebugManager.flags.WaitWatcherPollMicroseconds.get(), 1));
+}
+
+TagWaiter::~TagWaiter() {
+    closeThread();
+}
+
+bool TagWaiter::isTagReached(uint32_t taskCountToWait) const {
+    return *commandStreamReceiver.getTagAddress() >= taskCountToWait;
+}
+
+bool TagWaiter::waitForTag(uint32_t taskCountToWait, bool enableTimeout, int64_t timeoutMicroseconds) {
+    if (isTagReached(taskCountToWait)) {
+        return true;
+    }
+    if (timeoutMicroseconds < 0) {
+        return false;
+    }
+
+    auto waitStart = Clock::now();
+    auto timeoutDeadline = waitStart + std::chrono::microseconds(timeoutMicroseconds);
+    if (spinTime.count() < 0) {
+        //spin for the whole wait, matches legacy polling
+        return spin(taskCountToWait, enableTimeout, timeoutDeadline);
+    }
+
+    auto spinDeadline = waitStart + spinTime;
+    if (enableTimeout && timeoutDeadline <= spinDeadline) {
+        return spin(taskCountToWait, true, timeoutDeadline);
+    }
+    if (spin(taskCountToWait, true, spinDeadline)) {
+        return true;
+    }
+    return park(taskCountToWait, enableTimeout, timeoutDeadline);
+}
+
+bool TagWaiter::spin(uint32_t taskCountToWait, bool useDeadline, Clock::time_point deadline) {
+    uint32_t pauseCount = 1;
+    uint32_t pausesSinceClockCheck = 0;
+    while (!isTagReached(taskCountToWait)) {
+        for (uint32_t i = 0; i < pauseCount; i++) {
+            _mm_pause();
+        }
+        pausesSinceClockCheck += pauseCount;
+        pauseCount = std::min(pauseCount * 2, maxPauseCount);
+
+        if (useDeadline && pausesSinceClockCheck >= pausesPerClockCheck) {
+            pausesSinceClockCheck = 0;
+            if (Clock::now() > deadline) {
+                return isTagReached(taskCountToWait);
+            }
+        }
+    }
+    return true;
+}
+
+bool TagWaiter::park(uint32_t taskCountToWait, bool useDeadline, Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(waiterMtx);
+    //Create on first use
+    openThread();
+
+    parkedWaiters++;
+    watcherCond.notify_one();
+    while (!isTagReached(taskCountToWait)) {
+        if (!useDeadline) {
+            waiterCond.wait(lock);
+        } else if (waiterCond.wait_until(lock, deadline) == std::cv_status::timeout) {
+            break;
+        }
+    }
+    parkedWaiters--;
+    return isTagReached(taskCountToWait);
+}
+
+void *TagWaiter::watcherProcess(void *arg) {
+    auto self = reinterpret_cast<TagWaiter *>(arg);
+    std::unique_lock<std::mutex> lock(self->waiterMtx);
+
+    while (self->allowProcess) {
+        if (self->parkedWaiters == 0) {
+            self->watcherCond.wait(lock);
+            continue;
+        }
+
+        uint32_t currentTag = *self->commandStreamReceiver.getTagAddress();
+        if (currentTag != self->notifiedTag) {
+            //waiters check their own task count, wake all of them
+            self->notifiedTag = currentTag;
+            self->waiterCond.notify_all();
+        }
+
+        lock.unlock();
+        std::this_thread::sleep_for(self->pollInterval);
+        lock.lock();
+    }
+    return nullptr;
+}
+
+void TagWaiter::closeThread() {
+    std::unique_lock<std::mutex> lock(waiterMtx);
+    if (allowProcess) {
+        DEBUG_BREAK_IF(parkedWaiters != 0);
+        allowProcess = false;
+        watcherCond.notify_one();
+        lock.unlock();
+        thread.get()->join();
+        thread.reset(nullptr);
+    }
+}
+
+void TagWaiter::openThread() {
+    if (!thread.get()) {
+        DEBUG_BREAK_IF(allowProcess);
+        allowProcess = true;
+        thread = Thread::create(watcherProcess, reinterpret_cast<void *>(this));
+    }
+}
+} // namespace OCLRT
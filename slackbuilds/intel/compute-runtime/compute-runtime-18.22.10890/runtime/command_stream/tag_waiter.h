@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+class Thread;
+
+// Waits for CSR tag to reach requested task count.
+// Short waits spin with exponential pause backoff, long waits park the calling thread
+// on a condition variable. Single watcher thread per CSR polls the tag while any waiter
+// is parked and wakes all of them whenever the tag changes.
+class TagWaiter {
+  public:
+    TagWaiter(CommandStreamReceiver &commandStreamReceiver);
+    virtual ~TagWaiter();
+
+    bool waitForTag(uint32_t taskCountToWait, bool enableTimeout, int64_t timeoutMicroseconds);
+    void closeThread();
+
+    bool isTagReached(uint32_t taskCountToWait) const;
+    uint32_t peekParkedWaiters() const { return parkedWaiters; }
+    int64_t peekSpinMicroseconds() const { return spinTime.count(); }
+    int64_t peekPollMicroseconds() const { return pollInterval.count(); }
+
+    static const uint32_t maxPauseCount = 64;
+    static const uint32_t pausesPerClockCheck = 256;
+
+  protected:
+    using Clock = std::chrono::high_resolution_clock;
+
+    static void *watcherProcess(void *arg);
+    MOCKABLE_VIRTUAL bool spin(uint32_t taskCountToWait, bool useDeadline, Clock::time_point deadline);
+    MOCKABLE_VIRTUAL bool park(uint32_t taskCountToWait, bool useDeadline, Clock::time_point deadline);
+    MOCKABLE_VIRTUAL void openThread();
+
+    CommandStreamReceiver &commandStreamReceiver;
+    std::chrono::microseconds spinTime;
+    std::chrono::microseconds pollInterval;
+
+    std::unique_ptr<Thread> thread;
+    std::mutex waiterMtx;
+    std::condition_variable waiterCond;
+    std::condition_variable watcherCond;
+    std::atomic<bool> allowProcess{false};
+    std::atomic<uint32_t> parkedWaiters{0};
+    uint32_t notifiedTag = 0;
+};
+} // namespace OCLRT
@@ -346,10 +346,10 @@ bool TbxCommandStreamReceiverHw<GfxFamily>::writeMemory(GraphicsAllocation &gfxA
     if (size == 0)
         return false;
 
-    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+    auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
         AUB::reserveAddressGGTTAndWriteMmeory(stream, static_cast<uintptr_t>(gpuAddress), cpuAddress, physAddress, size, offset, getPPGTTAdditionalBits(&gfxAllocation));
     };
-    ppgtt.pageWalk(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
+    ppgtt.pageWalkRanges(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
 
     return true;
 }
@@ -373,12 +373,12 @@ void TbxCommandStreamReceiverHw<GfxFamily>::makeCoherent(GraphicsAllocation &gfx
     auto length = gfxAllocation.getUnderlyingBufferSize();
 
     if (length) {
-        PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
             DEBUG_BREAK_IF(offset > length);
             stream.readMemory(physAddress, ptrOffset(cpuAddress, offset), size);
         };
 
-        ppgtt.pageWalk(static_cast<uintptr_t>(gpuAddress), length, 0, walker);
+        ppgtt.pageWalkRanges(static_cast<uintptr_t>(gpuAddress), length, 0, walker);
     }
 }
 
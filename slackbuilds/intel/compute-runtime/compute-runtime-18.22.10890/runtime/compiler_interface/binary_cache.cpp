@@ -27,17 +27,47 @@
 #include <runtime/helpers/file_io.h>
 #include <runtime/helpers/hash.h>
 #include <runtime/helpers/hw_info.h>
+#include <runtime/os_interface/debug_settings_manager.h>
 #include <runtime/os_interface/os_inc_base.h>
 #include <runtime/program/program.h>
+#include <runtime/utilities/directory.h>
+#include <runtime/utilities/mapped_file.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <thread>
+#include <tuple>
 
 namespace OCLRT {
-std::mutex BinaryCache::cacheAccessMtx;
+std::mutex BinaryCache::trimMtx;
+std::atomic<uint64_t> BinaryCache::cacheDirectorySize{0};
+std::atomic<uint32_t> BinaryCache::writesSinceDirectoryScan{BinaryCache::directoryRescanInterval};
+
+static const char *cacheFileExtension = ".cl_cache";
+static const char *tempFileExtension = ".tmp";
+
+static bool hasExtension(const std::string &filePath, const char *extension) {
+    auto extensionLength = strlen(extension);
+    return filePath.size() > extensionLength &&
+           filePath.compare(filePath.size() - extensionLength, extensionLength, extension) == 0;
+}
+
+static uint64_t getCurrentTime() {
+    return static_cast<uint64_t>(time(nullptr));
+}
+
+BinaryCache::BinaryCache() {
+    maxEntriesInMemory = static_cast<size_t>(std::max(0, DebugManager.flags.BinaryCacheMaxEntriesInMemory.get()));
+    maxCacheDirectorySize = static_cast<uint64_t>(std::max(0, DebugManager.flags.BinaryCacheMaxSizeMB.get())) * 1024 * 1024;
+}
 
 const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
                                                  const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
@@ -66,43 +96,81 @@ const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, con
     return stream.str();
 }
 
+std::string BinaryCache::getCacheFilePath(const std::string &kernelFileHash) {
+    std::string hashFilePath = CL_CACHE_LOCATION;
+    hashFilePath.append(Os::fileSeparator);
+    hashFilePath.append(kernelFileHash + cacheFileExtension);
+    return hashFilePath;
+}
+
+std::string BinaryCache::getTempFilePath(const std::string &kernelFileHash) {
+    // unique across threads and processes writing the same entry
+    static std::atomic<uint32_t> tempFileCounter{0};
+    std::stringstream stream;
+    stream << CL_CACHE_LOCATION << Os::fileSeparator << kernelFileHash
+           << "." << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id())
+           << "." << std::chrono::steady_clock::now().time_since_epoch().count()
+           << "." << tempFileCounter++ << tempFileExtension;
+    return stream.str();
+}
+
 bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
     if (pBinary == nullptr || binarySize == 0) {
         return false;
     }
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
-
-    std::lock_guard<std::mutex> lock(cacheAccessMtx);
+    // readers only ever see complete files, rename replaces the entry atomically
+    std::string tempFilePath = getTempFilePath(kernelFileHash);
     if (writeDataToFile(
-            hashFilePath.c_str(),
+            tempFilePath.c_str(),
             pBinary,
             binarySize) == 0) {
         return false;
     }
 
+    std::string hashFilePath = getCacheFilePath(kernelFileHash);
+    if (std::rename(tempFilePath.c_str(), hashFilePath.c_str()) != 0) {
+        std::remove(tempFilePath.c_str());
+        // entry could have been published by other process in the meantime
+        if (!fileExistsHasSize(hashFilePath)) {
+            return false;
+        }
+    }
+
+    if (maxEntriesInMemory > 0) {
+        storeInMemory(kernelFileHash, MappedFile::open(hashFilePath));
+    }
+
+    trimCacheDirectory(binarySize);
     return true;
 }
 
 bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
-    void *pBinary = nullptr;
-    size_t binarySize = 0;
+    if (loadFromMemory(kernelFileHash, program)) {
+        return true;
+    }
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    std::string hashFilePath = getCacheFilePath(kernelFileHash);
 
-    {
-        std::lock_guard<std::mutex> lock(cacheAccessMtx);
-        binarySize = loadDataFromFile(hashFilePath.c_str(), pBinary);
+    std::shared_ptr<const MappedFile> mappedBinary = MappedFile::open(hashFilePath);
+    if (mappedBinary) {
+        // access time drives eviction, do not rely on the filesystem updating it
+        Directory::setFileTimes(hashFilePath, 0, getCurrentTime());
+        program.storeGenBinary(mappedBinary);
+        storeInMemory(kernelFileHash, std::move(mappedBinary));
+        return true;
     }
 
+    void *pBinary = nullptr;
+    size_t binarySize = 0;
+
+    binarySize = loadDataFromFile(hashFilePath.c_str(), pBinary);
+
     if ((pBinary == nullptr) || (binarySize == 0)) {
         deleteDataReadFromFile(pBinary);
         return false;
     }
+    Directory::setFileTimes(hashFilePath, 0, getCurrentTime());
     program.storeGenBinary(pBinary, binarySize);
 
     deleteDataReadFromFile(pBinary);
@@ -110,4 +178,99 @@ bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &pr
     return true;
 }
 
+bool BinaryCache::loadFromMemory(const std::string &kernelFileHash, Program &program) {
+    std::lock_guard<std::mutex> lock(lruMtx);
+    auto it = lruIndex.find(kernelFileHash);
+    if (it == lruIndex.end()) {
+        return false;
+    }
+
+    lruList.splice(lruList.begin(), lruList, it->second);
+    program.storeGenBinary(it->second->binary);
+    return true;
+}
+
+void BinaryCache::storeInMemory(const std::string &kernelFileHash, std::shared_ptr<const MappedFile> binary) {
+    if (maxEntriesInMemory == 0 || !binary) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(lruMtx);
+    auto it = lruIndex.find(kernelFileHash);
+    if (it != lruIndex.end()) {
+        it->second->binary = std::move(binary);
+        lruList.splice(lruList.begin(), lruList, it->second);
+        return;
+    }
+
+    lruList.push_front(CachedBinary{kernelFileHash, std::move(binary)});
+    lruIndex[kernelFileHash] = lruList.begin();
+
+    while (lruList.size() > maxEntriesInMemory) {
+        lruIndex.erase(lruList.back().kernelFileHash);
+        lruList.pop_back();
+    }
+}
+
+void BinaryCache::trimCacheDirectory(uint64_t writtenSize) {
+    if (maxCacheDirectorySize == 0) {
+        return;
+    }
+
+    // directory is scanned only when the limit is reached and periodically to catch up with other processes
+    auto sizeEstimate = cacheDirectorySize.fetch_add(writtenSize) + writtenSize;
+    auto writes = writesSinceDirectoryScan.fetch_add(1) + 1;
+    if (sizeEstimate <= maxCacheDirectorySize && writes < directoryRescanInterval) {
+        return;
+    }
+
+    // one trim at a time is enough, others will see its result
+    std::unique_lock<std::mutex> lock(trimMtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    writesSinceDirectoryScan = 0;
+
+    std::string cacheLocation = CL_CACHE_LOCATION;
+    std::vector<std::tuple<uint64_t, std::string, size_t>> cacheFiles;
+    uint64_t currentDirectorySize = 0;
+    uint64_t currentTime = getCurrentTime();
+
+    for (auto &filePath : Directory::getFiles(cacheLocation)) {
+        size_t fileSize = 0;
+        uint64_t lastModified = 0;
+        uint64_t lastAccessed = 0;
+        if (!Directory::getFileInfo(filePath, fileSize, lastModified, lastAccessed)) {
+            continue;
+        }
+
+        if (hasExtension(filePath, tempFileExtension)) {
+            // left behind by writers that never got to rename
+            if (lastModified + staleTempFileAgeInSeconds < currentTime) {
+                std::remove(filePath.c_str());
+            }
+            continue;
+        }
+
+        if (hasExtension(filePath, cacheFileExtension)) {
+            cacheFiles.emplace_back(lastAccessed, filePath, fileSize);
+            currentDirectorySize += fileSize;
+        }
+    }
+
+    if (currentDirectorySize > maxCacheDirectorySize) {
+        std::sort(cacheFiles.begin(), cacheFiles.end());
+        for (auto &cacheFile : cacheFiles) {
+            if (currentDirectorySize <= maxCacheDirectorySize) {
+                break;
+            }
+            // failure means other process already evicted it
+            std::remove(std::get<1>(cacheFile).c_str());
+            currentDirectorySize -= std::get<2>(cacheFile);
+        }
+    }
+
+    cacheDirectorySize = currentDirectorySize;
+}
+
 } // namesapce OCLRT
@@ -21,19 +21,26 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <list>
+#include <memory>
 #include <string>
 #include <mutex>
+#include <unordered_map>
 
 #include "runtime/utilities/arrayref.h"
 
 namespace OCLRT {
 
 struct HardwareInfo;
+class MappedFile;
 class Program;
 class BinaryCache {
   public:
+    BinaryCache();
+
     const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
                                         ArrayRef<const char> options, ArrayRef<const char> internalOptions);
 
@@ -43,7 +50,33 @@ class BinaryCache {
     virtual bool loadCachedBinary(const std::string kernelFileHash, Program &program);
 
   protected:
-    static std::mutex cacheAccessMtx;
+    struct CachedBinary {
+        std::string kernelFileHash;
+        std::shared_ptr<const MappedFile> binary;
+    };
+    typedef std::list<CachedBinary> CachedBinaryList;
+
+    static std::string getCacheFilePath(const std::string &kernelFileHash);
+    static std::string getTempFilePath(const std::string &kernelFileHash);
+
+    bool loadFromMemory(const std::string &kernelFileHash, Program &program);
+    void storeInMemory(const std::string &kernelFileHash, std::shared_ptr<const MappedFile> binary);
+    void trimCacheDirectory(uint64_t writtenSize);
+
+    // in-process tier of mapped cache files, most recently used entries at front
+    CachedBinaryList lruList;
+    std::unordered_map<std::string, CachedBinaryList::iterator> lruIndex;
+    std::mutex lruMtx;
+    size_t maxEntriesInMemory = 0;
+
+    // on-disk tier, 0 - unlimited
+    uint64_t maxCacheDirectorySize = 0;
+    static std::mutex trimMtx;
+    // running size of on-disk tier, refreshed by directory scans
+    static std::atomic<uint64_t> cacheDirectorySize;
+    static std::atomic<uint32_t> writesSinceDirectoryScan;
+    static const uint32_t directoryRescanInterval = 64;
+    static const uint64_t staleTempFileAgeInSeconds = 60 * 60;
 };
 
 } // namesapce OCLRT
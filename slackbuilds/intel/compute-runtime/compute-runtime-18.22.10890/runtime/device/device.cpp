@@ -20,9 +20,12 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "config.h"
 #include "hw_cmds.h"
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/built_ins/sip.h"
+#include "runtime/command_queue/kernel_stats_aggregator.h"
+#include "runtime/command_queue/lws_autotuner.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/command_stream/device_command_stream.h"
 #include "runtime/command_stream/preemption.h"
@@ -34,6 +37,7 @@
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/options.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/os_inc_base.h"
 #include "runtime/os_interface/os_interface.h"
 #include "runtime/os_interface/os_time.h"
 #include "runtime/source_level_debugger/source_level_debugger.h"
@@ -103,6 +107,7 @@ Device::~Device() {
         performanceCounters->shutdown();
     }
     if (commandStreamReceiver) {
+        commandStreamReceiver->closeSubmissionWorker();
         commandStreamReceiver->flushBatchedSubmissions();
         delete commandStreamReceiver;
         commandStreamReceiver = nullptr;
@@ -112,6 +117,10 @@ Device::~Device() {
         sourceLevelDebugger->notifyDeviceDestruction();
     }
 
+    // returns pending timestamp tags to the memory manager
+    lwsAutotuner.reset();
+    kernelStatsAggregator.reset();
+
     if (memoryManager) {
         if (preemptionAllocation) {
             memoryManager->freeGraphicsMemory(preemptionAllocation);
@@ -188,6 +197,21 @@ bool Device::createDeviceImpl(const HardwareInfo *pHwInfo,
     outDevice.memoryManager->setForce32BitAllocations(pDevice->getDeviceInfo().force32BitAddressess);
     outDevice.memoryManager->device = pDevice;
 
+    if (DebugManager.flags.EnableLwsAutotuning.get()) {
+        std::string profileFilePath = CL_CACHE_LOCATION;
+        profileFilePath.append(Os::fileSeparator);
+        profileFilePath.append("lws_profiles.txt");
+        pDevice->lwsAutotuner.reset(new LwsAutotuner(outDevice.memoryManager, pHwInfo->pPlatform->usDeviceID, profileFilePath));
+    }
+
+    if (DebugManager.flags.EnableKernelStatsAggregation.get()) {
+        pDevice->kernelStatsAggregator.reset(new KernelStatsAggregator(outDevice.memoryManager, pDevice->osTime.get(), pDevice->deviceInfo.profilingTimerResolution,
+                                                                       pHwInfo->pPlatform->usDeviceID, DebugManager.flags.KernelStatsFile.get()));
+        if (DebugManager.flags.KernelStatsDumpSignal.get() > 0) {
+            KernelStatsAggregator::installDumpSignal(DebugManager.flags.KernelStatsDumpSignal.get());
+        }
+    }
+
     if (pDevice->preemptionMode == PreemptionMode::MidThread || pDevice->isSourceLevelDebuggerActive()) {
         size_t requiredSize = pHwInfo->capabilityTable.requiredPreemptionSurfaceSize;
         size_t alignment = 256 * MemoryConstants::kiloByte;
@@ -36,6 +36,8 @@ class GraphicsAllocation;
 class MemoryManager;
 class OSTime;
 class DriverInfo;
+class KernelStatsAggregator;
+class LwsAutotuner;
 struct HardwareInfo;
 class SourceLevelDebugger;
 
@@ -137,6 +139,8 @@ class Device : public BaseObject<_cl_device_id> {
     bool getEnabled64kbPages();
     bool isSourceLevelDebuggerActive() const;
     SourceLevelDebugger *getSourceLevelDebugger() { return sourceLevelDebugger.get(); }
+    LwsAutotuner *getLwsAutotuner() const { return lwsAutotuner.get(); }
+    KernelStatsAggregator *getKernelStatsAggregator() const { return kernelStatsAggregator.get(); }
 
   protected:
     Device() = delete;
@@ -172,6 +176,8 @@ class Device : public BaseObject<_cl_device_id> {
     PreemptionMode preemptionMode;
     EngineType engineType;
     std::unique_ptr<SourceLevelDebugger> sourceLevelDebugger;
+    std::unique_ptr<LwsAutotuner> lwsAutotuner;
+    std::unique_ptr<KernelStatsAggregator> kernelStatsAggregator;
 };
 
 template <cl_device_info Param>
@@ -21,8 +21,11 @@
  */
 
 #include "runtime/event/async_events_handler.h"
+#include "runtime/command_queue/command_queue.h"
 #include "runtime/event/event.h"
 #include "runtime/os_interface/os_thread.h"
+#include <algorithm>
+#include <functional>
 #include <iterator>
 
 namespace OCLRT {
@@ -31,6 +34,7 @@ AsyncEventsHandler::AsyncEventsHandler() {
     registerList.reserve(64);
     list.reserve(64);
     pendingList.reserve(64);
+    completedList.reserve(64);
 }
 
 AsyncEventsHandler::~AsyncEventsHandler() {
@@ -48,24 +52,85 @@ void AsyncEventsHandler::registerEvent(Event *event) {
 }
 
 Event *AsyncEventsHandler::processList() {
-    uint32_t lowestTaskCount = Event::eventNotReady;
-    Event *sleepCandidate = nullptr;
     pendingList.clear();
 
+    for (auto &heap : completionHeaps) {
+        popCompletedEvents(heap);
+    }
+    for (auto event : completedList) {
+        event->updateExecutionStatus();
+        trackEvent(event);
+    }
+    completedList.clear();
+
     for (auto event : list) {
         event->updateExecutionStatus();
-        if (event->peekHasCallbacks() || (event->isExternallySynchronized() && (event->peekExecutionStatus() > CL_COMPLETE))) {
-            pendingList.push_back(event);
-            if (event->peekTaskCount() < lowestTaskCount) {
-                sleepCandidate = event;
-                lowestTaskCount = event->peekTaskCount();
-            }
-        } else {
-            event->decRefInternal();
-        }
+        trackEvent(event);
     }
 
     list.swap(pendingList);
+    completionHeaps.erase(std::remove_if(completionHeaps.begin(), completionHeaps.end(),
+                                         [](const CompletionHeap &heap) { return heap.entries.empty(); }),
+                          completionHeaps.end());
+    return getSleepCandidate();
+}
+
+void AsyncEventsHandler::trackEvent(Event *event) {
+    if (!event->peekHasCallbacks() && !(event->isExternallySynchronized() && (event->peekExecutionStatus() > CL_COMPLETE))) {
+        event->decRefInternal();
+        return;
+    }
+
+    auto cmdQueue = event->getCommandQueue();
+    bool completionOrdered = cmdQueue != nullptr &&
+                             !event->isExternallySynchronized() &&
+                             event->peekTaskCount() != Event::eventNotReady &&
+                             event->peekExecutionStatus() == CL_SUBMITTED;
+    if (completionOrdered) {
+        pushToCompletionHeap(event);
+    } else {
+        pendingList.push_back(event);
+    }
+}
+
+void AsyncEventsHandler::pushToCompletionHeap(Event *event) {
+    auto tagAddress = event->getCommandQueue()->getHwTagAddress();
+    auto heap = std::find_if(completionHeaps.begin(), completionHeaps.end(),
+                             [=](const CompletionHeap &candidate) { return candidate.tagAddress == tagAddress; });
+    if (heap == completionHeaps.end()) {
+        completionHeaps.push_back({tagAddress, {}});
+        heap = completionHeaps.end() - 1;
+    }
+    //task count is stored with the entry, heap order can't change when event is updated
+    heap->entries.push_back(HeapEntry(event->peekTaskCount(), event));
+    std::push_heap(heap->entries.begin(), heap->entries.end(), std::greater<HeapEntry>());
+}
+
+void AsyncEventsHandler::popCompletedEvents(CompletionHeap &heap) {
+    uint32_t tag = *heap.tagAddress;
+    while (!heap.entries.empty() && heap.entries.front().first <= tag) {
+        completedList.push_back(heap.entries.front().second);
+        std::pop_heap(heap.entries.begin(), heap.entries.end(), std::greater<HeapEntry>());
+        heap.entries.pop_back();
+    }
+}
+
+Event *AsyncEventsHandler::getSleepCandidate() const {
+    uint32_t lowestTaskCount = Event::eventNotReady;
+    Event *sleepCandidate = nullptr;
+
+    for (auto &heap : completionHeaps) {
+        if (heap.entries.front().first < lowestTaskCount) {
+            sleepCandidate = heap.entries.front().second;
+            lowestTaskCount = heap.entries.front().first;
+        }
+    }
+    for (auto event : list) {
+        if (event->peekTaskCount() < lowestTaskCount) {
+            sleepCandidate = event;
+            lowestTaskCount = event->peekTaskCount();
+        }
+    }
     return sleepCandidate;
 }
 
@@ -82,7 +147,7 @@ void *AsyncEventsHandler::asyncProcess(void *arg) {
             self->releaseEvents();
             break;
         }
-        if (self->list.empty()) {
+        if (self->list.empty() && self->completionHeaps.empty()) {
             self->asyncCond.wait(lock);
         }
         lock.unlock();
@@ -125,6 +190,12 @@ void AsyncEventsHandler::releaseEvents() {
         event->decRefInternal();
     }
     list.clear();
+    for (auto &heap : completionHeaps) {
+        for (auto &entry : heap.entries) {
+            entry.second->decRefInternal();
+        }
+    }
+    completionHeaps.clear();
     UNRECOVERABLE_IF(!registerList.empty()) // transferred before release
 }
 } // namespace OCLRT
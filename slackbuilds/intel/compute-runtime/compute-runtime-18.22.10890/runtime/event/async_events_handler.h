@@ -26,11 +26,17 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <cstdint>
+#include <utility>
 
 namespace OCLRT {
 class Event;
 class Thread;
 
+// Submitted events are kept in per-CSR min-heaps ordered by task count,
+// only the prefix already passed by CSR tag is updated on each wake-up.
+// Events without known completion task count (blocked, not submitted yet,
+// externally synchronized) are kept in list and rescanned on every pass.
 class AsyncEventsHandler {
   public:
     AsyncEventsHandler();
@@ -39,14 +45,26 @@ class AsyncEventsHandler {
     void closeThread();
 
   protected:
+    using HeapEntry = std::pair<uint32_t, Event *>;
+    struct CompletionHeap {
+        volatile uint32_t *tagAddress;
+        std::vector<HeapEntry> entries;
+    };
+
     Event *processList();
     static void *asyncProcess(void *arg);
     void releaseEvents();
+    void trackEvent(Event *event);
+    void pushToCompletionHeap(Event *event);
+    void popCompletedEvents(CompletionHeap &heap);
+    Event *getSleepCandidate() const;
     MOCKABLE_VIRTUAL void openThread();
     MOCKABLE_VIRTUAL void transferRegisterList();
     std::vector<Event *> registerList;
     std::vector<Event *> list;
     std::vector<Event *> pendingList;
+    std::vector<Event *> completedList;
+    std::vector<CompletionHeap> completionHeaps;
 
     std::unique_ptr<Thread> thread;
     std::mutex asyncMtx;
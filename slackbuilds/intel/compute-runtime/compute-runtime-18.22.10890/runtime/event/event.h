@@ -105,8 +105,8 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
 
     uint32_t getCompletionStamp(void) const;
     void updateCompletionStamp(uint32_t taskCount, uint32_t tasklevel, FlushStamp flushStamp);
-    cl_ulong getDelta(cl_ulong startTime,
-                      cl_ulong endTime);
+    static cl_ulong getDelta(cl_ulong startTime,
+                             cl_ulong endTime);
     bool calcProfilingData();
     void setCPUProfilingPath(bool isCPUPath) { this->profilingCpuPath = isCPUPath; }
     bool isCPUProfilingPath() {
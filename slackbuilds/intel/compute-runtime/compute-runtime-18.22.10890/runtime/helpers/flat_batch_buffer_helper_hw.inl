@@ -56,7 +56,7 @@ void *FlatBatchBufferHelperHw<GfxFamily>::flattenBatchBuffer(BatchBuffer &batchB
             sizeBatchBuffer = flatBatchBufferSize;
             patchInfoCollection.insert(std::end(patchInfoCollection), std::begin(indirectPatchInfo), std::end(indirectPatchInfo));
         }
-    } else if (dispatchMode == DispatchMode::BatchedDispatch) {
+    } else if (dispatchMode != DispatchMode::DeviceDefault) {
         CommandChunk firstChunk;
         for (auto &chunk : commandChunkList) {
             bool found = false;
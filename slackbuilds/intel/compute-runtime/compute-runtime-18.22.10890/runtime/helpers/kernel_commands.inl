@@ -28,6 +28,7 @@
 #include "runtime/helpers/dispatch_info.h"
 #include "runtime/helpers/address_patch.h"
 #include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/stream_copy.h"
 #include "runtime/helpers/string.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/kernel/kernel.h"
@@ -232,7 +233,7 @@ size_t KernelCommandsHelper<GfxFamily>::sendCrossThreadData(
     auto offsetCrossThreadData = indirectHeap.getUsed();
     auto sizeCrossThreadData = kernel.getCrossThreadDataSize();
     char *pDest = static_cast<char *>(indirectHeap.getSpace(sizeCrossThreadData));
-    memcpy_s(pDest, sizeCrossThreadData, kernel.getCrossThreadData(), sizeCrossThreadData);
+    streamCopy(pDest, kernel.getCrossThreadData(), sizeCrossThreadData);
 
     if (DebugManager.flags.AddPatchInfoCommentsForAUBDump.get()) {
         FlatBatchBufferHelper::fixCrossThreadDataInfo(kernel.getPatchInfoDataList(), offsetCrossThreadData, indirectHeap.getGraphicsAllocation()->getGpuAddress());
@@ -268,12 +269,12 @@ size_t KernelCommandsHelper<GfxFamily>::pushBindingTableAndSurfaceStates(Indirec
     if (dstSurfaceState == dstHeap.getCpuBase()) {
         // nothing to patch, we're at the start of heap (which is assumed to be the surface state base address)
         // we need to simply copy the ssh (including BTIs from compiler)
-        memcpy_s(dstSurfaceState, sshSize, srcSurfaceState, sshSize);
+        streamCopy(dstSurfaceState, srcSurfaceState, sshSize);
         return offsetOfBindingTable;
     }
 
     // We can copy-over the surface states, but BTIs will need to be patched
-    memcpy_s(dstSurfaceState, sshSize, srcSurfaceState, offsetOfBindingTable);
+    streamCopy(dstSurfaceState, srcSurfaceState, offsetOfBindingTable);
 
     uint32_t surfaceStatesOffset = static_cast<uint32_t>(ptrDiff(dstSurfaceState, dstHeap.getCpuBase()));
 
@@ -381,20 +382,33 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
     uint64_t offsetInterfaceDescriptor = offsetInterfaceDescriptorTable + interfaceDescriptorIndex * sizeof(INTERFACE_DESCRIPTOR_DATA);
 
     DEBUG_BREAK_IF(patchInfo.executionEnvironment == nullptr);
-    KernelCommandsHelper<GfxFamily>::sendInterfaceDescriptorData(
-        dsh,
-        offsetInterfaceDescriptor,
-        kernelStartOffset,
-        kernel.getCrossThreadDataSize(),
-        sizePerThreadData,
-        dstBindingTablePointer,
-        samplerStateOffset,
-        samplerCount,
-        threadsPerThreadGroup,
-        kernel.slmTotalSize,
-        !!patchInfo.executionEnvironment->HasBarriers,
-        preemptionMode,
-        inlineInterfaceDescriptor);
+    auto &interfaceDescriptorTemplate = kernel.getDispatchTemplates().interfaceDescriptor;
+    InterfaceDescriptorTemplateKey interfaceDescriptorKey = {kernelStartOffset, {localWorkSize[0], localWorkSize[1], localWorkSize[2]}, simd, kernel.slmTotalSize, samplerCount, static_cast<uint64_t>(preemptionMode)};
+    bool useDispatchTemplates = !DebugManager.flags.DisableDispatchTemplates.get();
+    auto pInterfaceDescriptor = static_cast<INTERFACE_DESCRIPTOR_DATA *>(ptrOffset(dsh.getCpuBase(), static_cast<size_t>(offsetInterfaceDescriptor)));
+    if (useDispatchTemplates && interfaceDescriptorTemplate.lookup(interfaceDescriptorKey, *pInterfaceDescriptor)) {
+        // only heap offsets differ between enqueues with the same key
+        pInterfaceDescriptor->setBindingTablePointer(static_cast<uint32_t>(dstBindingTablePointer));
+        pInterfaceDescriptor->setSamplerStatePointer(static_cast<uint32_t>(samplerStateOffset));
+    } else {
+        KernelCommandsHelper<GfxFamily>::sendInterfaceDescriptorData(
+            dsh,
+            offsetInterfaceDescriptor,
+            kernelStartOffset,
+            kernel.getCrossThreadDataSize(),
+            sizePerThreadData,
+            dstBindingTablePointer,
+            samplerStateOffset,
+            samplerCount,
+            threadsPerThreadGroup,
+            kernel.slmTotalSize,
+            !!patchInfo.executionEnvironment->HasBarriers,
+            preemptionMode,
+            inlineInterfaceDescriptor);
+        if (useDispatchTemplates) {
+            interfaceDescriptorTemplate.record(interfaceDescriptorKey, *pInterfaceDescriptor);
+        }
+    }
 
     if (DebugManager.flags.AddPatchInfoCommentsForAUBDump.get()) {
         PatchInfoData patchInfoData(kernelStartOffset, 0, PatchInfoAllocationType::InstructionHeap, dsh.getGraphicsAllocation()->getGpuAddress(), offsetInterfaceDescriptor, PatchInfoAllocationType::DynamicStateHeap);
@@ -23,9 +23,12 @@
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/per_thread_data.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 namespace OCLRT {
 
+LocalIdsCache PerThreadDataHelper::localIdsCache;
+
 size_t PerThreadDataHelper::sendPerThreadData(
     LinearStream &indirectHeap,
     uint32_t simd,
@@ -39,7 +42,11 @@ size_t PerThreadDataHelper::sendPerThreadData(
 
         // Generate local IDs
         DEBUG_BREAK_IF(numChannels != 3);
-        generateLocalIDs(pDest, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+        if (DebugManager.flags.DisableLocalIdsCache.get()) {
+            generateLocalIDs(pDest, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+        } else {
+            localIdsCache.generateLocalIds(pDest, sizePerThreadDataTotal, simd, localWorkSizes);
+        }
     }
     return offsetPerThreadData;
 }
@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <cstddef>
 #include "runtime/command_queue/local_id_gen.h"
+#include "runtime/command_queue/local_ids_cache.h"
 #include "patch_shared.h"
 
 namespace OCLRT {
@@ -56,5 +57,7 @@ struct PerThreadDataHelper {
     }
 
     static uint32_t getThreadPayloadSize(const iOpenCL::SPatchThreadPayload &threadPayload, uint32_t simd);
+
+    static LocalIdsCache localIdsCache;
 };
 }
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+
+namespace OCLRT {
+// Copy of data that only GPU reads afterwards (heap contents), non-temporal stores keep it out of CPU caches
+struct StreamCopyHelper {
+    static void (*copy)(void *dst, const void *src, size_t size);
+
+    static StreamCopyHelper initializer;
+
+  private:
+    StreamCopyHelper();
+};
+
+void streamCopySse4(void *dst, const void *src, size_t size);
+void streamCopyAvx2(void *dst, const void *src, size_t size);
+
+// Below this size store fence costs more than non-temporal stores save, see stream_copy_perf_tests
+const size_t streamCopyMinSize = 2048;
+
+inline void streamCopy(void *dst, const void *src, size_t size) {
+    if (size < streamCopyMinSize) {
+        memcpy(dst, src, size);
+        return;
+    }
+    StreamCopyHelper::copy(dst, src, size);
+}
+} // namespace OCLRT
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if __AVX2__
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/stream_copy.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+namespace OCLRT {
+void streamCopyAvx2(void *dst, const void *src, size_t size) {
+    auto pDst = static_cast<uint8_t *>(dst);
+    auto pSrc = static_cast<const uint8_t *>(src);
+
+    auto head = std::min(size, ptrDiff(alignUp(pDst, sizeof(__m256i)), pDst));
+    memcpy(pDst, pSrc, head);
+    pDst += head;
+    pSrc += head;
+    size -= head;
+
+    while (size >= sizeof(__m256i)) {
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(pDst), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc)));
+        pDst += sizeof(__m256i);
+        pSrc += sizeof(__m256i);
+        size -= sizeof(__m256i);
+    }
+    _mm_sfence();
+
+    memcpy(pDst, pSrc, size);
+}
+} // namespace OCLRT
+#endif
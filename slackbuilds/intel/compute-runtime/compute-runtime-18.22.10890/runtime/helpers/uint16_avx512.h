@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/helpers/debug_helpers.h"
+#include <cstdint>
+#include <immintrin.h>
+
+namespace OCLRT {
+
+#if __AVX512F__ && __AVX512BW__
+struct uint16x32_t {
+    enum { numChannels = 32 };
+
+    __m512i value;
+
+    uint16x32_t() {
+        value = _mm512_setzero_si512();
+    }
+
+    uint16x32_t(__m512i value) : value(value) {
+    }
+
+    uint16x32_t(uint16_t a) {
+        value = _mm512_set1_epi16(a); //AVX512BW
+    }
+
+    explicit uint16x32_t(const void *ptr) {
+        load(ptr);
+    }
+
+    inline uint16_t get(unsigned int element) {
+        DEBUG_BREAK_IF(element >= numChannels);
+        return reinterpret_cast<uint16_t *>(&value)[element];
+    }
+
+    static inline uint16x32_t zero() {
+        return uint16x32_t(static_cast<uint16_t>(0u));
+    }
+
+    static inline uint16x32_t one() {
+        return uint16x32_t(static_cast<uint16_t>(1u));
+    }
+
+    static inline uint16x32_t mask() {
+        return uint16x32_t(static_cast<uint16_t>(0xffffu));
+    }
+
+    // Per-thread data in the indirect heap is only GRF (32 bytes) aligned,
+    // so loads and stores never assume 64 byte alignment
+    inline void load(const void *ptr) {
+        loadUnaligned(ptr);
+    }
+
+    inline void loadUnaligned(const void *ptr) {
+        value = _mm512_loadu_si512(ptr); //AVX512F
+    }
+
+    inline void store(void *ptr) {
+        storeUnaligned(ptr);
+    }
+
+    inline void storeUnaligned(void *ptr) {
+        _mm512_storeu_si512(ptr, value); //AVX512F
+    }
+
+    inline operator bool() const {
+        return _mm512_test_epi16_mask(value, value) ? true : false; //AVX512BW
+    }
+
+    inline uint16x32_t &operator-=(const uint16x32_t &a) {
+        value = _mm512_sub_epi16(value, a.value); //AVX512BW
+        return *this;
+    }
+
+    inline uint16x32_t &operator+=(const uint16x32_t &a) {
+        value = _mm512_add_epi16(value, a.value); //AVX512BW
+        return *this;
+    }
+
+    inline friend uint16x32_t operator>=(const uint16x32_t &a, const uint16x32_t &b) {
+        // Local IDs and work group sizes stay far below 0x8000, so a >= b
+        // exactly when b - a - 1 is negative; the arithmetic shift spreads the
+        // sign bit over the lane without going through a mask register
+        uint16x32_t result;
+        result.value =
+            _mm512_srai_epi16(_mm512_sub_epi16(_mm512_sub_epi16(b.value, a.value), one().value), 15); //AVX512BW
+        return result;
+    }
+
+    inline friend uint16x32_t operator&&(const uint16x32_t &a, const uint16x32_t &b) {
+        uint16x32_t result;
+        result.value = _mm512_and_si512(a.value, b.value); //AVX512F
+        return result;
+    }
+
+    // NOTE: uint16x32_t::blend behaves like mask ? a : b
+    inline friend uint16x32_t blend(const uint16x32_t &a, const uint16x32_t &b, const uint16x32_t &mask) {
+        uint16x32_t result;
+
+        // Bitwise select (mask & a) | (~mask & b), avoids round trips through mask registers
+        result.value =
+            _mm512_ternarylogic_epi32(mask.value, a.value, b.value, 0xca); //AVX512F
+        return result;
+    }
+};
+#endif // __AVX512F__ && __AVX512BW__
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace OCLRT {
+// Keys are compared bytewise, keep all fields 64-bit so no padding sneaks in
+struct WalkerTemplateKey {
+    uint64_t localWorkSize[3];
+    uint64_t startWorkGroups[3];
+    uint64_t numWorkGroups[3];
+    uint64_t simd;
+};
+
+struct InterfaceDescriptorTemplateKey {
+    uint64_t kernelStartOffset;
+    uint64_t localWorkSize[3];
+    uint64_t simd;
+    uint64_t slmTotalSize;
+    uint64_t samplerCount;
+    uint64_t preemptionMode;
+};
+
+// Last command generated for a given key, replayed verbatim with per-enqueue offsets patched by the caller.
+// Kernel can be dispatched from many queues at once, so storage is guarded by a seqlock:
+// sequence is odd while record is writing and lookup overlapping a record misses instead of returning torn command.
+template <typename KeyType>
+class CommandTemplate {
+  public:
+    static const size_t maxCommandSize = 128;
+
+    template <typename CmdType>
+    bool lookup(const KeyType &key, CmdType &cmd) const {
+        auto sequenceBefore = sequence.load(std::memory_order_acquire);
+        if (sequenceBefore == 0 || (sequenceBefore & 1) != 0) {
+            return false;
+        }
+
+        uint64_t recordedKey[keyWords];
+        uint64_t recordedCommand[commandWords];
+        loadWords(this->key, recordedKey, keyWords);
+        loadWords(this->command, recordedCommand, getWordCount(sizeof(CmdType)));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != sequenceBefore ||
+            memcmp(&key, recordedKey, sizeof(KeyType)) != 0) {
+            return false;
+        }
+        memcpy(&cmd, recordedCommand, sizeof(CmdType));
+        return true;
+    }
+
+    template <typename CmdType>
+    void record(const KeyType &key, const CmdType &cmd) {
+        static_assert(sizeof(CmdType) <= maxCommandSize, "command does not fit into template storage");
+        auto sequenceBefore = sequence.load(std::memory_order_relaxed);
+        // concurrent recorder stores equivalent command, no need to wait for it
+        if ((sequenceBefore & 1) != 0 ||
+            !sequence.compare_exchange_strong(sequenceBefore, sequenceBefore + 1, std::memory_order_relaxed)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t commandToRecord[commandWords] = {};
+        memcpy(commandToRecord, &cmd, sizeof(CmdType));
+        storeWords(reinterpret_cast<const uint64_t *>(&key), this->key, keyWords);
+        storeWords(commandToRecord, this->command, getWordCount(sizeof(CmdType)));
+
+        sequence.store(sequenceBefore + 2, std::memory_order_release);
+    }
+
+    void invalidate() {
+        auto sequenceBefore = sequence.load(std::memory_order_relaxed);
+        if ((sequenceBefore & 1) == 0) {
+            sequence.compare_exchange_strong(sequenceBefore, 0, std::memory_order_relaxed);
+        }
+    }
+    bool peekRecorded() const {
+        auto currentSequence = sequence.load(std::memory_order_acquire);
+        return currentSequence != 0 && (currentSequence & 1) == 0;
+    }
+
+  protected:
+    static_assert(sizeof(KeyType) % sizeof(uint64_t) == 0, "key has to be made of 64-bit fields");
+    static const size_t keyWords = sizeof(KeyType) / sizeof(uint64_t);
+    static const size_t commandWords = maxCommandSize / sizeof(uint64_t);
+
+    static size_t getWordCount(size_t size) {
+        return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    }
+    static void loadWords(const std::atomic<uint64_t> *src, uint64_t *dst, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = src[i].load(std::memory_order_relaxed);
+        }
+    }
+    static void storeWords(const uint64_t *src, std::atomic<uint64_t> *dst, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            dst[i].store(src[i], std::memory_order_relaxed);
+        }
+    }
+
+    // 0 - nothing recorded, odd - record in progress
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> key[keyWords] = {};
+    std::atomic<uint64_t> command[commandWords] = {};
+};
+
+struct DispatchTemplates {
+    CommandTemplate<WalkerTemplateKey> walker;
+    CommandTemplate<InterfaceDescriptorTemplateKey> interfaceDescriptor;
+};
+} // namespace OCLRT
@@ -27,6 +27,7 @@
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/preamble.h"
 #include "runtime/helpers/address_patch.h"
+#include "runtime/kernel/dispatch_template.h"
 #include "runtime/program/program.h"
 #include "runtime/program/kernel_info.h"
 #include "runtime/os_interface/debug_settings_manager.h"
@@ -377,6 +378,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     }
 
     std::vector<PatchInfoData> &getPatchInfoDataList() { return patchInfoDataList; };
+    DispatchTemplates &getDispatchTemplates() { return dispatchTemplates; }
 
   protected:
     struct ObjectCounts {
@@ -490,5 +492,6 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     std::vector<PatchInfoData> patchInfoDataList;
     std::unique_ptr<ImageTransformer> imageTransformer;
+    DispatchTemplates dispatchTemplates;
 };
 } // namespace OCLRT
@@ -128,6 +128,13 @@ class GraphicsAllocation : public IDNode<GraphicsAllocation> {
 
     int residencyTaskCount = ObjectNotResident;
 
+    // contents last written to the AUB file, unchanged allocations are not dumped again
+    struct AubDumpState {
+        uint32_t fileId = 0;
+        size_t size = 0;
+        uint64_t contentHash = 0;
+    } aubDumpState;
+
     void setEvictable(bool evictable) { this->evictable = evictable; }
     bool peekEvictable() const { return evictable; }
 
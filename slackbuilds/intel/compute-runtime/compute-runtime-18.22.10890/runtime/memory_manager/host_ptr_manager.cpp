@@ -26,34 +26,19 @@
 
 using namespace OCLRT;
 
-std::map<const void *, FragmentStorage>::iterator OCLRT::HostPtrManager::findElement(const void *ptr) {
-    auto nextElement = partialAllocations.lower_bound(ptr);
-    auto element = nextElement;
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
-        if (storedFragment.fragmentCpuPointer <= ptr) {
-            return element;
-        } else if (element != partialAllocations.begin()) {
-            element--;
-            auto &storedFragment = element->second;
-            auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-            if (storedFragment.fragmentSize == 0) {
-                storedEndAddress++;
-            }
-            if ((uintptr_t)ptr < (uintptr_t)storedEndAddress) {
-                return element;
-            }
-        }
-    } else if (element != partialAllocations.begin()) {
-        element--;
-        auto &storedFragment = element->second;
-        auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-        if (storedFragment.fragmentSize == 0) {
-            storedEndAddress++;
-        }
-        if ((uintptr_t)ptr < (uintptr_t)storedEndAddress) {
-            return element;
-        }
+uintptr_t OCLRT::HostPtrManager::getFragmentEndAddress(const FragmentStorage &fragment) {
+    auto endAddress = reinterpret_cast<uintptr_t>(fragment.fragmentCpuPointer) + fragment.fragmentSize;
+    //zero sized fragments still occupy their start address
+    if (fragment.fragmentSize == 0) {
+        endAddress++;
+    }
+    return endAddress;
+}
+
+HostPtrFragmentsContainer::iterator OCLRT::HostPtrManager::findElement(const void *ptr) {
+    auto element = partialAllocations.upper_bound(reinterpret_cast<uintptr_t>(ptr));
+    if (element != partialAllocations.end() && element->second.fragmentCpuPointer <= ptr) {
+        return element;
     }
     return partialAllocations.end();
 }
@@ -149,13 +134,13 @@ OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(Allocat
 }
 
 void OCLRT::HostPtrManager::storeFragment(FragmentStorage &fragment) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
+    std::lock_guard<ReaderWriterLock> lock(allocationsLock);
     auto element = findElement(fragment.fragmentCpuPointer);
     if (element != partialAllocations.end()) {
         element->second.refCount++;
     } else {
         fragment.refCount++;
-        partialAllocations.insert(std::pair<const void *, FragmentStorage>(fragment.fragmentCpuPointer, fragment));
+        partialAllocations.insert(std::pair<uintptr_t, FragmentStorage>(getFragmentEndAddress(fragment), fragment));
     }
 }
 
@@ -177,7 +162,7 @@ void OCLRT::HostPtrManager::releaseHandleStorage(OsHandleStorage &fragments) {
 }
 
 bool OCLRT::HostPtrManager::releaseHostPtr(const void *ptr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
+    std::lock_guard<ReaderWriterLock> lock(allocationsLock);
     bool fragmentReadyToBeReleased = false;
 
     auto element = findElement(ptr);
@@ -194,7 +179,7 @@ bool OCLRT::HostPtrManager::releaseHostPtr(const void *ptr) {
 }
 
 FragmentStorage *OCLRT::HostPtrManager::getFragment(const void *inputPtr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
+    SharedLockGuard<ReaderWriterLock> lock(allocationsLock);
     auto element = findElement(inputPtr);
     if (element != partialAllocations.end()) {
         return &element->second;
@@ -202,62 +187,40 @@ FragmentStorage *OCLRT::HostPtrManager::getFragment(const void *inputPtr) {
     return nullptr;
 }
 
+size_t OCLRT::HostPtrManager::getFragmentCount() {
+    SharedLockGuard<ReaderWriterLock> lock(allocationsLock);
+    return partialAllocations.size();
+}
+
 //for given inputs see if any allocation overlaps
 FragmentStorage *OCLRT::HostPtrManager::getFragmentAndCheckForOverlaps(const void *inPtr, size_t size, OverlapStatus &overlappingStatus) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    void *inputPtr = const_cast<void *>(inPtr);
-    auto nextElement = partialAllocations.lower_bound(inputPtr);
-    auto element = nextElement;
+    SharedLockGuard<ReaderWriterLock> lock(allocationsLock);
+    auto inputStartAddress = reinterpret_cast<uintptr_t>(inPtr);
+    auto inputEndAddress = inputStartAddress + size;
     overlappingStatus = OverlapStatus::FRAGMENT_NOT_OVERLAPING_WITH_ANY_OTHER;
 
-    if (element != partialAllocations.begin()) {
-        element--;
+    //only the first fragment ending after inputPtr may overlap with the input range
+    auto element = partialAllocations.upper_bound(inputStartAddress);
+    if (element == partialAllocations.end()) {
+        return nullptr;
     }
 
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
-        if (storedFragment.fragmentCpuPointer == inputPtr && storedFragment.fragmentSize == size) {
-            overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
-            return &element->second;
-        }
-
-        auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-        auto inputEndAddress = (uintptr_t)inputPtr + size;
+    auto &storedFragment = element->second;
+    auto storedStartAddress = reinterpret_cast<uintptr_t>(storedFragment.fragmentCpuPointer);
+    auto storedEndAddress = storedStartAddress + storedFragment.fragmentSize;
 
-        if (inputPtr >= storedFragment.fragmentCpuPointer && (uintptr_t)inputPtr < (uintptr_t)storedEndAddress) {
-            if (inputEndAddress <= storedEndAddress) {
-                overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
-                return &element->second;
-            } else {
-                overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
-                return nullptr;
-            }
+    if (storedStartAddress <= inputStartAddress) {
+        if (storedStartAddress == inputStartAddress && storedFragment.fragmentSize == size) {
+            overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
+            return &storedFragment;
         }
-        //next fragment doesn't have to be after the inputPtr
-        if (nextElement != partialAllocations.end()) {
-            auto &storedNextElement = nextElement->second;
-            auto storedNextEndAddress = (uintptr_t)storedNextElement.fragmentCpuPointer + storedNextElement.fragmentSize;
-            auto storedNextStartAddress = (uintptr_t)storedNextElement.fragmentCpuPointer;
-            //check if this allocation is after the inputPtr
-            if ((uintptr_t)inputPtr < storedNextStartAddress) {
-                if (inputEndAddress > storedNextStartAddress) {
-                    overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
-                    return nullptr;
-                }
-            } else if (inputEndAddress > storedNextEndAddress) {
-                overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
-                return nullptr;
-            } else {
-                DEBUG_BREAK_IF((uintptr_t)inputPtr != storedNextStartAddress);
-                if (inputEndAddress < storedNextEndAddress) {
-                    overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
-                } else {
-                    DEBUG_BREAK_IF(inputEndAddress != storedNextEndAddress);
-                    overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
-                }
-                return &nextElement->second;
-            }
+        if (inputEndAddress <= storedEndAddress) {
+            overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
+            return &storedFragment;
         }
+        overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
+    } else if (inputEndAddress > storedStartAddress) {
+        overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
     }
     return nullptr;
 }
@@ -25,10 +25,13 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/host_ptr_defines.h"
+#include "runtime/utilities/reader_writer_lock.h"
 
 namespace OCLRT {
 
-typedef std::map<const void *, FragmentStorage> HostPtrFragmentsContainer;
+// Stored fragments never overlap, so keying them by end address turns every lookup into a single
+// upper_bound: the first fragment ending above an address is the only one that can contain or overlap it.
+typedef std::map<uintptr_t, FragmentStorage> HostPtrFragmentsContainer;
 
 class HostPtrManager {
   public:
@@ -41,13 +44,14 @@ class HostPtrManager {
     bool releaseHostPtr(const void *ptr);
 
     FragmentStorage *getFragment(const void *inputPtr);
-    size_t getFragmentCount() { return partialAllocations.size(); }
+    size_t getFragmentCount();
     FragmentStorage *getFragmentAndCheckForOverlaps(const void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
 
   private:
-    std::map<const void *, FragmentStorage>::iterator findElement(const void *ptr);
+    static uintptr_t getFragmentEndAddress(const FragmentStorage &fragment);
+    HostPtrFragmentsContainer::iterator findElement(const void *ptr);
 
     HostPtrFragmentsContainer partialAllocations;
-    std::mutex allocationsMutex;
+    ReaderWriterLock allocationsLock;
 };
 } // namespace OCLRT
@@ -29,6 +29,7 @@
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/options.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include "runtime/utilities/stackvec.h"
 #include "runtime/utilities/tag_allocator.h"
 #include "runtime/event/hw_timestamps.h"
@@ -58,24 +59,155 @@ std::unique_ptr<GraphicsAllocation> AllocationsList::detachAllocation(size_t req
 
 GraphicsAllocation *AllocationsList::detachAllocationImpl(GraphicsAllocation *, void *data) {
     ReusableAllocationRequirements *req = static_cast<ReusableAllocationRequirements *>(data);
+    auto currentTagValue = req->csrTagAddress ? *req->csrTagAddress : -1;
+    GraphicsAllocation *bestFit = nullptr;
     auto *curr = head;
     while (curr != nullptr) {
-        auto currentTagValue = req->csrTagAddress ? *req->csrTagAddress : -1;
+        auto currentSize = curr->getUnderlyingBufferSize();
         if ((req->internalAllocationRequired == curr->is32BitAllocation) &&
-            (curr->getUnderlyingBufferSize() >= req->requiredMinimalSize) &&
+            (currentSize >= req->requiredMinimalSize) &&
             ((currentTagValue > curr->taskCount) || (curr->taskCount == 0))) {
-            return removeOneImpl(curr, nullptr);
+            if (bestFit == nullptr || currentSize < bestFit->getUnderlyingBufferSize()) {
+                bestFit = curr;
+                if (currentSize == req->requiredMinimalSize) {
+                    break;
+                }
+            }
         }
         curr = curr->next;
     }
+    return bestFit ? removeOneImpl(bestFit, nullptr) : nullptr;
+}
+
+struct CompletedAllocationsRequirements {
+    size_t bytesToDetach;
+    size_t detachedBytes;
+    volatile uint32_t *csrTagAddress;
+};
+
+GraphicsAllocation *AllocationsList::detachCompletedAllocations(size_t bytesToDetach, volatile uint32_t *csrTagAddress, size_t &detachedBytes) {
+    CompletedAllocationsRequirements req;
+    req.bytesToDetach = bytesToDetach;
+    req.detachedBytes = 0;
+    req.csrTagAddress = csrTagAddress;
+    GraphicsAllocation *a = nullptr;
+    GraphicsAllocation *retAlloc = processLocked<AllocationsList, &AllocationsList::detachCompletedAllocationsImpl>(a, static_cast<void *>(&req));
+    detachedBytes = req.detachedBytes;
+    return retAlloc;
+}
+
+GraphicsAllocation *AllocationsList::detachCompletedAllocationsImpl(GraphicsAllocation *, void *data) {
+    CompletedAllocationsRequirements *req = static_cast<CompletedAllocationsRequirements *>(data);
+    auto currentTagValue = req->csrTagAddress ? *req->csrTagAddress : -1;
+    IDList<GraphicsAllocation, false, false> detached;
+    auto *curr = head;
+    while (curr != nullptr && req->detachedBytes < req->bytesToDetach) {
+        auto *next = curr->next;
+        if ((currentTagValue > curr->taskCount) || (curr->taskCount == 0)) {
+            req->detachedBytes += curr->getUnderlyingBufferSize();
+            detached.pushTailOne(*removeOneImpl(curr, nullptr));
+        }
+        curr = next;
+    }
+    return detached.detachNodes();
+}
+
+uint32_t ReusableAllocationsPool::getBucketIndex(size_t size) {
+    uint64_t pages = size / MemoryConstants::pageSize;
+    if (pages <= 1) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::min(Math::log2(pages), static_cast<uint64_t>(bucketsCount - 1)));
+}
+
+void ReusableAllocationsPool::updateBucketMask(uint32_t bucketIndex) {
+    // re-check after clearing, a concurrent push sets the bit only after its node is linked
+    nonEmptyBuckets.fetch_and(~(1u << bucketIndex));
+    if (!buckets[bucketIndex].peekIsEmpty()) {
+        nonEmptyBuckets.fetch_or(1u << bucketIndex);
+    }
+}
+
+void ReusableAllocationsPool::pushAllocation(GraphicsAllocation &allocation) {
+    auto bucketIndex = getBucketIndex(allocation.getUnderlyingBufferSize());
+    retainedSize += allocation.getUnderlyingBufferSize();
+    buckets[bucketIndex].pushTailOne(allocation);
+    nonEmptyBuckets.fetch_or(1u << bucketIndex);
+}
+
+std::unique_ptr<GraphicsAllocation> ReusableAllocationsPool::detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress, bool internalAllocationRequired) {
+    // first bucket with a match holds the best fit, all entries in higher buckets are larger
+    for (auto bucketIndex = getBucketIndex(requiredMinimalSize); bucketIndex < bucketsCount; bucketIndex++) {
+        if ((nonEmptyBuckets.load() & (1u << bucketIndex)) == 0) {
+            continue;
+        }
+        auto allocation = buckets[bucketIndex].detachAllocation(requiredMinimalSize, csrTagAddress, internalAllocationRequired);
+        if (allocation) {
+            retainedSize -= allocation->getUnderlyingBufferSize();
+            updateBucketMask(bucketIndex);
+            return allocation;
+        }
+    }
     return nullptr;
 }
+
+GraphicsAllocation *ReusableAllocationsPool::detachCompletedAllocations(size_t bytesToKeep, volatile uint32_t *csrTagAddress) {
+    IDList<GraphicsAllocation, false, false> detached;
+    // release largest allocations first, they give back the most memory per free
+    for (auto bucketIndex = bucketsCount; bucketIndex-- > 0 && retainedSize > bytesToKeep;) {
+        size_t detachedBytes = 0;
+        auto nodes = buckets[bucketIndex].detachCompletedAllocations(retainedSize - bytesToKeep, csrTagAddress, detachedBytes);
+        if (nodes) {
+            retainedSize -= detachedBytes;
+            updateBucketMask(bucketIndex);
+            detached.splice(*nodes);
+        }
+    }
+    return detached.detachNodes();
+}
+
+void ReusableAllocationsPool::freeAllocations(uint32_t waitTaskCount, MemoryManager &memoryManager) {
+    for (uint32_t bucketIndex = 0; bucketIndex < bucketsCount; bucketIndex++) {
+        GraphicsAllocation *curr = buckets[bucketIndex].detachNodes();
+
+        IDList<GraphicsAllocation, false, true> allocationsLeft;
+        while (curr != nullptr) {
+            auto *next = curr->next;
+            if (curr->taskCount <= waitTaskCount) {
+                retainedSize -= curr->getUnderlyingBufferSize();
+                memoryManager.freeGraphicsMemory(curr);
+            } else {
+                allocationsLeft.pushTailOne(*curr);
+            }
+            curr = next;
+        }
+
+        if (allocationsLeft.peekIsEmpty() == false) {
+            buckets[bucketIndex].splice(*allocationsLeft.detachNodes());
+        }
+        updateBucketMask(bucketIndex);
+    }
+}
+
+bool ReusableAllocationsPool::peekIsEmpty() {
+    for (auto &bucket : buckets) {
+        if (!bucket.peekIsEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReusableAllocationsPool::peekContains(GraphicsAllocation &allocation) {
+    return buckets[getBucketIndex(allocation.getUnderlyingBufferSize())].peekContains(allocation);
+}
+
 MemoryManager::MemoryManager(bool enable64kbpages) : allocator32Bit(nullptr), enable64kbpages(enable64kbpages) {
     residencyAllocations.reserve(20);
 };
 MemoryManager::~MemoryManager() {
     freeAllocationsList(-1, graphicsAllocations);
-    freeAllocationsList(-1, allocationsForReuse);
+    allocationsForReuse.freeAllocations(-1, *this);
 }
 
 void *MemoryManager::allocateSystemMemory(size_t size, size_t alignment) {
@@ -204,17 +336,40 @@ void MemoryManager::storeAllocation(std::unique_ptr<GraphicsAllocation> gfxAlloc
         }
     }
 
-    auto &allocationsList = (allocationType == TEMPORARY_ALLOCATION) ? graphicsAllocations : allocationsForReuse;
     gfxAllocation->taskCount = taskCount;
-    allocationsList.pushTailOne(*gfxAllocation.release());
+    if (allocationType == TEMPORARY_ALLOCATION) {
+        graphicsAllocations.pushTailOne(*gfxAllocation.release());
+        return;
+    }
+
+    allocationsForReuse.pushAllocation(*gfxAllocation.release());
+    auto maxReusableAllocationsSize = getMaxReusableAllocationsSize();
+    if (allocationsForReuse.peekRetainedSize() > maxReusableAllocationsSize) {
+        trimReusableAllocations(maxReusableAllocationsSize);
+    }
 }
 
 std::unique_ptr<GraphicsAllocation> MemoryManager::obtainReusableAllocation(size_t requiredSize, bool internalAllocation) {
-    std::lock_guard<decltype(mtx)> lock(mtx);
     auto allocation = allocationsForReuse.detachAllocation(requiredSize, csr ? csr->getTagAddress() : nullptr, internalAllocation);
     return allocation;
 }
 
+void MemoryManager::trimReusableAllocations(size_t bytesToKeep) {
+    auto *curr = allocationsForReuse.detachCompletedAllocations(bytesToKeep, csr ? csr->getTagAddress() : nullptr);
+    while (curr != nullptr) {
+        auto *next = curr->next;
+        freeGraphicsMemory(curr);
+        curr = next;
+    }
+}
+
+size_t MemoryManager::getMaxReusableAllocationsSize() const {
+    if (DebugManager.flags.ReusableAllocationsMaxRetainedSizeMB.get() != -1) {
+        return static_cast<size_t>(DebugManager.flags.ReusableAllocationsMaxRetainedSizeMB.get()) * MemoryConstants::megaByte;
+    }
+    return ReusableAllocationsPool::defaultMaxRetainedSize;
+}
+
 void MemoryManager::setForce32BitAllocations(bool newValue) {
     if (newValue && !this->allocator32Bit) {
         this->allocator32Bit.reset(new Allocator32bit);
@@ -238,7 +393,11 @@ void MemoryManager::applyCommonCleanup() {
 
 bool MemoryManager::cleanAllocationList(uint32_t waitTaskCount, uint32_t allocationType) {
     std::lock_guard<decltype(mtx)> lock(mtx);
-    freeAllocationsList(waitTaskCount, (allocationType == TEMPORARY_ALLOCATION) ? graphicsAllocations : allocationsForReuse);
+    if (allocationType == TEMPORARY_ALLOCATION) {
+        freeAllocationsList(waitTaskCount, graphicsAllocations);
+    } else {
+        allocationsForReuse.freeAllocations(waitTaskCount, *this);
+    }
     return false;
 }
 
@@ -262,16 +421,16 @@ void MemoryManager::freeAllocationsList(uint32_t waitTaskCount, AllocationsList
 }
 
 TagAllocator<HwTimeStamps> *MemoryManager::getEventTsAllocator() {
-    if (profilingTimeStampAllocator.get() == nullptr) {
+    std::call_once(profilingTimeStampAllocatorCreated, [this]() {
         profilingTimeStampAllocator.reset(new TagAllocator<HwTimeStamps>(this, ProfilingTagCount, MemoryConstants::cacheLineSize));
-    }
+    });
     return profilingTimeStampAllocator.get();
 }
 
 TagAllocator<HwPerfCounter> *MemoryManager::getEventPerfCountAllocator() {
-    if (perfCounterAllocator.get() == nullptr) {
+    std::call_once(perfCounterAllocatorCreated, [this]() {
         perfCounterAllocator.reset(new TagAllocator<HwPerfCounter>(this, PerfCounterTagCount, MemoryConstants::cacheLineSize));
-    }
+    });
     return perfCounterAllocator.get();
 }
 
@@ -292,6 +451,7 @@ void MemoryManager::clearEvictionAllocations() {
 }
 
 void MemoryManager::freeGraphicsMemory(GraphicsAllocation *gfxAllocation) {
+    TRACE_SCOPE(Allocation, "freeGraphicsMemory");
     freeGraphicsMemoryImpl(gfxAllocation);
 }
 //if not in use destroy in place
@@ -27,6 +27,7 @@
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/helpers/aligned_memory.h"
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <mutex>
@@ -69,9 +70,39 @@ constexpr size_t paddingBufferSize = 2 * MemoryConstants::megaByte;
 class AllocationsList : public IDList<GraphicsAllocation, true, true> {
   public:
     std::unique_ptr<GraphicsAllocation> detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress, bool internalAllocationRequired);
+    GraphicsAllocation *detachCompletedAllocations(size_t bytesToDetach, volatile uint32_t *csrTagAddress, size_t &detachedBytes);
 
   private:
     GraphicsAllocation *detachAllocationImpl(GraphicsAllocation *, void *);
+    GraphicsAllocation *detachCompletedAllocationsImpl(GraphicsAllocation *, void *);
+};
+
+class MemoryManager;
+
+// Reusable allocations bucketed by power-of-two size classes (in pages), each bucket guarded by its own list lock
+class ReusableAllocationsPool {
+  public:
+    static const uint32_t bucketsCount = 20;
+    static const size_t defaultMaxRetainedSize = 256 * MemoryConstants::megaByte;
+
+    void pushAllocation(GraphicsAllocation &allocation);
+    std::unique_ptr<GraphicsAllocation> detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress, bool internalAllocationRequired);
+    GraphicsAllocation *detachCompletedAllocations(size_t bytesToKeep, volatile uint32_t *csrTagAddress);
+    void freeAllocations(uint32_t waitTaskCount, MemoryManager &memoryManager);
+
+    bool peekIsEmpty();
+    bool peekContains(GraphicsAllocation &allocation);
+    size_t peekRetainedSize() const { return retainedSize; }
+    AllocationsList &getBucket(uint32_t bucketIndex) { return buckets[bucketIndex]; }
+
+    static uint32_t getBucketIndex(size_t size);
+
+  protected:
+    void updateBucketMask(uint32_t bucketIndex);
+
+    AllocationsList buckets[bucketsCount];
+    std::atomic<size_t> retainedSize{0};
+    std::atomic<uint32_t> nonEmptyBuckets{0};
 };
 
 class Gmm;
@@ -162,12 +193,14 @@ class MemoryManager {
     TagAllocator<HwPerfCounter> *getEventPerfCountAllocator();
 
     std::unique_ptr<GraphicsAllocation> obtainReusableAllocation(size_t requiredSize, bool isInternalAllocationRequired);
+    void trimReusableAllocations(size_t bytesToKeep);
+    size_t getMaxReusableAllocationsSize() const;
 
     //intrusive list of allocation
     AllocationsList graphicsAllocations;
 
-    //intrusive list of allocation for re-use
-    AllocationsList allocationsForReuse;
+    //size-bucketed intrusive lists of allocation for re-use
+    ReusableAllocationsPool allocationsForReuse;
 
     CommandStreamReceiver *csr = nullptr;
     Device *device = nullptr;
@@ -239,6 +272,9 @@ class MemoryManager {
     std::recursive_mutex mtx;
     std::unique_ptr<TagAllocator<HwTimeStamps>> profilingTimeStampAllocator;
     std::unique_ptr<TagAllocator<HwPerfCounter>> perfCounterAllocator;
+    // queues recording without the device lock may be the first to request tags
+    std::once_flag profilingTimeStampAllocatorCreated;
+    std::once_flag perfCounterAllocatorCreated;
     bool force32bitAllocations = false;
     bool virtualPaddingAvailable = false;
     GraphicsAllocation *paddingAllocation = nullptr;
@@ -27,6 +27,7 @@
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/surface_formats.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include <cassert>
 
 namespace OCLRT {
@@ -39,6 +40,7 @@ struct OsHandle {
 };
 
 GraphicsAllocation *OsAgnosticMemoryManager::allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) {
+    TRACE_SCOPE(Allocation, "allocateGraphicsMemory");
 
     auto sizeAligned = alignUp(size, MemoryConstants::pageSize);
     MemoryAllocation *memoryAllocation = nullptr;
@@ -185,6 +187,7 @@ void OsAgnosticMemoryManager::cleanOsHandles(OsHandleStorage &handleStorage) {
     }
 }
 GraphicsAllocation *OsAgnosticMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &imgInfo, Gmm *gmm) {
+    TRACE_SCOPE(Allocation, "allocateGraphicsMemoryForImage");
     auto alloc = allocateGraphicsMemory(imgInfo.size, MemoryConstants::preferredAlignment);
     if (alloc) {
         alloc->gmm = gmm;
@@ -40,6 +40,25 @@ size_t PageTable<void, 0, 9>::getBits() {
     return 9;
 }
 
+void PTE::mapEntries(size_t indexStart, size_t indexEnd) {
+    size_t index = indexStart;
+    while (index <= indexEnd) {
+        if (entries[index] != nullptr) {
+            index++;
+            continue;
+        }
+        // consecutive unmapped entries get consecutive physical pages, so walks can merge them into one range
+        size_t runEnd = index;
+        while (runEnd < indexEnd && entries[runEnd + 1] == nullptr) {
+            runEnd++;
+        }
+        uint64_t page = nextPage.fetch_add(static_cast<uint32_t>(runEnd - index + 1));
+        for (; index <= runEnd; index++, page++) {
+            entries[index] = reinterpret_cast<void *>(page * pageSize | 0x1);
+        }
+    }
+}
+
 uintptr_t PTE::map(uintptr_t vm, size_t size) {
     const size_t shift = 12;
     const uint32_t mask = (1 << bits) - 1;
@@ -47,11 +66,9 @@ uintptr_t PTE::map(uintptr_t vm, size_t size) {
     size_t indexEnd = ((vm + size - 1) >> shift) & mask;
     uintptr_t res = -1;
 
+    mapEntries(indexStart, indexEnd);
+
     for (size_t index = indexStart; index <= indexEnd; index++) {
-        if (entries[index] == 0x0) {
-            uint64_t tmp = nextPage.fetch_add(1);
-            entries[index] = reinterpret_cast<void *>(tmp * pageSize | 0x1);
-        }
         res = std::min(reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu, res);
     }
     return (res & ~0x1) + (vm & (pageSize - 1));
@@ -90,11 +107,9 @@ void PTE::pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWal
     uint64_t res = -1;
     uintptr_t rem = vm & (pageSize - 1);
 
+    mapEntries(indexStart, indexEnd);
+
     for (size_t index = indexStart; index <= indexEnd; index++) {
-        if (entries[index] == 0x0) {
-            uint64_t tmp = nextPage.fetch_add(1);
-            entries[index] = reinterpret_cast<void *>(tmp * pageSize | 0x1);
-        }
         res = reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu;
 
         size_t lSize = std::min(pageSize - rem, size);
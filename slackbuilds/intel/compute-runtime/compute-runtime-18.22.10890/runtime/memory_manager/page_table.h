@@ -23,6 +23,7 @@
 #pragma once
 #include "runtime/helpers/basic_math.h"
 
+#include <algorithm>
 #include <functional>
 #include <atomic>
 #include <array>
@@ -43,7 +44,16 @@ class PageTable {
     virtual uintptr_t map(uintptr_t vm, size_t size);
     virtual void pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker);
 
+    // Like pageWalk, but reports maximal physically contiguous ranges instead of single pages.
+    // A range never crosses a 2MB boundary, so it is covered by a single page table.
+    template <typename RangeWalkerT>
+    void pageWalkRanges(uintptr_t vm, size_t size, size_t offset, RangeWalkerT &&rangeWalker);
+
+    template <typename WalkerT>
+    void walkPages(uintptr_t vm, size_t size, size_t offset, WalkerT &walker);
+
     static const size_t pageSize = 1 << 12;
+    static const size_t largePageSize = 1 << 21;
     static size_t getBits() {
         return T::getBits() + bits;
     }
@@ -52,16 +62,24 @@ class PageTable {
     std::array<T *, 1 << bits> entries;
 };
 
+template <>
+size_t PageTable<void, 0, 9>::getBits();
+
 class PTE : public PageTable<void, 0u> {
   public:
     uintptr_t map(uintptr_t vm, size_t size) override;
     void pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker) override;
 
+    template <typename WalkerT>
+    void walkPages(uintptr_t vm, size_t size, size_t offset, WalkerT &walker);
+
     static const uint32_t level = 0;
     static const uint32_t bits = 9;
     static const uint32_t initialPage;
 
   protected:
+    void mapEntries(size_t indexStart, size_t indexEnd);
+
     static std::atomic<uint32_t> nextPage;
 };
 class PDE : public PageTable<class PTE, 1> {
@@ -72,4 +90,6 @@ class PML4 : public PageTable<class PDP, 3> {
 };
 class PDPE : public PageTable<class PDE, 2, 2> {
 };
-}
+} // namespace OCLRT
+
+#include "runtime/memory_manager/page_table.inl"
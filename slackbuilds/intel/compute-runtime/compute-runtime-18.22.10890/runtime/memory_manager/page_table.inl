@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+namespace OCLRT {
+
+// Merges per-page callbacks into physically contiguous ranges.
+template <typename RangeWalkerT>
+class PageRangeCoalescer {
+  public:
+    PageRangeCoalescer(uintptr_t vm, size_t offset, size_t largePageSize, RangeWalkerT &rangeWalker)
+        : vmBase(vm - offset), largePageSize(largePageSize), rangeWalker(rangeWalker) {}
+
+    void operator()(uint64_t physAddress, size_t size, size_t offset) {
+        auto vm = vmBase + offset;
+        bool sameLargePage = (vm & (largePageSize - 1)) != 0;
+        if (rangeSize != 0 && sameLargePage && physAddress == rangePhysAddress + rangeSize) {
+            rangeSize += size;
+            return;
+        }
+        flush();
+        rangePhysAddress = physAddress;
+        rangeOffset = offset;
+        rangeSize = size;
+    }
+
+    void flush() {
+        if (rangeSize != 0) {
+            rangeWalker(rangePhysAddress, rangeSize, rangeOffset);
+            rangeSize = 0;
+        }
+    }
+
+  protected:
+    uintptr_t vmBase;
+    size_t largePageSize;
+    RangeWalkerT &rangeWalker;
+    uint64_t rangePhysAddress = 0;
+    size_t rangeOffset = 0;
+    size_t rangeSize = 0;
+};
+
+template <class T, uint32_t level, uint32_t bits>
+template <typename RangeWalkerT>
+void PageTable<T, level, bits>::pageWalkRanges(uintptr_t vm, size_t size, size_t offset, RangeWalkerT &&rangeWalker) {
+    PageRangeCoalescer<RangeWalkerT> coalescer(vm, offset, largePageSize, rangeWalker);
+    walkPages(vm, size, offset, coalescer);
+    coalescer.flush();
+}
+
+template <class T, uint32_t level, uint32_t bits>
+template <typename WalkerT>
+void PageTable<T, level, bits>::walkPages(uintptr_t vm, size_t size, size_t offset, WalkerT &walker) {
+    const size_t shift = T::getBits() + 12;
+    const uintptr_t mask = (1 << bits) - 1;
+    size_t indexStart = (vm >> shift) & mask;
+    size_t indexEnd = ((vm + size - 1) >> shift) & mask;
+    uintptr_t vmMask = (uintptr_t(-1) >> (sizeof(void *) * 8 - shift - bits));
+    auto maskedVm = vm & vmMask;
+
+    for (size_t index = indexStart; index <= indexEnd; index++) {
+        uintptr_t vmStart = (uintptr_t(1) << shift) * index;
+        vmStart = std::max(vmStart, maskedVm);
+        uintptr_t vmEnd = (uintptr_t(1) << shift) * (index + 1) - 1;
+        vmEnd = std::min(vmEnd, maskedVm + size - 1);
+
+        if (entries[index] == nullptr) {
+            entries[index] = new T;
+        }
+        entries[index]->walkPages(vmStart, vmEnd - vmStart + 1, offset, walker);
+
+        offset += (vmEnd - vmStart + 1);
+    }
+}
+
+template <typename WalkerT>
+void PTE::walkPages(uintptr_t vm, size_t size, size_t offset, WalkerT &walker) {
+    const size_t shift = 12;
+    const uint32_t mask = (1 << bits) - 1;
+    size_t indexStart = (vm >> shift) & mask;
+    size_t indexEnd = ((vm + size - 1) >> shift) & mask;
+    uintptr_t rem = vm & (pageSize - 1);
+
+    mapEntries(indexStart, indexEnd);
+
+    for (size_t index = indexStart; index <= indexEnd; index++) {
+        uint64_t res = reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu;
+
+        size_t lSize = std::min(pageSize - rem, size);
+        walker((res & ~0x1) + rem, lSize, offset);
+
+        size -= lSize;
+        offset += lSize;
+        rem = 0;
+    }
+}
+} // namespace OCLRT
@@ -23,40 +23,31 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 
 namespace OCLRT {
 
+const void *SVMAllocsManager::MapBasedAllocationTracker::getEndAddress(GraphicsAllocation &ga) {
+    return ptrOffset(ga.getUnderlyingBuffer(), ga.getUnderlyingBufferSize());
+}
+
 void SVMAllocsManager::MapBasedAllocationTracker::insert(GraphicsAllocation &ga) {
-    allocs.insert(std::make_pair(ga.getUnderlyingBuffer(), &ga));
+    allocs.insert(std::make_pair(getEndAddress(ga), &ga));
 }
 
 void SVMAllocsManager::MapBasedAllocationTracker::remove(GraphicsAllocation &ga) {
     std::map<const void *, GraphicsAllocation *>::iterator iter;
-    iter = allocs.find(ga.getUnderlyingBuffer());
+    iter = allocs.find(getEndAddress(ga));
     allocs.erase(iter);
 }
 
 GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) {
-    std::map<const void *, GraphicsAllocation *>::iterator Iter, End;
-    GraphicsAllocation *GA;
     if (ptr == nullptr)
         return nullptr;
-    End = allocs.end();
-    Iter = allocs.lower_bound(ptr);
-    if (((Iter != End) && (Iter->first != ptr)) ||
-        (Iter == End)) {
-        if (Iter == allocs.begin()) {
-            Iter = End;
-        } else {
-            Iter--;
-        }
-    }
-    if (Iter != End) {
-        GA = Iter->second;
-        if (ptr < ((char *)GA->getUnderlyingBuffer() + GA->getUnderlyingBufferSize())) {
-            return GA;
-        }
+    auto iter = allocs.upper_bound(ptr);
+    if (iter != allocs.end() && iter->second->getUnderlyingBuffer() <= ptr) {
+        return iter->second;
     }
     return nullptr;
 }
@@ -68,26 +59,31 @@ void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent) {
     if (size == 0)
         return nullptr;
 
-    std::unique_lock<std::mutex> lock(mtx);
     GraphicsAllocation *GA = memoryManager->allocateGraphicsMemoryForSVM(size, coherent);
     if (!GA) {
         return nullptr;
     }
+    std::unique_lock<ReaderWriterLock> lock(allocationsLock);
     this->SVMAllocs.insert(*GA);
 
     return GA->getUnderlyingBuffer();
 }
 
 GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
+    SharedLockGuard<ReaderWriterLock> lock(allocationsLock);
     return SVMAllocs.get(ptr);
 }
 
 void SVMAllocsManager::freeSVMAlloc(void *ptr) {
-    GraphicsAllocation *GA = getSVMAlloc(ptr);
+    GraphicsAllocation *GA = nullptr;
+    {
+        std::unique_lock<ReaderWriterLock> lock(allocationsLock);
+        GA = SVMAllocs.get(ptr);
+        if (GA) {
+            SVMAllocs.remove(*GA);
+        }
+    }
     if (GA) {
-        std::unique_lock<std::mutex> lock(mtx);
-        SVMAllocs.remove(*GA);
         memoryManager->freeGraphicsMemory(GA);
     }
 }
@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include "runtime/utilities/reader_writer_lock.h"
 #include <cstdint>
 #include <map>
 #include <mutex>
@@ -33,6 +34,8 @@ class MemoryManager;
 
 class SVMAllocsManager {
   public:
+    // SVM allocations never overlap, so keying them by end address resolves any interior pointer
+    // with a single upper_bound: the first allocation ending above ptr is the only candidate.
     class MapBasedAllocationTracker {
       public:
         void insert(GraphicsAllocation &);
@@ -41,6 +44,8 @@ class SVMAllocsManager {
         size_t getNumAllocs() const { return allocs.size(); };
 
       protected:
+        static const void *getEndAddress(GraphicsAllocation &);
+
         std::map<const void *, GraphicsAllocation *> allocs;
     };
 
@@ -53,6 +58,6 @@ class SVMAllocsManager {
   protected:
     MapBasedAllocationTracker SVMAllocs;
     MemoryManager *memoryManager;
-    std::mutex mtx;
+    ReaderWriterLock allocationsLock;
 };
 } // namespace OCLRT
@@ -26,6 +26,8 @@ DECLARE_DEBUG_VARIABLE(int32_t, SetCommandStreamReceiver, 0, "Set command stream
 DECLARE_DEBUG_VARIABLE(int32_t, TbxPort, 4321, "TCP-IP port of TBX server")
 DECLARE_DEBUG_VARIABLE(bool, FlattenBatchBufferForAUBDump, false, "Dump multi-level batch buffers to AUB as single, flat batch buffer")
 DECLARE_DEBUG_VARIABLE(bool, AddPatchInfoCommentsForAUBDump, false, "Dump comments containing allocations and patching information")
+DECLARE_DEBUG_VARIABLE(int32_t, AubDumpBufferSizeMB, 0, "0: write AUB records synchronously, >0: size of buffers written to AUB file by background thread, in MB")
+DECLARE_DEBUG_VARIABLE(bool, AubDumpSkipUnchangedAllocations, false, "Skip dumping allocations whose contents did not change since they were last written to AUB")
 
 /*DEBUG FLAGS*/
 DECLARE_DEBUG_VARIABLE(int32_t, InitializeMemoryInDebug, 0x10, "Memory initialization in debug")
@@ -36,6 +38,12 @@ DECLARE_DEBUG_VARIABLE(bool, MakeEachEnqueueBlocking, false, "equivalent of fini
 DECLARE_DEBUG_VARIABLE(bool, DoCpuCopyOnReadBuffer, false, "triggers CPU copy path for Read Buffer calls, only supported for some basic use cases ( no events, not blocked calls )")
 DECLARE_DEBUG_VARIABLE(bool, DoCpuCopyOnWriteBuffer, false, "triggers CPU copy path for Write Buffer calls, only supported for some basic use cases ( no events, not blocked calls )")
 DECLARE_DEBUG_VARIABLE(bool, DisableResourceRecycling, false, "when set to true disables resource recycling optimization")
+DECLARE_DEBUG_VARIABLE(int32_t, ReusableAllocationsMaxRetainedSizeMB, -1, "-1: default (256MB), >=0: upper bound on bytes held in resource recycling pool, in MB")
+DECLARE_DEBUG_VARIABLE(bool, DisableDispatchTemplates, false, "when set to true walker and interface descriptor are programmed from scratch on every enqueue")
+DECLARE_DEBUG_VARIABLE(bool, DisableLocalIdsCache, false, "when set to true local IDs are generated on every enqueue instead of being copied from cache")
+DECLARE_DEBUG_VARIABLE(bool, EnableLwsAutotuning, false, "when set to true local work size for kernels enqueued with NULL local size is tuned on first executions and persisted in cl_cache")
+DECLARE_DEBUG_VARIABLE(bool, EnableParallelCommandRecording, false, "when set to true command queues own their heaps and record commands without holding the device lock")
+DECLARE_DEBUG_VARIABLE(bool, EnableRingBufferReuse, false, "when set to true command streams and heaps are reused as rings, reclaiming space retired by the hardware tag instead of reallocating on exhaustion")
 DECLARE_DEBUG_VARIABLE(bool, ForceDispatchScheduler, false, "dispatches scheduler kernel instead of kernel enqueued")
 DECLARE_DEBUG_VARIABLE(bool, TrackParentEvents, false, "events track their parents")
 /*LOGGING FLAGS*/
@@ -47,6 +55,12 @@ DECLARE_DEBUG_VARIABLE(bool, LogPatchTokens, false, "Enables logging patch token
 DECLARE_DEBUG_VARIABLE(bool, LogTaskCounts, false, "Enables logging taskCounts and taskLevels to file")
 DECLARE_DEBUG_VARIABLE(bool, LogAlignedAllocations, false, "Logs alignedMalloc and alignedFree allocations")
 DECLARE_DEBUG_VARIABLE(bool, LogMemoryObject, false, "Logs memory object ptrs, sizes and operations")
+DECLARE_DEBUG_VARIABLE(bool, EnableRuntimeTracing, false, "Traces api calls, enqueues, flushes, submissions, waits and allocations to per thread ring buffers, exported at platform shutdown")
+DECLARE_DEBUG_VARIABLE(std::string, RuntimeTracingFile, std::string("cl_trace.json"), "EnableRuntimeTracing only, Chrome trace event (Perfetto compatible) JSON file written at platform shutdown")
+DECLARE_DEBUG_VARIABLE(int32_t, RuntimeTracingEventsPerThread, 65536, "EnableRuntimeTracing only, capacity of per thread ring buffer, rounded up to power of two, oldest events are overwritten")
+DECLARE_DEBUG_VARIABLE(bool, EnableKernelStatsAggregation, false, "Times kernels not profiled by the application and aggregates per kernel queue to submit, submit to start and execution time histograms")
+DECLARE_DEBUG_VARIABLE(std::string, KernelStatsFile, std::string("kernel_stats.txt"), "EnableKernelStatsAggregation only, file kernel statistics are appended to at device destruction and on KernelStatsDumpSignal")
+DECLARE_DEBUG_VARIABLE(int32_t, KernelStatsDumpSignal, -1, "EnableKernelStatsAggregation only, -1: disabled, >0: signal number requesting a statistics dump, written on the next wait for completion")
 DECLARE_DEBUG_VARIABLE(bool, ResidencyDebugEnable, 0, "enables debug messages and checks for Residency Model")
 DECLARE_DEBUG_VARIABLE(bool, EventsDebugEnable, 0, "enables debug messages for events, virtual events, blocked enqueues, events trees etc.")
 DECLARE_DEBUG_VARIABLE(bool, PrintEMDebugInformation, false, "prints execution model related debug information")
@@ -61,6 +75,7 @@ DECLARE_DEBUG_VARIABLE(bool, Force32bitAddressing, false, "Forces 32 bit address
 DECLARE_DEBUG_VARIABLE(bool, DisableStatelessToStatefulOptimization, false, "Disables stateless to stateful optimization for buffers")
 DECLARE_DEBUG_VARIABLE(bool, DisableConcurrentBlockExecution, 0, "disables concurrent block kernel execution")
 DECLARE_DEBUG_VARIABLE(bool, UseNewHeapAllocator, true, "Custom 4GB heap allocator is used")
+DECLARE_DEBUG_VARIABLE(bool, UseSegregatedHeapAllocator, false, "Custom 4GB heap allocator keeps free ranges in size classes instead of lists that need defragmentation")
 DECLARE_DEBUG_VARIABLE(bool, UseNoRingFlushesKmdMode, true, "Windows only, passes flag to KMD that informs KMD to not emit any ring buffer flushes.")
 DECLARE_DEBUG_VARIABLE(bool, DisableZeroCopyForUseHostPtr, false, "When active all buffer allocations created with CL_MEM_USE_HOST_PTR flag will not share memory with CPU.")
 /*FEATURE FLAGS*/
@@ -83,7 +98,13 @@ DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleep, -1, "-1: dont overr
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideQuickKmdSleepDelayMicroseconds, -1, "-1: dont override, 0: infinite timeout, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleepForSporadicWaits, -1, "-1: dont override, 0: disable, 1: enable. It works only when QuickKmdSleep is enabled.")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideDelayQuickKmdSleepForSporadicWaitsMicroseconds, -1, "-1: dont override, >0: timeout in microseconds")
-DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr")
+DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr: 0 - device default, 1 - immediate, 2 - adaptive, 3 - batched with counter, 4 - batched")
+DECLARE_DEBUG_VARIABLE(int32_t, AdaptiveDispatchQueueDepth, 8, "AdaptiveDispatch only, number of batched command buffers that triggers submission while GPU is busy")
+DECLARE_DEBUG_VARIABLE(int32_t, AdaptiveDispatchMaxDelayMicroseconds, 500, "AdaptiveDispatch only, max time batched command buffers wait for GPU to become idle")
+DECLARE_DEBUG_VARIABLE(int32_t, BatchedDispatchCounterLimit, 16, "BatchedDispatchWithCounter only, number of batched command buffers that triggers implicit flush")
+DECLARE_DEBUG_VARIABLE(int32_t, BatchedDispatchDeadlineMicroseconds, 1000, "BatchedDispatchWithCounter only, max time batched command buffers wait for implicit flush")
+DECLARE_DEBUG_VARIABLE(int32_t, WaitSpinMicroseconds, -1, "-1: spin for the whole wait, >=0: time waiting for task count spins before the thread is parked and woken by tag watcher thread")
+DECLARE_DEBUG_VARIABLE(int32_t, WaitWatcherPollMicroseconds, 20, "interval in which tag watcher thread polls task count while any waiter is parked")
 /*DRIVER TOGGLES*/
 DECLARE_DEBUG_VARIABLE(int32_t, ForceOCLVersion, 0, "Force specific OpenCL API version")
 DECLARE_DEBUG_VARIABLE(int32_t, ForcePreemptionMode, -1, "Keep this variable in sync with PreemptionMode enum. -1 - devices default mode, 1 - disable, 2 - midBatch, 3 - threadGroup, 4 - midThread")
@@ -91,3 +112,5 @@ DECLARE_DEBUG_VARIABLE(int32_t, NodeOrdinal, -1, "-1: default do not override, 0
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideThreadArbitrationPolicy, -1, "-1 (dont override) or any valid config (0: Age Based, 1: Round Robin)")
 DECLARE_DEBUG_VARIABLE(bool, HwQueueSupported, false, "Windows only. Pass flag to KMD during Wddm Context creation")
 DECLARE_DEBUG_VARIABLE(bool, UseMaxSimdSizeToDeduceMaxWorkgroupSize, false, "With this flag on, max workgroup size is deduced using SIMD32 instead of SIMD8, this causes the max wkg size to be 4 times bigger")
+DECLARE_DEBUG_VARIABLE(int32_t, BinaryCacheMaxEntriesInMemory, 64, "Number of mapped program binaries kept open by binary cache for reuse within process, 0 - disabled")
+DECLARE_DEBUG_VARIABLE(int32_t, BinaryCacheMaxSizeMB, 1024, "Size limit of binary cache directory in MB, least recently used binaries are evicted first, 0 - unlimited")
@@ -97,7 +97,7 @@ bool OCLRT::is32BitOsAllocatorAvailable = true;
 Allocator32bit::Allocator32bit(uint64_t base, uint64_t size) {
     this->base = base;
     this->size = size;
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(base, size));
+    heapAllocator = createHeapAllocator(base, size);
 }
 
 OCLRT::Allocator32bit::Allocator32bit() : Allocator32bit(new OsInternals) {
@@ -134,7 +134,7 @@ OCLRT::Allocator32bit::Allocator32bit(Allocator32bit::OsInternals *osInternalsIn
         base = (uint64_t)ptr;
         size = sizeToMap;
 
-        heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(base, sizeToMap));
+        heapAllocator = createHeapAllocator(base, sizeToMap);
     } else {
         this->osInternals->drmAllocator = new Allocator32bit::OsInternals::Drm32BitAllocator(*this->osInternals);
     }
@@ -26,6 +26,7 @@
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "runtime/os_interface/linux/os_time.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include "runtime/utilities/stackvec.h"
 
 #include <sys/syscall.h>
@@ -44,6 +45,19 @@
 
 namespace OCLRT {
 
+namespace {
+std::atomic<uint64_t> lastExecObjectId{0};
+std::atomic<uint64_t> lastResidencyGeneration{0};
+} // namespace
+
+uint64_t BufferObject::createExecObjectId() {
+    return ++lastExecObjectId;
+}
+
+uint64_t BufferObject::createResidencyGeneration() {
+    return ++lastResidencyGeneration;
+}
+
 BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), refCount(1), handle(handle), isReused(false), isAllocated(isAllocated) {
     this->isSoftpin = false;
 
@@ -56,6 +70,7 @@ BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), r
     this->address = nullptr;
     this->lockedAddress = nullptr;
     this->offset64 = 0;
+    this->execObjectId = createExecObjectId();
 }
 
 uint32_t BufferObject::getRefCount() const {
@@ -65,6 +80,7 @@ uint32_t BufferObject::getRefCount() const {
 bool BufferObject::softPin(uint64_t offset) {
     this->isSoftpin = true;
     this->offset64 = offset;
+    this->execObjectId = createExecObjectId();
 
     return true;
 };
@@ -137,17 +153,31 @@ void BufferObject::fillExecObject(drm_i915_gem_exec_object2 &execObject) {
 
 void BufferObject::processRelocs(int &idx) {
     for (size_t i = 0; i < this->residency.size(); i++) {
-        residency[i]->fillExecObject(execObjectsStorage[idx]);
+        auto bo = residency[i];
+        //kernel writes back offsets of BOs that are not soft-pinned, those are always refilled
+        if (execObjectsIds == nullptr || !bo->isSoftpin || execObjectsIds[idx] != bo->execObjectId) {
+            bo->fillExecObject(execObjectsStorage[idx]);
+            if (execObjectsIds) {
+                execObjectsIds[idx] = bo->isSoftpin ? bo->execObjectId : 0;
+            }
+        } else {
+            //context id is not covered by execObjectId, low priority context can be created after entry was filled
+            execObjectsStorage[idx].rsvd1 = bo->drm->lowPriorityContextId;
+        }
         idx++;
     }
 }
 
 int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bool requiresCoherency, bool lowPriority) {
+    TRACE_SCOPE(Submit, "execbuffer");
     drm_i915_gem_execbuffer2 execbuf = {};
 
     int idx = 0;
     processRelocs(idx);
     this->fillExecObject(execObjectsStorage[idx]);
+    if (execObjectsIds) {
+        execObjectsIds[idx] = 0;
+    }
     idx++;
 
     execbuf.buffers_ptr = reinterpret_cast<uintptr_t>(execObjectsStorage);
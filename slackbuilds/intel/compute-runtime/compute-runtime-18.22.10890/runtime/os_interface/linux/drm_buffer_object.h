@@ -36,6 +36,7 @@ struct drm_i915_gem_relocation_entry;
 namespace OCLRT {
 
 class DrmMemoryManager;
+class DrmGemCloseWorker;
 class Drm;
 
 enum StorageAllocatorType {
@@ -49,6 +50,7 @@ enum StorageAllocatorType {
 
 class BufferObject {
     friend DrmMemoryManager;
+    friend DrmGemCloseWorker;
     using ResidencyVector = std::vector<BufferObject *>;
 
   public:
@@ -74,7 +76,10 @@ class BufferObject {
     size_t peekSize() const { return size; }
     int peekHandle() const { return handle; }
     void *peekAddress() const { return address; }
-    void setAddress(void *address) { this->address = address; }
+    void setAddress(void *address) {
+        this->address = address;
+        execObjectId = createExecObjectId();
+    }
     void *peekLockedAddress() const { return lockedAddress; }
     void setLockedAddress(void *cpuAddress) { this->lockedAddress = cpuAddress; }
     void setUnmapSize(uint64_t unmapSize) { this->unmapSize = unmapSize; }
@@ -82,9 +87,19 @@ class BufferObject {
     void swapResidencyVector(ResidencyVector *residencyVect) {
         std::swap(this->residency, *residencyVect);
     }
-    void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage) {
+    // storageIds, if given, remembers which BO state each storage entry was filled from,
+    // so entries of soft-pinned BOs that did not change since the previous exec are not rewritten
+    void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage, uint64_t *storageIds = nullptr) {
         execObjectsStorage = storage;
+        execObjectsIds = storageIds;
+    }
+
+    // Residency generations identify one exec list being built; a BO is added to it only once
+    static uint64_t createResidencyGeneration();
+    bool markResident(uint64_t generation) {
+        return residencyGeneration.exchange(generation, std::memory_order_relaxed) != generation;
     }
+    uint64_t peekExecObjectId() const { return execObjectId; }
     ResidencyVector *getResidency() { return &residency; }
     StorageAllocatorType peekAllocationType() const { return storageAllocatorType; }
     void setAllocationType(StorageAllocatorType allocatorType) { this->storageAllocatorType = allocatorType; }
@@ -98,6 +113,12 @@ class BufferObject {
 
     ResidencyVector residency;
     drm_i915_gem_exec_object2 *execObjectsStorage;
+    uint64_t *execObjectsIds = nullptr;
+
+    static uint64_t createExecObjectId();
+    // changes whenever a field written by fillExecObject changes
+    uint64_t execObjectId;
+    std::atomic<uint64_t> residencyGeneration{0};
 
     int handle; // i915 gem object handle
     bool isSoftpin;
@@ -118,5 +139,9 @@ class BufferObject {
     bool isAllocated = false;
     uint64_t unmapSize = 0;
     StorageAllocatorType storageAllocatorType = UNKNOWN_ALLOCATOR;
+
+    // closes queued on DrmGemCloseWorker, the BO is linked into its list only by the first one
+    std::atomic<uint32_t> pendingCloses{0};
+    BufferObject *nextToClose = nullptr;
 };
 }
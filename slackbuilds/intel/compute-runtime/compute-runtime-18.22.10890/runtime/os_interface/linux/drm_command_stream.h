@@ -69,7 +69,10 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
     void programVFEState(LinearStream &csr, DispatchFlags &dispatchFlags) override;
 
     std::vector<BufferObject *> residency;
+    // BOs already in residency carry this generation, so each one is added once per exec
+    uint64_t residencyGeneration = 0;
     std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
+    std::vector<uint64_t> execObjectsIds;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
     bool mediaVfeStateLowPriorityDirty = true;
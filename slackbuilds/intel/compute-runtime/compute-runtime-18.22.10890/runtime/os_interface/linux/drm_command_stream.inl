@@ -42,7 +42,9 @@ DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo
     : BaseClass(hwInfoIn), gemCloseWorkerOperationMode(mode) {
     this->drm = drm ? drm : Drm::get(0);
     residency.reserve(512);
+    residencyGeneration = BufferObject::createResidencyGeneration();
     execObjectsStorage.reserve(512);
+    execObjectsIds.reserve(512);
     CommandStreamReceiver::osInterface = std::unique_ptr<OSInterface>(new OSInterface());
     CommandStreamReceiver::osInterface.get()->get()->setDrm(this->drm);
 }
@@ -68,17 +70,23 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
         if (requiredSize > this->execObjectsStorage.size()) {
             this->execObjectsStorage.resize(requiredSize);
         }
+        if (this->execObjectsIds.size() != this->execObjectsStorage.size()) {
+            // storage was resized, none of its entries can be reused
+            this->execObjectsIds.assign(this->execObjectsStorage.size(), 0);
+        }
 
+        // residency is lent to the batch buffer for exec and taken back with its capacity
         bb->swapResidencyVector(&this->residency);
-        bb->setExecObjectsStorage(this->execObjectsStorage.data());
-        this->residency.reserve(512);
+        bb->setExecObjectsStorage(this->execObjectsStorage.data(), this->execObjectsIds.data());
 
         bb->exec(static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
                  alignedStart, engineFlag | I915_EXEC_NO_RELOC,
                  batchBuffer.requiresCoherency,
                  batchBuffer.low_priority);
 
-        bb->getResidency()->clear();
+        bb->swapResidencyVector(&this->residency);
+        this->residency.clear();
+        residencyGeneration = BufferObject::createResidencyGeneration();
 
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerActive) {
             bb->reference();
@@ -100,7 +108,7 @@ void DrmCommandStreamReceiver<GfxFamily>::makeResident(GraphicsAllocation &gfxAl
 
 template <typename GfxFamily>
 void DrmCommandStreamReceiver<GfxFamily>::makeResident(BufferObject *bo) {
-    if (bo) {
+    if (bo && bo->markResident(residencyGeneration)) {
         residency.push_back(bo);
     }
 }
@@ -132,6 +140,7 @@ void DrmCommandStreamReceiver<GfxFamily>::makeNonResident(GraphicsAllocation &gf
     if (gfxAllocation.residencyTaskCount != ObjectNotResident) {
         if (this->residency.size() != 0) {
             this->residency.clear();
+            residencyGeneration = BufferObject::createResidencyGeneration();
         }
         if (gfxAllocation.fragmentsStorage.fragmentCount) {
             for (auto fragmentId = 0u; fragmentId < gfxAllocation.fragmentsStorage.fragmentCount; fragmentId++) {
@@ -22,7 +22,6 @@
 
 #include <atomic>
 #include <iostream>
-#include <queue>
 #include <stdio.h>
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
@@ -54,15 +53,25 @@ DrmGemCloseWorker::~DrmGemCloseWorker() {
 }
 
 void DrmGemCloseWorker::push(BufferObject *bo) {
-    std::unique_lock<std::mutex> lock(closeWorkerMutex);
     workCount++;
-    queue.push(bo);
-    lock.unlock();
-    condition.notify_one();
+    //BO already queued is released together with its earlier closes
+    if (bo->pendingCloses.fetch_add(1) == 0) {
+        bo->nextToClose = pendingWork.load(std::memory_order_relaxed);
+        while (!pendingWork.compare_exchange_weak(bo->nextToClose, bo)) {
+        }
+    }
+
+    if (workerWaiting.load()) {
+        std::lock_guard<std::mutex> lock(closeWorkerMutex);
+        condition.notify_one();
+    }
 }
 
 void DrmGemCloseWorker::close(bool blocking) {
-    active = false;
+    {
+        std::lock_guard<std::mutex> lock(closeWorkerMutex);
+        active = false;
+    }
     condition.notify_all();
     if (blocking) {
         closeThread();
@@ -73,47 +82,55 @@ bool DrmGemCloseWorker::isEmpty() {
     return workCount.load() == 0;
 }
 
-inline void DrmGemCloseWorker::close(BufferObject *bo) {
-    bo->wait(-1);
-    memoryManager.unreference(bo);
-    workCount--;
+BufferObject *DrmGemCloseWorker::takePendingWork() {
+    auto bo = pendingWork.exchange(nullptr);
+
+    //BOs were pushed on a stack, restore submission order
+    BufferObject *batch = nullptr;
+    while (bo) {
+        auto next = bo->nextToClose;
+        bo->nextToClose = batch;
+        batch = bo;
+        bo = next;
+    }
+    return batch;
+}
+
+void DrmGemCloseWorker::closeBatch(BufferObject *batch) {
+    uint32_t closedCount = 0;
+    while (batch) {
+        auto bo = batch;
+        batch = bo->nextToClose;
+        //push after this point links the BO again and holds its own reference
+        auto closes = bo->pendingCloses.exchange(0);
+        bo->wait(-1);
+        for (uint32_t i = 0; i < closes; i++) {
+            memoryManager.unreference(bo);
+        }
+        closedCount += closes;
+    }
+    workCount -= closedCount;
 }
 
 void *DrmGemCloseWorker::worker(void *arg) {
     DrmGemCloseWorker *self = reinterpret_cast<DrmGemCloseWorker *>(arg);
-    BufferObject *workItem = nullptr;
-    std::queue<BufferObject *> localQueue;
-    std::unique_lock<std::mutex> lock(self->closeWorkerMutex);
-    lock.unlock();
 
     while (self->active) {
-        lock.lock();
-        workItem = nullptr;
-
-        while (self->queue.empty() && self->active) {
-            self->condition.wait(lock);
+        auto batch = self->takePendingWork();
+        if (batch) {
+            self->closeBatch(batch);
+            continue;
         }
 
-        if (!self->queue.empty()) {
-            localQueue.swap(self->queue);
-        }
-
-        lock.unlock();
-        while (!localQueue.empty()) {
-            workItem = localQueue.front();
-            localQueue.pop();
-            self->close(workItem);
+        std::unique_lock<std::mutex> lock(self->closeWorkerMutex);
+        self->workerWaiting.store(true);
+        while (self->pendingWork.load() == nullptr && self->active) {
+            self->condition.wait(lock);
         }
+        self->workerWaiting.store(false);
     }
 
-    lock.lock();
-    while (!self->queue.empty()) {
-        workItem = self->queue.front();
-        self->queue.pop();
-        self->close(workItem);
-    }
-
-    lock.unlock();
+    self->closeBatch(self->takePendingWork());
     self->workerDone.store(true);
     return nullptr;
 }
@@ -25,8 +25,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <map>
+#include <memory>
 #include <set>
-#include <queue>
 #include <cstdint>
 
 namespace OCLRT {
@@ -53,15 +53,19 @@ class DrmGemCloseWorker {
     bool isEmpty();
 
   protected:
-    void close(BufferObject *workItem);
+    BufferObject *takePendingWork();
+    void closeBatch(BufferObject *batch);
     void closeThread();
     static void *worker(void *arg);
-    bool active = true;
+    std::atomic<bool> active{true};
 
     std::unique_ptr<Thread> thread;
 
-    std::queue<BufferObject *> queue;
+    // producers push with a CAS, the worker takes the whole list at once
+    std::atomic<BufferObject *> pendingWork{nullptr};
     std::atomic<uint32_t> workCount{0};
+    // set while the worker sleeps, so producers only notify when there is someone to wake
+    std::atomic<bool> workerWaiting{false};
 
     DrmMemoryManager &memoryManager;
 
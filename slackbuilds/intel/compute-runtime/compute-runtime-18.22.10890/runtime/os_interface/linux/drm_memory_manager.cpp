@@ -28,6 +28,7 @@
 #include "runtime/os_interface/linux/drm_buffer_object.h"
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/helpers/surface_formats.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include <cstring>
 #include <iostream>
 
@@ -167,6 +168,7 @@ DrmAllocation *DrmMemoryManager::createGraphicsAllocation(OsHandleStorage &handl
 }
 
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) {
+    TRACE_SCOPE(Allocation, "allocateGraphicsMemory");
     const size_t minAlignment = MemoryConstants::allocationAlignment;
     size_t cAlignment = alignUp(std::max(alignment, minAlignment), minAlignment);
     // When size == 0 allocate allocationAlignment
@@ -194,6 +196,7 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
 }
 
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, const void *ptr, bool forcePin) {
+    TRACE_SCOPE(Allocation, "allocateGraphicsMemoryForHostPtr");
     auto res = (DrmAllocation *)MemoryManager::allocateGraphicsMemory(size, const_cast<void *>(ptr), forcePin);
 
     bool forcePinAllowed = res != nullptr && pinBB != nullptr && forcePinEnabled && forcePin && size >= this->pinThreshold;
@@ -209,6 +212,7 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory64kb(size_t size, size_t
 }
 
 GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &imgInfo, Gmm *gmm) {
+    TRACE_SCOPE(Allocation, "allocateGraphicsMemoryForImage");
     if (!Gmm::allowTiling(*imgInfo.imgDesc)) {
         auto alloc = allocateGraphicsMemory(imgInfo.size, MemoryConstants::preferredAlignment);
         if (alloc) {
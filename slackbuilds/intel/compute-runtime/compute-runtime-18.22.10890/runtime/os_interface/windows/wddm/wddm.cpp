@@ -36,6 +36,7 @@
 #include "runtime/helpers/wddm_helper.h"
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/sku_info/operations/sku_info_receiver.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include "runtime/utilities/stackvec.h"
 #include <dxgi.h>
 #include "CL/cl.h"
@@ -754,6 +755,7 @@ bool Wddm::destroyContext(D3DKMT_HANDLE context) {
 }
 
 bool Wddm::submit(uint64_t commandBuffer, size_t size, void *commandHeader) {
+    TRACE_SCOPE(Submit, "submitCommand");
     D3DKMT_SUBMITCOMMAND SubmitCommand = {0};
     NTSTATUS status = STATUS_SUCCESS;
     bool success = true;
@@ -22,6 +22,7 @@
 
 #include "runtime/os_interface/windows/gdi_interface.h"
 #include "runtime/os_interface/windows/wddm/wddm23.h"
+#include "runtime/utilities/runtime_tracer.h"
 
 namespace OCLRT {
 Wddm23::Wddm23() : Wddm20() {}
@@ -64,6 +65,7 @@ void Wddm23::destroyHwQueue() {
 }
 
 bool Wddm23::submit(uint64_t commandBuffer, size_t size, void *commandHeader) {
+    TRACE_SCOPE(Submit, "submitCommandToHwQueue");
     D3DKMT_SUBMITCOMMANDTOHWQUEUE submitCommand = {};
     submitCommand.hHwQueue = hwQueueHandle;
     submitCommand.HwQueueProgressFenceId = monitoredFence.fenceHandle;
@@ -34,7 +34,7 @@ class Allocator32bit::OsInternals {
 Allocator32bit::Allocator32bit(uint64_t base, uint64_t size) {
     this->base = base;
     this->size = size;
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(base, size));
+    heapAllocator = createHeapAllocator(base, size);
 }
 
 OCLRT::Allocator32bit::Allocator32bit() {
@@ -43,7 +43,7 @@ OCLRT::Allocator32bit::Allocator32bit() {
     osInternals = std::unique_ptr<OsInternals>(new OsInternals);
     osInternals.get()->allocatedRange = (void *)((uintptr_t)this->base);
 
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(this->base, sizeToMap));
+    heapAllocator = createHeapAllocator(this->base, sizeToMap);
 }
 
 OCLRT::Allocator32bit::~Allocator32bit() {
@@ -30,10 +30,12 @@
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
+#include "runtime/utilities/runtime_tracer.h"
 #include "CL/cl_ext.h"
 
 namespace OCLRT {
@@ -118,6 +120,10 @@ bool Platform::initialize(size_t numDevices,
         return true;
     }
 
+    if (DebugManager.flags.EnableRuntimeTracing.get()) {
+        RuntimeTracer::enable(static_cast<size_t>(DebugManager.flags.RuntimeTracingEventsPerThread.get()), DebugManager.flags.RuntimeTracingFile.get());
+    }
+
     state = OCLRT::getDevices(&hwInfo, numDevicesReturned) ? StateIniting : StateNone;
 
     if (state == StateNone) {
@@ -194,6 +200,11 @@ void Platform::shutdown() {
     std::string().swap(compilerExtensions);
 
     gtpinNotifyPlatformShutdown();
+
+    if (RuntimeTracer::isEnabled()) {
+        RuntimeTracer::disable();
+        RuntimeTracer::exportChromeTrace();
+    }
 }
 
 Device *Platform::getDevice(size_t deviceOrdinal) {
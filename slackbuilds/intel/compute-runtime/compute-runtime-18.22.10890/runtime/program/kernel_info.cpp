@@ -24,6 +24,7 @@
 #include "runtime/device/device.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/dispatch_info.h"
+#include "runtime/helpers/hash.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
@@ -501,6 +502,22 @@ uint32_t KernelInfo::getConstantBufferSize() const {
     return patchInfo.dataParameterStream ? patchInfo.dataParameterStream->DataParameterStreamSize : 0;
 }
 
+uint64_t KernelInfo::getIsaHash() const {
+    auto hashValue = isaHash.load(std::memory_order_relaxed);
+    if (hashValue != 0) {
+        return hashValue;
+    }
+    Hash hash;
+    hash.update(name.c_str(), name.size());
+    if (heapInfo.pKernelHeader) {
+        hash.update(reinterpret_cast<const char *>(heapInfo.pKernelHeap), heapInfo.pKernelHeader->KernelHeapSize);
+    }
+    // racing threads compute the same value, 0 is reserved for "not computed yet"
+    hashValue = std::max<uint64_t>(hash.finish(), 1);
+    isaHash.store(hashValue, std::memory_order_relaxed);
+    return hashValue;
+}
+
 bool KernelInfo::createKernelAllocation(MemoryManager *memoryManager) {
     UNRECOVERABLE_IF(kernelAllocation);
     auto kernelIsaSize = heapInfo.pKernelHeader->KernelHeapSize;
@@ -27,6 +27,7 @@
 #include "patch_info.h"
 #include "runtime/helpers/hw_info.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cmath>
 #include <vector>
@@ -215,6 +216,8 @@ struct KernelInfo {
     }
 
     uint32_t getConstantBufferSize() const;
+    // hash of the kernel name and ISA, computed on first use
+    uint64_t getIsaHash() const;
     int32_t getArgNumByName(const char *name) const {
         int32_t argNum = 0;
         for (auto &arg : kernelArgInfo) {
@@ -251,5 +254,6 @@ struct KernelInfo {
     bool isKernelHeapSubstituted = false;
     GraphicsAllocation *kernelAllocation = nullptr;
     DebugData debugData;
+    mutable std::atomic<uint64_t> isaHash{0};
 };
 } // namespace OCLRT
@@ -27,6 +27,7 @@
 #include "runtime/helpers/string.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/compiler_interface/compiler_interface.h"
+#include "runtime/utilities/mapped_file.h"
 
 #include <sstream>
 
@@ -101,8 +102,7 @@ Program::~Program() {
     if (context && !isBuiltIn) {
         context->decRefInternal();
     }
-    delete[] genBinary;
-    genBinary = nullptr;
+    releaseGenBinary();
 
     delete[] llvmBinary;
     llvmBinary = nullptr;
@@ -265,9 +265,30 @@ cl_int Program::getSource(char *&pBinary, unsigned int &dataSize) const {
 void Program::storeGenBinary(
     const void *pSrc,
     const size_t srcSize) {
+    releaseGenBinary();
     storeBinary(genBinary, genBinarySize, pSrc, srcSize);
 }
 
+void Program::storeGenBinary(std::shared_ptr<const MappedFile> mappedBinary) {
+    DEBUG_BREAK_IF(!(mappedBinary && mappedBinary->size() > 0));
+    releaseGenBinary();
+
+    // gen binary is only read, kernel heaps keep pointing into mapping until program is released
+    genBinaryMapping = std::move(mappedBinary);
+    genBinary = const_cast<char *>(genBinaryMapping->data());
+    genBinarySize = genBinaryMapping->size();
+}
+
+void Program::releaseGenBinary() {
+    if (genBinaryMapping) {
+        genBinaryMapping.reset();
+    } else {
+        delete[] genBinary;
+    }
+    genBinary = nullptr;
+    genBinarySize = 0;
+}
+
 void Program::storeLlvmBinary(
     const void *pSrc,
     const size_t srcSize) {
@@ -34,12 +34,14 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
 namespace OCLRT {
 class Context;
 class CompilerInterface;
+class MappedFile;
 template <>
 struct OpenCLObjectMapper<_cl_program> {
     typedef class Program DerivedType;
@@ -179,6 +181,7 @@ class Program : public BaseObject<_cl_program> {
     cl_int getSource(char *&pBinary, unsigned int &dataSize) const;
 
     void storeGenBinary(const void *pSrc, const size_t srcSize);
+    void storeGenBinary(std::shared_ptr<const MappedFile> mappedBinary);
 
     char *getGenBinary(size_t &genBinarySize) const {
         genBinarySize = this->genBinarySize;
@@ -271,6 +274,7 @@ class Program : public BaseObject<_cl_program> {
     size_t processKernel(const void *pKernelBlob, cl_int &retVal);
 
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
+    void releaseGenBinary();
 
     bool validateGenBinaryDevice(GFXCORE_FAMILY device) const;
     bool validateGenBinaryHeader(const iOpenCL::SProgramBinaryHeader *pGenBinaryHeader) const;
@@ -294,6 +298,7 @@ class Program : public BaseObject<_cl_program> {
 
     char*                     genBinary;
     size_t                    genBinarySize;
+    std::shared_ptr<const MappedFile> genBinaryMapping;
 
     char*                     llvmBinary;
     size_t                    llvmBinarySize;
@@ -61,6 +61,7 @@ struct CpuInfo {
     static const uint64_t featureAvX512Cd = 0x400000000ULL;
     static const uint64_t featureSha = 0x800000000ULL;
     static const uint64_t featureMpx = 0x1000000000ULL;
+    static const uint64_t featureAvX512Bw = 0x2000000000ULL;
 
     CpuInfo() : features(featureNone) {
     }
@@ -74,8 +75,15 @@ struct CpuInfo {
         uint32_t functionId,
         uint32_t subfunctionId) const;
 
+    uint64_t xgetbv(uint32_t index) const;
+
+    // XCR0 state components the OS has to save for AVX (SSE, AVX) and AVX-512 (also opmask, ZMM_Hi256, Hi16_ZMM)
+    static const uint64_t xcr0AvxState = BIT(1) | BIT(2);
+    static const uint64_t xcr0AvX512State = xcr0AvxState | BIT(5) | BIT(6) | BIT(7);
+
     void detect() const {
         uint32_t cpuInfo[4];
+        uint64_t xcr0 = 0;
 
         cpuid(cpuInfo, 0u);
         auto numFunctionIds = cpuInfo[0];
@@ -143,7 +151,12 @@ struct CpuInfo {
             }
 
             {
-                features |= cpuInfo[2] & BIT(28) ? featureAvx : featureNone;
+                // XGETBV is available only when the OS enabled XSAVE
+                xcr0 = cpuInfo[2] & BIT(27) ? xgetbv(0) : 0;
+            }
+
+            {
+                features |= (cpuInfo[2] & BIT(28)) && (xcr0 & xcr0AvxState) == xcr0AvxState ? featureAvx : featureNone;
             }
 
             {
@@ -159,7 +172,7 @@ struct CpuInfo {
             cpuid(cpuInfo, 7u);
             {
                 auto mask = BIT(5) | BIT(3) | BIT(8);
-                features |= (cpuInfo[1] & mask) == mask ? featureAvX2 : featureNone;
+                features |= (cpuInfo[1] & mask) == mask && (xcr0 & xcr0AvxState) == xcr0AvxState ? featureAvX2 : featureNone;
             }
 
             {
@@ -174,6 +187,14 @@ struct CpuInfo {
             {
                 features |= cpuInfo[1] & BIT(11) ? featureRtm : featureNone;
             }
+
+            {
+                features |= (cpuInfo[1] & BIT(16)) && (xcr0 & xcr0AvX512State) == xcr0AvX512State ? featureAvX512F : featureNone;
+            }
+
+            {
+                features |= (cpuInfo[1] & BIT(30)) && (xcr0 & xcr0AvX512State) == xcr0AvX512State ? featureAvX512Bw : featureNone;
+            }
         }
 
         cpuid(cpuInfo, 0x80000000);
@@ -199,6 +220,7 @@ struct CpuInfo {
     }
 
     static void (*cpuidexFunc)(int *, int, int);
+    static uint64_t (*xgetbvFunc)(uint32_t);
 
   protected:
     mutable uint64_t features;
@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -29,5 +30,9 @@ namespace OCLRT {
 class Directory {
   public:
     static std::vector<std::string> getFiles(std::string &path);
+    // times are in seconds since epoch
+    static bool getFileInfo(const std::string &path, size_t &size, uint64_t &lastModified, uint64_t &lastAccessed);
+    // 0 - keep current time
+    static bool setFileTimes(const std::string &path, uint64_t lastModified, uint64_t lastAccessed);
 };
 };
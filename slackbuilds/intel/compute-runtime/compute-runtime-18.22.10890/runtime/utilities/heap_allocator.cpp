@@ -20,11 +20,20 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/utilities/heap_allocator.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
 
 namespace OCLRT {
 
 bool operator<(const HeapChunk &hc1, const HeapChunk &hc2) {
     return hc1.ptr < hc2.ptr;
 }
+
+std::unique_ptr<HeapAllocator> createHeapAllocator(uint64_t address, uint64_t size) {
+    if (DebugManager.flags.UseSegregatedHeapAllocator.get()) {
+        return std::unique_ptr<HeapAllocator>(new SegregatedHeapAllocator(address, size));
+    }
+    return std::unique_ptr<HeapAllocator>(new HeapAllocator(address, size));
+}
 }
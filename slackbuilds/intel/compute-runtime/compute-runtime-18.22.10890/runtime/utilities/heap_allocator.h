@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <algorithm>
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -40,6 +41,9 @@ struct HeapChunk {
 
 bool operator<(const HeapChunk &hc1, const HeapChunk &hc2);
 
+class HeapAllocator;
+std::unique_ptr<HeapAllocator> createHeapAllocator(uint64_t address, uint64_t size);
+
 class HeapAllocator {
   public:
     HeapAllocator(uint64_t address, uint64_t size) : address(address), size(size), availableSize(size), sizeThreshold(defaultSizeThreshold) {
@@ -56,10 +60,10 @@ class HeapAllocator {
         freedChunksSmall.reserve(50);
     }
 
-    ~HeapAllocator() {
+    virtual ~HeapAllocator() {
     }
 
-    uint64_t allocate(size_t &sizeToAllocate) {
+    virtual uint64_t allocate(size_t &sizeToAllocate) {
         std::lock_guard<std::mutex> lock(mtx);
         sizeToAllocate = alignUp(sizeToAllocate, allocationAlignment);
         uint64_t ptrReturn = 0llu;
@@ -112,7 +116,7 @@ class HeapAllocator {
         return ptrReturn;
     }
 
-    void free(uint64_t ptr, size_t size) {
+    virtual void free(uint64_t ptr, size_t size) {
         std::lock_guard<std::mutex> lock(mtx);
         auto ptrIn = ptr;
         if (ptrIn == 0llu)
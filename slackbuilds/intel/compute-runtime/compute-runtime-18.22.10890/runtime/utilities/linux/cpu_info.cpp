@@ -32,6 +32,16 @@ void cpuidex_linux_wrapper(int *cpuInfo, int functionId, int subfunctionId) {
 
 void (*CpuInfo::cpuidexFunc)(int *, int, int) = cpuidex_linux_wrapper;
 
+uint64_t xgetbv_linux_wrapper(uint32_t index) {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv"
+                     : "=a"(eax), "=d"(edx)
+                     : "c"(index));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+uint64_t (*CpuInfo::xgetbvFunc)(uint32_t) = xgetbv_linux_wrapper;
+
 const CpuInfo CpuInfo::instance;
 
 void CpuInfo::cpuid(
@@ -47,4 +57,8 @@ void CpuInfo::cpuidex(
     cpuidexFunc(reinterpret_cast<int *>(cpuInfo), functionId, subfunctionId);
 }
 
+uint64_t CpuInfo::xgetbv(uint32_t index) const {
+    return xgetbvFunc(index);
+}
+
 } // namespace OCLRT
@@ -23,6 +23,8 @@
 #include "runtime/utilities/directory.h"
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 namespace OCLRT {
 
@@ -51,4 +53,25 @@ std::vector<std::string> Directory::getFiles(std::string &path) {
     closedir(dir);
     return files;
 }
+
+bool Directory::getFileInfo(const std::string &path, size_t &size, uint64_t &lastModified, uint64_t &lastAccessed) {
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return false;
+    }
+
+    size = static_cast<size_t>(fileStat.st_size);
+    lastModified = static_cast<uint64_t>(fileStat.st_mtime);
+    lastAccessed = static_cast<uint64_t>(fileStat.st_atime);
+    return true;
+}
+
+bool Directory::setFileTimes(const std::string &path, uint64_t lastModified, uint64_t lastAccessed) {
+    struct timespec times[2] = {};
+    times[0].tv_sec = static_cast<time_t>(lastAccessed);
+    times[0].tv_nsec = lastAccessed ? 0 : UTIME_OMIT;
+    times[1].tv_sec = static_cast<time_t>(lastModified);
+    times[1].tv_nsec = lastModified ? 0 : UTIME_OMIT;
+    return utimensat(AT_FDCWD, path.c_str(), times, 0) == 0;
+}
 };
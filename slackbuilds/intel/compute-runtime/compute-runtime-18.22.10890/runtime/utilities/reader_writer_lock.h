@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+// Lock for read-mostly data: any number of readers may hold it at once, writers are exclusive.
+// A waiting writer blocks new readers, so a steady stream of lookups cannot starve updates.
+// Waiters are parked on condition variables rather than spinning.
+// Satisfies BasicLockable, so std::lock_guard can be used for the exclusive side.
+class ReaderWriterLock {
+  public:
+    void lock() {
+        std::unique_lock<std::mutex> guard(mtx);
+        waitingWriters++;
+        writersCondition.wait(guard, [this] { return !writerActive && activeReaders == 0; });
+        waitingWriters--;
+        writerActive = true;
+    }
+
+    void unlock() {
+        std::lock_guard<std::mutex> guard(mtx);
+        writerActive = false;
+        if (waitingWriters > 0) {
+            writersCondition.notify_one();
+        } else {
+            readersCondition.notify_all();
+        }
+    }
+
+    void lock_shared() {
+        std::unique_lock<std::mutex> guard(mtx);
+        readersCondition.wait(guard, [this] { return !writerActive && waitingWriters == 0; });
+        activeReaders++;
+    }
+
+    void unlock_shared() {
+        std::lock_guard<std::mutex> guard(mtx);
+        activeReaders--;
+        if (activeReaders == 0 && waitingWriters > 0) {
+            writersCondition.notify_one();
+        }
+    }
+
+  protected:
+    std::mutex mtx;
+    std::condition_variable readersCondition;
+    std::condition_variable writersCondition;
+    uint32_t activeReaders = 0;
+    uint32_t waitingWriters = 0;
+    bool writerActive = false;
+};
+
+template <typename LockT>
+class SharedLockGuard {
+  public:
+    explicit SharedLockGuard(LockT &lock) : sharedLock(lock) {
+        sharedLock.lock_shared();
+    }
+    ~SharedLockGuard() {
+        sharedLock.unlock_shared();
+    }
+    SharedLockGuard(const SharedLockGuard &) = delete;
+    SharedLockGuard &operator=(const SharedLockGuard &) = delete;
+
+  protected:
+    LockT &sharedLock;
+};
+} // namespace OCLRT
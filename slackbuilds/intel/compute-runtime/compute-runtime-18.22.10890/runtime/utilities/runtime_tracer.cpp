@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/runtime_tracer.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/debug_helpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace OCLRT {
+
+struct RuntimeTracer::State {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    size_t eventsPerThread = 0;
+    std::string traceFile;
+    uint64_t baseTimestamp = 0;
+};
+
+std::atomic<bool> RuntimeTracer::enabled{false};
+RuntimeTracer::State *RuntimeTracer::state = nullptr;
+std::atomic<uint32_t> RuntimeTracer::generation{0};
+
+namespace {
+// guards the tracer state, never taken while recording into an obtained buffer
+std::mutex registryMtx;
+thread_local std::shared_ptr<TraceBuffer> threadBuffer;
+thread_local uint32_t threadBufferGeneration = 0;
+
+void writeMicroseconds(std::ostream &out, uint64_t nanoseconds) {
+    out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+}
+} // namespace
+
+TraceBuffer::TraceBuffer(size_t capacity, uint32_t threadIndex)
+    : slots(new Slot[capacity]), capacity(capacity), mask(capacity - 1), threadIndex(threadIndex) {
+    DEBUG_BREAK_IF(capacity == 0 || (capacity & mask) != 0);
+}
+
+bool TraceBuffer::readEvent(uint64_t index, TraceEvent &event) const {
+    auto &slot = slots[index & mask];
+    auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2) {
+        return false;
+    }
+    event.name = slot.name.load(std::memory_order_relaxed);
+    event.start = slot.start.load(std::memory_order_relaxed);
+    event.end = slot.end.load(std::memory_order_relaxed);
+    event.category = slot.category.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+std::vector<TraceEvent> TraceBuffer::getEvents() const {
+    auto writtenCount = peekWrittenCount();
+    auto count = static_cast<size_t>(std::min<uint64_t>(writtenCount, capacity));
+    std::vector<TraceEvent> result;
+    result.reserve(count);
+    for (auto index = writtenCount - count; index < writtenCount; index++) {
+        TraceEvent event;
+        if (readEvent(index, event)) {
+            result.push_back(event);
+        }
+    }
+    return result;
+}
+
+void RuntimeTracer::enable(size_t eventsPerThread, const std::string &traceFile) {
+    std::lock_guard<std::mutex> lock(registryMtx);
+    if (state == nullptr) {
+        state = new State;
+        state->baseTimestamp = getTimestamp();
+    }
+    state->eventsPerThread = Math::nextPowerOfTwo(static_cast<uint32_t>(std::max<size_t>(eventsPerThread, 1u)));
+    state->traceFile = traceFile;
+    generation++;
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void RuntimeTracer::disable() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void RuntimeTracer::reset() {
+    std::lock_guard<std::mutex> lock(registryMtx);
+    enabled.store(false, std::memory_order_relaxed);
+    generation++;
+    delete state;
+    state = nullptr;
+    // the calling thread is not recording, other threads release their buffers when they obtain new ones or exit
+    threadBuffer.reset();
+}
+
+uint64_t RuntimeTracer::getTimestamp() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+TraceBuffer *RuntimeTracer::getThreadBuffer() {
+    auto currentGeneration = generation.load(std::memory_order_acquire);
+    if (threadBuffer != nullptr && threadBufferGeneration == currentGeneration) {
+        return threadBuffer.get();
+    }
+    std::lock_guard<std::mutex> lock(registryMtx);
+    if (state == nullptr) {
+        return nullptr;
+    }
+    auto threadIndex = static_cast<uint32_t>(state->buffers.size());
+    threadBuffer = std::make_shared<TraceBuffer>(state->eventsPerThread, threadIndex);
+    threadBufferGeneration = generation.load(std::memory_order_relaxed);
+    state->buffers.push_back(threadBuffer);
+    return threadBuffer.get();
+}
+
+void RuntimeTracer::record(TraceCategory category, const char *name, uint64_t start, uint64_t end) {
+    auto buffer = getThreadBuffer();
+    if (buffer != nullptr) {
+        buffer->record(category, name, start, end);
+    }
+}
+
+const char *RuntimeTracer::getCategoryName(TraceCategory category) {
+    switch (category) {
+    case TraceCategory::Api:
+        return "api";
+    case TraceCategory::Enqueue:
+        return "enqueue";
+    case TraceCategory::Flush:
+        return "flush";
+    case TraceCategory::Submit:
+        return "submit";
+    case TraceCategory::Wait:
+        return "wait";
+    case TraceCategory::Allocation:
+        return "allocation";
+    default:
+        return "unknown";
+    }
+}
+
+size_t RuntimeTracer::getBuffersCount() {
+    std::lock_guard<std::mutex> lock(registryMtx);
+    return state ? state->buffers.size() : 0;
+}
+
+// Chrome trace event format, complete events ("ph":"X") with microsecond timestamps relative to enable.
+void RuntimeTracer::exportChromeTrace(std::ostream &out) {
+    out << "{\"traceEvents\":[";
+    std::lock_guard<std::mutex> lock(registryMtx);
+    if (state != nullptr) {
+        bool first = true;
+        for (auto &buffer : state->buffers) {
+            for (auto &event : buffer->getEvents()) {
+                auto start = event.start > state->baseTimestamp ? event.start - state->baseTimestamp : 0;
+                auto duration = event.end > event.start ? event.end - event.start : 0;
+                out << (first ? "\n" : ",\n");
+                out << "{\"name\":\"" << event.name << "\",\"cat\":\"" << getCategoryName(event.category)
+                    << "\",\"ph\":\"X\",\"ts\":";
+                writeMicroseconds(out, start);
+                out << ",\"dur\":";
+                writeMicroseconds(out, duration);
+                out << ",\"pid\":1,\"tid\":" << buffer->getThreadIndex() << "}";
+                first = false;
+            }
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+bool RuntimeTracer::exportChromeTrace() {
+    std::string traceFilePath;
+    {
+        std::lock_guard<std::mutex> lock(registryMtx);
+        if (state == nullptr || state->traceFile.empty()) {
+            return false;
+        }
+        traceFilePath = state->traceFile;
+    }
+    std::ofstream traceFile(traceFilePath, std::ios::trunc);
+    if (!traceFile.is_open()) {
+        return false;
+    }
+    exportChromeTrace(traceFile);
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+enum class TraceCategory : uint32_t {
+    Api,
+    Enqueue,
+    Flush,
+    Submit,
+    Wait,
+    Allocation,
+    Count
+};
+
+struct TraceEvent {
+    const char *name;
+    uint64_t start;
+    uint64_t end;
+    TraceCategory category;
+};
+
+// Ring of events written only by its owning thread, oldest events are overwritten when full.
+// Every slot carries a sequence number, odd while the owner writes it, so that readers
+// skip events that are overwritten while being copied.
+class TraceBuffer {
+  public:
+    TraceBuffer(size_t capacity, uint32_t threadIndex);
+
+    void record(TraceCategory category, const char *name, uint64_t start, uint64_t end) {
+        auto index = written.load(std::memory_order_relaxed);
+        auto &slot = slots[index & mask];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        written.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<TraceEvent> getEvents() const;
+    uint64_t peekWrittenCount() const { return written.load(std::memory_order_acquire); }
+    uint32_t getThreadIndex() const { return threadIndex; }
+    size_t getCapacity() const { return capacity; }
+
+  protected:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+        std::atomic<TraceCategory> category{TraceCategory::Api};
+    };
+
+    bool readEvent(uint64_t index, TraceEvent &event) const;
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity;
+    size_t mask;
+    std::atomic<uint64_t> written{0};
+    uint32_t threadIndex;
+};
+
+// Collects events of all threads. Recording is lock free, the registry lock is taken
+// once per thread and by the exporter. Buffers are shared between the registry and
+// their thread: events of finished threads are still exported, and reset only retires
+// the registry's references, a thread keeps writing to its buffer until it obtains a new one.
+class RuntimeTracer {
+  public:
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void enable(size_t eventsPerThread, const std::string &traceFile);
+    static void disable();
+    static void reset();
+
+    static uint64_t getTimestamp();
+    static void record(TraceCategory category, const char *name, uint64_t start, uint64_t end);
+
+    static void exportChromeTrace(std::ostream &out);
+    static bool exportChromeTrace();
+    static const char *getCategoryName(TraceCategory category);
+    static size_t getBuffersCount();
+
+  protected:
+    struct State;
+    static TraceBuffer *getThreadBuffer();
+
+    static std::atomic<bool> enabled;
+    static State *state;
+    static std::atomic<uint32_t> generation;
+};
+
+// When tracing is disabled a scope costs a relaxed load and a branch on entry and
+// a branch on the unset name on exit.
+class TraceScope {
+  public:
+    TraceScope(TraceCategory category, const char *name) {
+        if (RuntimeTracer::isEnabled()) {
+            this->name = name;
+            this->category = category;
+            start = RuntimeTracer::getTimestamp();
+        }
+    }
+
+    ~TraceScope() {
+        if (name) {
+            RuntimeTracer::record(category, name, start, RuntimeTracer::getTimestamp());
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+  protected:
+    const char *name = nullptr;
+    TraceCategory category = TraceCategory::Api;
+    uint64_t start = 0;
+};
+} // namespace OCLRT
+
+#define TRACE_SCOPE(category, name) \
+    OCLRT::TraceScope traceScopeForSingleCall(OCLRT::TraceCategory::category, name)
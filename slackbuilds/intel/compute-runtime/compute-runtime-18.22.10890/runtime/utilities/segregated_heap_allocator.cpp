@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/basic_math.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
+
+namespace OCLRT {
+
+SegregatedHeapAllocator::SegregatedHeapAllocator(uint64_t address, uint64_t size)
+    : HeapAllocator(address, size) {
+    if (size > 0) {
+        insertFreeChunk(address, size);
+    }
+}
+
+SegregatedHeapAllocator::SegregatedHeapAllocator(uint64_t address, uint64_t size, size_t threshold)
+    : HeapAllocator(address, size, threshold) {
+    if (size > 0) {
+        insertFreeChunk(address, size);
+    }
+}
+
+uint32_t SegregatedHeapAllocator::getSizeClass(uint64_t size) {
+    return static_cast<uint32_t>(Math::log2(size));
+}
+
+uint64_t SegregatedHeapAllocator::allocate(size_t &sizeToAllocate) {
+    std::lock_guard<std::mutex> lock(mtx);
+    sizeToAllocate = alignUp(sizeToAllocate, allocationAlignment);
+
+    DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
+
+    if (sizeToAllocate == 0 || availableSize < sizeToAllocate) {
+        return 0llu;
+    }
+
+    auto chunk = findFreeChunk(sizeToAllocate);
+    if (chunk == freeChunksByAddress.end()) {
+        return 0llu;
+    }
+
+    uint64_t chunkPtr = chunk->first;
+    uint64_t remainingSize = chunk->second - sizeToAllocate;
+    eraseFreeChunk(chunk);
+
+    // like the base allocator, big allocations grow from the bottom and small ones from the top
+    uint64_t ptrReturn = 0llu;
+    if (sizeToAllocate > sizeThreshold) {
+        ptrReturn = chunkPtr;
+        if (remainingSize > 0) {
+            insertFreeChunk(chunkPtr + sizeToAllocate, remainingSize);
+        }
+    } else {
+        ptrReturn = chunkPtr + remainingSize;
+        if (remainingSize > 0) {
+            insertFreeChunk(chunkPtr, remainingSize);
+        }
+    }
+
+    availableSize -= sizeToAllocate;
+    return ptrReturn;
+}
+
+void SegregatedHeapAllocator::free(uint64_t ptr, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (ptr == 0llu || size == 0) {
+        return;
+    }
+
+    DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
+
+    uint64_t chunkPtr = ptr;
+    uint64_t chunkSize = size;
+
+    auto next = freeChunksByAddress.lower_bound(ptr);
+    if (next != freeChunksByAddress.end() && next->first == ptr + size) {
+        chunkSize += next->second;
+        eraseFreeChunk(next);
+        next = freeChunksByAddress.lower_bound(ptr);
+    }
+    DEBUG_BREAK_IF(next != freeChunksByAddress.end() && next->first < ptr + size);
+
+    if (next != freeChunksByAddress.begin()) {
+        auto prev = std::prev(next);
+        DEBUG_BREAK_IF(prev->first + prev->second > ptr);
+        if (prev->first + prev->second == ptr) {
+            chunkPtr = prev->first;
+            chunkSize += prev->second;
+            eraseFreeChunk(prev);
+        }
+    }
+
+    insertFreeChunk(chunkPtr, chunkSize);
+    availableSize += size;
+}
+
+void SegregatedHeapAllocator::insertFreeChunk(uint64_t ptr, uint64_t size) {
+    auto sizeClass = getSizeClass(size);
+    freeChunksByAddress.emplace(ptr, size);
+    sizeClasses[sizeClass].emplace(size, ptr);
+    nonEmptySizeClasses |= (1ull << sizeClass);
+}
+
+void SegregatedHeapAllocator::eraseFreeChunk(FreeChunksByAddress::iterator chunk) {
+    auto sizeClass = getSizeClass(chunk->second);
+    sizeClasses[sizeClass].erase(std::make_pair(chunk->second, chunk->first));
+    if (sizeClasses[sizeClass].empty()) {
+        nonEmptySizeClasses &= ~(1ull << sizeClass);
+    }
+    freeChunksByAddress.erase(chunk);
+}
+
+SegregatedHeapAllocator::FreeChunksByAddress::iterator SegregatedHeapAllocator::findFreeChunk(uint64_t size) {
+    auto sizeClass = getSizeClass(size);
+
+    // best fit within own size class
+    auto &candidates = sizeClasses[sizeClass];
+    auto bestFit = candidates.lower_bound(std::make_pair(size, 0llu));
+    if (bestFit != candidates.end()) {
+        return freeChunksByAddress.find(bestFit->second);
+    }
+
+    // any chunk from bigger class fits, take smallest from the first non empty one
+    uint64_t biggerSizeClasses = nonEmptySizeClasses & ~((2ull << sizeClass) - 1);
+    if (biggerSizeClasses == 0) {
+        return freeChunksByAddress.end();
+    }
+
+    auto lowBits = static_cast<uint32_t>(biggerSizeClasses);
+    auto firstNonEmpty = lowBits ? Math::getMinLsbSet(lowBits) : 32 + Math::getMinLsbSet(static_cast<uint32_t>(biggerSizeClasses >> 32));
+    return freeChunksByAddress.find(sizeClasses[firstNonEmpty].begin()->second);
+}
+} // namespace OCLRT
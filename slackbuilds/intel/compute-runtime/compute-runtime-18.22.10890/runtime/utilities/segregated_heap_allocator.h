@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/heap_allocator.h"
+
+#include <map>
+#include <set>
+#include <utility>
+
+namespace OCLRT {
+
+// Free ranges are kept coalesced and binned by power-of-two size class.
+// Allocate and free cost O(log n) in number of free ranges, defragmentation is never needed.
+class SegregatedHeapAllocator : public HeapAllocator {
+  public:
+    SegregatedHeapAllocator(uint64_t address, uint64_t size);
+    SegregatedHeapAllocator(uint64_t address, uint64_t size, size_t threshold);
+
+    uint64_t allocate(size_t &sizeToAllocate) override;
+    void free(uint64_t ptr, size_t size) override;
+
+  protected:
+    static const uint32_t numSizeClasses = 64;
+    typedef std::map<uint64_t, uint64_t> FreeChunksByAddress;
+    typedef std::set<std::pair<uint64_t, uint64_t>> FreeChunksBySize;
+
+    static uint32_t getSizeClass(uint64_t size);
+
+    void insertFreeChunk(uint64_t ptr, uint64_t size);
+    void eraseFreeChunk(FreeChunksByAddress::iterator chunk);
+    FreeChunksByAddress::iterator findFreeChunk(uint64_t size);
+
+    // start address -> size
+    FreeChunksByAddress freeChunksByAddress;
+    // (size, start address) within each size class
+    FreeChunksBySize sizeClasses[numSizeClasses];
+    uint64_t nonEmptySizeClasses = 0;
+};
+} // namespace OCLRT
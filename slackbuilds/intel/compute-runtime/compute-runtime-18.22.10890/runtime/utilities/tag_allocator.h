@@ -24,9 +24,11 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/memory_manager/memory_manager.h"
-#include "runtime/utilities/idlist.h"
 
+#include <atomic>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -34,7 +36,7 @@ namespace OCLRT {
 class GraphicsAllocation;
 
 template <typename TagType>
-struct TagNode : public IDNode<TagNode<TagType>> {
+struct TagNode {
   public:
     TagType *tag;
     GraphicsAllocation *getGraphicsAllocation() {
@@ -44,27 +46,44 @@ struct TagNode : public IDNode<TagNode<TagType>> {
   protected:
     TagNode() = default;
     GraphicsAllocation *gfxAllocation;
+    std::atomic<TagNode<TagType> *> nextFree{nullptr};
+    uint32_t freeListIndex = 0;
 
     template <typename TagType2>
     friend class TagAllocator;
 };
 
+// Free tags are kept on lock-free stack shared by all threads.
+// Each thread keeps few tags of its own and moves them to/from shared stack in batches,
+// so getTag and returnTag don't touch shared state in common case.
 template <typename TagType>
 class TagAllocator {
   public:
     using NodeType = TagNode<TagType>;
+    static const uint32_t threadCacheSize = 16;
+    static const uint32_t threadCacheBatchSize = threadCacheSize / 2;
 
     TagAllocator(MemoryManager *memMngr, size_t tagCount, size_t tagAlignment) : memoryManager(memMngr),
                                                                                  tagCount(tagCount),
                                                                                  tagAlignment(tagAlignment) {
+        registerAllocator();
         populateFreeTags();
     }
 
     MOCKABLE_VIRTUAL ~TagAllocator() {
         cleanUpResources();
+        unregisterAllocator();
     }
 
     void cleanUpResources() {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        // tags cached by threads point to released pools, new id makes caches drop them
+        unregisterAllocator();
+        registerAllocator();
+        // counter keeps running, indices of released pools get reused
+        auto head = freeTagsHead.load(std::memory_order_relaxed);
+        freeTagsHead.store((head & ~nodeIndexMask) + abaCounterIncrement, std::memory_order_release);
+
         size_t size = gfxAllocations.size();
 
         for (uint32_t i = 0; i < size; ++i) {
@@ -74,39 +93,173 @@ class TagAllocator {
 
         size = tagPoolMemory.size();
         for (uint32_t i = 0; i < size; ++i) {
+            poolsByIndex[i].store(nullptr, std::memory_order_relaxed);
             delete[] tagPoolMemory[i];
         }
         tagPoolMemory.clear();
     }
 
     NodeType *getTag() {
-        NodeType *node = freeTags.removeFrontOne().release();
-        if (!node) {
-            populateFreeTags();
-            node = freeTags.removeFrontOne().release();
+        auto &threadCache = getThreadCache();
+        if (threadCache.allocatorId != allocatorId) {
+            releaseThreadCache(threadCache);
+            threadCache.allocatorId = allocatorId;
+        }
+
+        if (threadCache.count == 0) {
+            refillThreadCache(threadCache);
         }
-        usedTags.pushFrontOne(*node);
-        return node;
+        return threadCache.nodes[--threadCache.count];
     }
 
     void returnTag(NodeType *node) {
-        NodeType *usedNode = usedTags.removeOne(*node).release();
-        DEBUG_BREAK_IF(usedNode == nullptr);
-        ((void)(usedNode));
-        freeTags.pushFrontOne(*node);
+        DEBUG_BREAK_IF(node == nullptr);
+        auto &threadCache = getThreadCache();
+        if (threadCache.allocatorId != allocatorId) {
+            releaseThreadCache(threadCache);
+            threadCache.allocatorId = allocatorId;
+        }
+
+        if (threadCache.count == threadCacheSize) {
+            // oldest tags go back to shared stack, recently returned ones stay hot
+            pushFreeTags(threadCache.nodes, threadCacheBatchSize);
+            for (uint32_t i = threadCacheBatchSize; i < threadCacheSize; i++) {
+                threadCache.nodes[i - threadCacheBatchSize] = threadCache.nodes[i];
+            }
+            threadCache.count -= threadCacheBatchSize;
+        }
+        threadCache.nodes[threadCache.count++] = node;
     }
+
   protected:
-    IDList<NodeType> freeTags;
-    IDList<NodeType> usedTags;
+    struct ThreadCache {
+        ~ThreadCache() {
+            releaseThreadCache(*this);
+        }
+        uint64_t allocatorId = 0;
+        uint32_t count = 0;
+        NodeType *nodes[threadCacheSize];
+    };
+
+    struct Registry {
+        std::mutex mtx;
+        std::map<uint64_t, TagAllocator *> allocators;
+        uint64_t lastAllocatorId = 0;
+    };
+
+    // head of shared free stack, 1-based node index in low half and 32-bit ABA counter in high half
+    static const uint64_t nodeIndexMask = 0xffffffffull;
+    static const uint64_t abaCounterIncrement = nodeIndexMask + 1;
+    static const uint32_t maxPoolCount = 1024;
+    std::atomic<uint64_t> freeTagsHead{0};
+
     std::vector<GraphicsAllocation *> gfxAllocations;
     std::vector<NodeType *> tagPoolMemory;
+    // lock-free view of tagPoolMemory for resolving node indices
+    std::unique_ptr<std::atomic<NodeType *>[]> poolsByIndex{new std::atomic<NodeType *>[maxPoolCount]()};
 
     MemoryManager *memoryManager;
     size_t tagCount;
     size_t tagAlignment;
+    uint64_t allocatorId = 0;
 
     std::mutex allocationsMutex;
 
+    static Registry &getRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    static ThreadCache &getThreadCache() {
+        static thread_local ThreadCache threadCache;
+        return threadCache;
+    }
+
+    NodeType *getNode(uint64_t head) const {
+        auto nodeIndex = static_cast<uint32_t>(head & nodeIndexMask);
+        if (nodeIndex == 0) {
+            return nullptr;
+        }
+        nodeIndex--;
+        return &poolsByIndex[nodeIndex / tagCount].load(std::memory_order_relaxed)[nodeIndex % tagCount];
+    }
+
+    static NodeType *getNextFree(NodeType *node) {
+        return node->nextFree.load(std::memory_order_relaxed);
+    }
+
+    static uint64_t getNextHead(uint64_t head, NodeType *node) {
+        uint64_t nodeIndex = (node != nullptr) ? node->freeListIndex : 0;
+        return ((head & ~nodeIndexMask) + abaCounterIncrement) | nodeIndex;
+    }
+
+    static void releaseThreadCache(ThreadCache &threadCache) {
+        if (threadCache.count == 0) {
+            return;
+        }
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mtx);
+        auto it = registry.allocators.find(threadCache.allocatorId);
+        if (it != registry.allocators.end()) {
+            it->second->pushFreeTags(threadCache.nodes, threadCache.count);
+        }
+        threadCache.count = 0;
+    }
+
+    void registerAllocator() {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mtx);
+        allocatorId = ++registry.lastAllocatorId;
+        registry.allocators[allocatorId] = this;
+    }
+
+    void unregisterAllocator() {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mtx);
+        registry.allocators.erase(allocatorId);
+    }
+
+    void pushFreeTags(NodeType *firstNode, NodeType *lastNode) {
+        // acquire makes pool of head node visible before its index is resolved
+        auto head = freeTagsHead.load(std::memory_order_acquire);
+        do {
+            lastNode->nextFree.store(getNode(head), std::memory_order_relaxed);
+        } while (!freeTagsHead.compare_exchange_weak(head, getNextHead(head, firstNode), std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    void pushFreeTags(NodeType **nodes, uint32_t count) {
+        for (uint32_t i = 0; i + 1 < count; i++) {
+            nodes[i]->nextFree.store(nodes[i + 1], std::memory_order_relaxed);
+        }
+        pushFreeTags(nodes[0], nodes[count - 1]);
+    }
+
+    NodeType *popFreeTag() {
+        auto head = freeTagsHead.load(std::memory_order_acquire);
+        while (getNode(head) != nullptr) {
+            // pools outlive the stack, so node can be read even if other thread popped it meanwhile
+            auto next = getNextFree(getNode(head));
+            if (freeTagsHead.compare_exchange_weak(head, getNextHead(head, next), std::memory_order_acquire, std::memory_order_acquire)) {
+                return getNode(head);
+            }
+        }
+        return nullptr;
+    }
+
+    void refillThreadCache(ThreadCache &threadCache) {
+        while (threadCache.count < threadCacheBatchSize) {
+            auto node = popFreeTag();
+            if (node == nullptr) {
+                if (threadCache.count > 0) {
+                    break;
+                }
+                populateFreeTags();
+                continue;
+            }
+            threadCache.nodes[threadCache.count++] = node;
+        }
+    }
+
     void populateFreeTags() {
 
         size_t tagSize = sizeof(TagType);
@@ -114,6 +267,10 @@ class TagAllocator {
         size_t allocationSizeRequired = tagCount * tagSize;
 
         std::unique_lock<std::mutex> lock(allocationsMutex);
+        if (getNode(freeTagsHead.load(std::memory_order_acquire)) != nullptr) {
+            // other thread has already grown the pool
+            return;
+        }
 
         GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
         gfxAllocations.push_back(graphicsAllocation);
@@ -121,19 +278,39 @@ class TagAllocator {
         uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
         uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
         uintptr_t End = Start + Size;
-        size_t nodeCount = Size / tagSize;
+        // every pool has tagCount nodes, so node index maps to pool without a search
+        size_t nodeCount = tagCount;
+        size_t poolIndex = tagPoolMemory.size();
+        UNRECOVERABLE_IF(poolIndex >= maxPoolCount || (poolIndex + 1) * tagCount > nodeIndexMask);
 
         NodeType *nodesMemory = new NodeType[nodeCount];
 
         for (size_t i = 0; i < nodeCount; ++i) {
             nodesMemory[i].gfxAllocation = graphicsAllocation;
             nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
-            freeTags.pushTailOne(nodesMemory[i]);
+            nodesMemory[i].freeListIndex = static_cast<uint32_t>(poolIndex * tagCount + i + 1);
+            if (i + 1 < nodeCount) {
+                nodesMemory[i].nextFree.store(&nodesMemory[i + 1], std::memory_order_relaxed);
+            }
             Start += tagSize;
         }
         DEBUG_BREAK_IF(Start > End);
         ((void)(End));
         tagPoolMemory.push_back(nodesMemory);
+        poolsByIndex[poolIndex].store(nodesMemory, std::memory_order_relaxed);
+
+        pushFreeTags(nodesMemory, &nodesMemory[nodeCount - 1]);
     }
 };
+
+template <typename TagType>
+const uint32_t TagAllocator<TagType>::threadCacheSize;
+template <typename TagType>
+const uint32_t TagAllocator<TagType>::threadCacheBatchSize;
+template <typename TagType>
+const uint64_t TagAllocator<TagType>::nodeIndexMask;
+template <typename TagType>
+const uint64_t TagAllocator<TagType>::abaCounterIncrement;
+template <typename TagType>
+const uint32_t TagAllocator<TagType>::maxPoolCount;
 } // namespace OCLRT
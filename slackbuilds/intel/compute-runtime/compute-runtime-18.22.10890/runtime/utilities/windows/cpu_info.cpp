@@ -21,6 +21,7 @@
  */
 
 #include "runtime/utilities/cpu_info.h"
+#include <immintrin.h>
 #include <intrin.h>
 
 namespace OCLRT {
@@ -31,6 +32,12 @@ void cpuidex_windows_wrapper(int *cpuInfo, int functionId, int subfunctionId) {
 
 void (*CpuInfo::cpuidexFunc)(int *, int, int) = cpuidex_windows_wrapper;
 
+uint64_t xgetbv_windows_wrapper(uint32_t index) {
+    return _xgetbv(index);
+}
+
+uint64_t (*CpuInfo::xgetbvFunc)(uint32_t) = xgetbv_windows_wrapper;
+
 const CpuInfo CpuInfo::instance;
 
 void CpuInfo::cpuid(
@@ -46,4 +53,8 @@ void CpuInfo::cpuidex(
     cpuidexFunc(reinterpret_cast<int *>(cpuInfo), functionId, subfunctionId);
 }
 
+uint64_t CpuInfo::xgetbv(uint32_t index) const {
+    return xgetbvFunc(index);
+}
+
 } // namespace OCLRT
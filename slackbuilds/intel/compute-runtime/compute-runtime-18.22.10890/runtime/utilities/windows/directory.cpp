@@ -25,6 +25,24 @@
 
 namespace OCLRT {
 
+// FILETIME counts 100ns intervals since 1601
+static const uint64_t fileTimeTicksPerSecond = 10000000;
+static const uint64_t fileTimeEpochOffset = 11644473600;
+
+static uint64_t toSecondsSinceEpoch(const FILETIME &fileTime) {
+    uint64_t ticks = (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+    uint64_t seconds = ticks / fileTimeTicksPerSecond;
+    return seconds > fileTimeEpochOffset ? seconds - fileTimeEpochOffset : 0;
+}
+
+static FILETIME toFileTime(uint64_t secondsSinceEpoch) {
+    uint64_t ticks = (secondsSinceEpoch + fileTimeEpochOffset) * fileTimeTicksPerSecond;
+    FILETIME fileTime;
+    fileTime.dwLowDateTime = static_cast<DWORD>(ticks);
+    fileTime.dwHighDateTime = static_cast<DWORD>(ticks >> 32);
+    return fileTime;
+}
+
 std::vector<std::string> Directory::getFiles(std::string &path) {
     std::vector<std::string> files;
     std::string newPath;
@@ -51,4 +69,32 @@ std::vector<std::string> Directory::getFiles(std::string &path) {
     FindClose(hFind);
     return files;
 }
+
+bool Directory::getFileInfo(const std::string &path, size_t &size, uint64_t &lastModified, uint64_t &lastAccessed) {
+    WIN32_FILE_ATTRIBUTE_DATA fileData;
+    if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &fileData) == 0) {
+        return false;
+    }
+
+    size = static_cast<size_t>((static_cast<uint64_t>(fileData.nFileSizeHigh) << 32) | fileData.nFileSizeLow);
+    lastModified = toSecondsSinceEpoch(fileData.ftLastWriteTime);
+    lastAccessed = toSecondsSinceEpoch(fileData.ftLastAccessTime);
+    return true;
+}
+
+bool Directory::setFileTimes(const std::string &path, uint64_t lastModified, uint64_t lastAccessed) {
+    HANDLE hFile = CreateFileA(path.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == hFile) {
+        return false;
+    }
+
+    FILETIME lastWriteTime = toFileTime(lastModified);
+    FILETIME lastAccessTime = toFileTime(lastAccessed);
+    bool result = SetFileTime(hFile, nullptr,
+                              lastAccessed ? &lastAccessTime : nullptr,
+                              lastModified ? &lastWriteTime : nullptr) != 0;
+    CloseHandle(hFile);
+    return result;
+}
 };
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/mapped_file.h"
+#include "runtime/os_interface/windows/windows_wrapper.h"
+
+namespace OCLRT {
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::string &path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart <= 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // mapping keeps its own reference to the file
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    void *ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (ptr == nullptr) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>(new MappedFile(ptr, static_cast<size_t>(fileSize.QuadPart), mapping));
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(mappedPtr);
+    CloseHandle(osHandle);
+}
+} // namespace OCLRT
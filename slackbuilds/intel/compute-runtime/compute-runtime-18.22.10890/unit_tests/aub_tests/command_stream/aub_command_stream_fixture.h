@@ -52,13 +52,13 @@ class AUBCommandStreamFixture : public CommandStreamFixture {
 
         // Write our pseudo-op to the AUB file
         auto aubCsr = reinterpret_cast<AUBCommandStreamReceiverHw<FamilyType> *>(pCommandStreamReceiver);
-        aubCsr->stream->fileHandle.write(reinterpret_cast<char *>(&header), sizeof(header));
+        aubCsr->stream->write(reinterpret_cast<char *>(&header), sizeof(header));
     }
 
     template <typename FamilyType>
     void expectMemory(void *gfxAddress, const void *srcAddress, size_t length) {
         auto aubCsr = reinterpret_cast<AUBCommandStreamReceiverHw<FamilyType> *>(pCommandStreamReceiver);
-        PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
             if (offset > length)
                 abort();
 
@@ -67,7 +67,7 @@ class AUBCommandStreamFixture : public CommandStreamFixture {
                                          size);
         };
 
-        aubCsr->ppgtt.pageWalk(reinterpret_cast<uintptr_t>(gfxAddress), length, 0, walker);
+        aubCsr->ppgtt.pageWalkRanges(reinterpret_cast<uintptr_t>(gfxAddress), length, 0, walker);
     }
 
     CommandStreamReceiver *pCommandStreamReceiver = nullptr;
@@ -35,6 +35,7 @@
 #include "unit_tests/fixtures/image_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/fixtures/buffer_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/libult/ult_command_stream_receiver.h"
 #include "unit_tests/mocks/mock_memory_manager.h"
 #include "unit_tests/mocks/mock_command_queue.h"
@@ -386,6 +387,30 @@ TEST_F(CommandQueueCommandStreamTest, CommandQueueWhenAskedForNewCommandStreamSt
     EXPECT_TRUE(memoryManager->allocationsForReuse.peekContains(*graphicsAllocation));
 }
 
+HWTEST_F(CommandQueueCommandStreamTest, givenRingBufferReuseWhenCommandStreamIsExhaustedThenItWrapsInSameAllocation) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.ringBufferReuseEnabled = true;
+    CommandQueue cmdQ(context.get(), pDevice, 0);
+
+    auto &commandStream = cmdQ.getCS(100);
+    auto graphicsAllocation = commandStream.getGraphicsAllocation();
+    auto ringTracker = cmdQ.getCommandStreamRingTracker();
+    ASSERT_NE(nullptr, ringTracker);
+    EXPECT_EQ(ringTracker, commandStream.getRingTracker());
+    EXPECT_EQ(CSRequirements::minCommandQueueRingSize - CSRequirements::minCommandQueueCommandStreamSize, commandStream.getMaxAvailableSpace());
+
+    commandStream.getSpace(commandStream.getAvailableSpace() - 100);
+    ringTracker->registerSubmission(commandStream.getUsed(), 1);
+    commandStreamReceiver.latestFlushedTaskCount = 1;
+    *commandStreamReceiver.getTagAddress() = 1;
+
+    auto &wrappedCommandStream = cmdQ.getCS(100);
+    EXPECT_EQ(graphicsAllocation, wrappedCommandStream.getGraphicsAllocation());
+    EXPECT_EQ(0u, wrappedCommandStream.getUsed());
+    EXPECT_EQ(1u, ringTracker->peekWrapCount());
+    EXPECT_FALSE(pDevice->getMemoryManager()->allocationsForReuse.peekContains(*graphicsAllocation));
+}
+
 TEST_F(CommandQueueCommandStreamTest, givenCommandQueueWhenGetCSIsCalledThenCommandStreamAllocationTypeShouldBeSetToLinearStream) {
     const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
     CommandQueue cmdQ(context.get(), pDevice, props);
@@ -668,6 +693,36 @@ TEST_P(CommandQueueIndirectHeapTest, givenCommandQueueWhenGetHeapMemoryIsCalledW
     pDevice->getMemoryManager()->freeGraphicsMemory(indirectHeap->getGraphicsAllocation());
 }
 
+TEST_P(CommandQueueIndirectHeapTest, givenParallelCommandRecordingWhenGetIndirectHeapIsCalledThenHeapIsOwnedByQueue) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+    MockCommandQueue cmdQ(context.get(), pDevice, 0);
+    EXPECT_TRUE(cmdQ.peekOwnsIndirectHeaps());
+
+    const auto &indirectHeap = cmdQ.getIndirectHeap(this->GetParam(), 100);
+    EXPECT_NE(nullptr, indirectHeap.getGraphicsAllocation());
+
+    auto &csr = pDevice->getUltCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME>();
+    EXPECT_EQ(nullptr, csr.indirectHeap[this->GetParam()]);
+
+    cmdQ.releaseIndirectHeap(this->GetParam());
+    EXPECT_EQ(nullptr, indirectHeap.getGraphicsAllocation());
+    EXPECT_FALSE(pDevice->getMemoryManager()->allocationsForReuse.peekIsEmpty());
+}
+
+TEST_P(CommandQueueIndirectHeapTest, givenParallelCommandRecordingWhenQueueIsDestroyedThenOwnedHeapIsPutOnReuseList) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+    auto cmdQ = new CommandQueue(context.get(), pDevice, 0);
+    auto memoryManager = pDevice->getMemoryManager();
+
+    auto allocation = cmdQ->getIndirectHeap(this->GetParam(), 100).getGraphicsAllocation();
+    EXPECT_TRUE(memoryManager->allocationsForReuse.peekIsEmpty());
+
+    delete cmdQ;
+    EXPECT_TRUE(memoryManager->allocationsForReuse.peekContains(*allocation));
+}
+
 INSTANTIATE_TEST_CASE_P(
     Device,
     CommandQueueIndirectHeapTest,
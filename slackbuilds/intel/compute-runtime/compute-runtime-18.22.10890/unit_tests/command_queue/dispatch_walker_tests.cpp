@@ -777,6 +777,32 @@ HWTEST_F(DispatchWalkerTest, dispatchWalkerWithMultipleDispatchInfo) {
     }
 }
 
+HWTEST_F(DispatchWalkerTest, givenMultipleDispatchInfoWhenDispatchWalkerIsCalledThenCommandsFitInTotalSizeRequiredCS) {
+    MockKernel kernel1(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel1.initialize());
+    MockKernel kernel2(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel2.initialize());
+
+    MockMultiDispatchInfo multiDispatchInfo(std::vector<Kernel *>({&kernel1, &kernel2}));
+    auto &commandStream = pCmdQ->getCS(1024);
+    auto usedBefore = commandStream.getUsed();
+
+    GpgpuWalkerHelper<FamilyType>::dispatchWalker(
+        *pCmdQ,
+        multiDispatchInfo,
+        0,
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        pDevice->getPreemptionMode(),
+        false);
+
+    EXPECT_FALSE(commandStream.isSpaceReserved());
+    auto expectedSizeCS = EnqueueOperation<FamilyType>::getTotalSizeRequiredCS(false, false, *pCmdQ, multiDispatchInfo);
+    EXPECT_GE(expectedSizeCS, commandStream.getUsed() - usedBefore);
+}
+
 HWCMDTEST_F(IGFX_GEN8_CORE, DispatchWalkerTest, dispatchWalkerWithMultipleDispatchInfoCorrectlyProgramsInterfaceDesriptors) {
     using INTERFACE_DESCRIPTOR_DATA = typename FamilyType::INTERFACE_DESCRIPTOR_DATA;
 
@@ -1041,6 +1067,104 @@ HWCMDTEST_F(IGFX_GEN8_CORE, DispatchWalkerTest, givenMultiDispatchWhenWhiteliste
     }
 }
 
+HWCMDTEST_F(IGFX_GEN8_CORE, DispatchWalkerTest, givenKernelDispatchedAgainWithSameGeometryWhenWalkerIsProgrammedThenRecordedTemplateIsReplayedWithPatchedOffsets) {
+    using GPGPU_WALKER = typename FamilyType::GPGPU_WALKER;
+    DebugManagerStateRestore dbgRestore;
+
+    MockKernel kernel(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+
+    size_t globalOffsets[3] = {0, 0, 0};
+    size_t workItems[3] = {256, 1, 1};
+    size_t localWorkSize[3] = {32, 1, 1};
+    auto &cmdStream = pCmdQ->getCS(0);
+
+    auto dispatch = [&]() {
+        GpgpuWalkerHelper<FamilyType>::dispatchWalker(
+            *pCmdQ,
+            kernel,
+            1,
+            globalOffsets,
+            workItems,
+            localWorkSize,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            pDevice->getPreemptionMode(),
+            false);
+    };
+
+    DebugManager.flags.DisableDispatchTemplates.set(true);
+    dispatch();
+    EXPECT_FALSE(kernel.getDispatchTemplates().walker.peekRecorded());
+    EXPECT_FALSE(kernel.getDispatchTemplates().interfaceDescriptor.peekRecorded());
+
+    DebugManager.flags.DisableDispatchTemplates.set(false);
+    dispatch();
+    EXPECT_TRUE(kernel.getDispatchTemplates().walker.peekRecorded());
+    EXPECT_TRUE(kernel.getDispatchTemplates().interfaceDescriptor.peekRecorded());
+    dispatch();
+
+    HardwareParse hwParser;
+    hwParser.parseCommands<FamilyType>(cmdStream, 0);
+    std::vector<GPGPU_WALKER *> walkers;
+    for (auto walkerItor = find<GPGPU_WALKER *>(hwParser.cmdList.begin(), hwParser.cmdList.end()); walkerItor != hwParser.cmdList.end();
+         walkerItor = find<GPGPU_WALKER *>(++walkerItor, hwParser.cmdList.end())) {
+        walkers.push_back(genCmdCast<GPGPU_WALKER *>(*walkerItor));
+    }
+    ASSERT_EQ(3u, walkers.size());
+
+    auto referenceWalker = walkers[0];
+    auto replayedWalker = *walkers[2];
+    EXPECT_NE(referenceWalker->getIndirectDataStartAddress(), replayedWalker.getIndirectDataStartAddress());
+
+    replayedWalker.setIndirectDataStartAddress(referenceWalker->getIndirectDataStartAddress());
+    EXPECT_EQ(0, memcmp(referenceWalker, &replayedWalker, sizeof(GPGPU_WALKER)));
+}
+
+HWCMDTEST_F(IGFX_GEN8_CORE, DispatchWalkerTest, givenRecordedTemplateWhenKernelIsDispatchedWithDifferentLocalWorkSizeThenWalkerIsProgrammedFromScratch) {
+    using GPGPU_WALKER = typename FamilyType::GPGPU_WALKER;
+
+    MockKernel kernel(&program, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+
+    size_t globalOffsets[3] = {0, 0, 0};
+    size_t workItems[3] = {256, 1, 1};
+    size_t localWorkSizes[2][3] = {{32, 1, 1}, {16, 1, 1}};
+    auto &cmdStream = pCmdQ->getCS(0);
+
+    for (auto &localWorkSize : localWorkSizes) {
+        GpgpuWalkerHelper<FamilyType>::dispatchWalker(
+            *pCmdQ,
+            kernel,
+            1,
+            globalOffsets,
+            workItems,
+            localWorkSize,
+            0,
+            nullptr,
+            nullptr,
+            nullptr,
+            nullptr,
+            pDevice->getPreemptionMode(),
+            false);
+    }
+
+    HardwareParse hwParser;
+    hwParser.parseCommands<FamilyType>(cmdStream, 0);
+    std::vector<GPGPU_WALKER *> walkers;
+    for (auto walkerItor = find<GPGPU_WALKER *>(hwParser.cmdList.begin(), hwParser.cmdList.end()); walkerItor != hwParser.cmdList.end();
+         walkerItor = find<GPGPU_WALKER *>(++walkerItor, hwParser.cmdList.end())) {
+        walkers.push_back(genCmdCast<GPGPU_WALKER *>(*walkerItor));
+    }
+    ASSERT_EQ(2u, walkers.size());
+
+    EXPECT_EQ(8u, walkers[0]->getThreadGroupIdXDimension());
+    EXPECT_EQ(16u, walkers[1]->getThreadGroupIdXDimension());
+}
+
 TEST(DispatchWalker, calculateDispatchDim) {
     Vec3<size_t> dim0{0, 0, 0};
     Vec3<size_t> dim1{2, 1, 1};
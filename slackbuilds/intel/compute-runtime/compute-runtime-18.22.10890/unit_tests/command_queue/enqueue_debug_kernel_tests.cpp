@@ -25,6 +25,7 @@
 #include "runtime/program/program.h"
 #include "runtime/source_level_debugger/source_level_debugger.h"
 #include "unit_tests/fixtures/enqueue_handler_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/kernel_binary_helper.h"
 #include "unit_tests/helpers/kernel_filename_helper.h"
 #include "unit_tests/mocks/mock_buffer.h"
@@ -160,3 +161,26 @@ HWTEST_F(EnqueueDebugKernelSimpleTest, givenKernelFromProgramWithoutDebugEnabled
 
     ::testing::Mock::VerifyAndClearExpectations(mockCmdQ.get());
 }
+
+HWTEST_F(EnqueueDebugKernelSimpleTest, givenParallelCommandRecordingAndKernelWithDebugEnabledWhenEnqueuedThenDebugSurfaceIsSetupUnderDeviceOwnership) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+
+    MockProgram program;
+    program.enableKernelDebug();
+    std::unique_ptr<MockDebugKernel> kernel(MockKernel::create<MockDebugKernel>(*pDevice, &program));
+    std::unique_ptr<GMockCommandQueueHw<FamilyType>> mockCmdQ(new GMockCommandQueueHw<FamilyType>(context, pDevice, 0));
+    EXPECT_TRUE(mockCmdQ->peekOwnsIndirectHeaps());
+
+    bool deviceOwnedWhileSettingUp = false;
+    EXPECT_CALL(*mockCmdQ.get(), setupDebugSurface(kernel.get())).Times(1).WillOnce(Invoke([&](Kernel *kernel) {
+        deviceOwnedWhileSettingUp = pDevice->hasOwnership();
+        return true;
+    }));
+
+    size_t gws[] = {1, 1, 1};
+    mockCmdQ->enqueueKernel(kernel.get(), 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+
+    EXPECT_TRUE(deviceOwnedWhileSettingUp);
+    ::testing::Mock::VerifyAndClearExpectations(mockCmdQ.get());
+}
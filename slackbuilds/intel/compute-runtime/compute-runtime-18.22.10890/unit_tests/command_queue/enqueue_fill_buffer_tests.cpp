@@ -393,46 +393,27 @@ HWCMDTEST_F(IGFX_GEN8_CORE, EnqueueFillBufferCmdTests, argumentTwoShouldMatchPat
 }
 
 HWTEST_F(EnqueueFillBufferCmdTests, patternShouldBeCopied) {
-    MemoryManager *mmgr = pCmdQ->getDevice().getMemoryManager();
-    ASSERT_TRUE(mmgr->graphicsAllocations.peekIsEmpty());
+    auto &fillPatternPool = pCmdQ->getFillPatternPool();
     EnqueueFillBufferHelper<>::enqueueFillBuffer(pCmdQ, buffer);
-    ASSERT_FALSE(mmgr->graphicsAllocations.peekIsEmpty());
-    GraphicsAllocation *allocation = mmgr->graphicsAllocations.peekHead();
-
-    while (allocation != nullptr) {
-        if ((allocation->getUnderlyingBufferSize() >= sizeof(float)) &&
-            (allocation->getUnderlyingBuffer() != nullptr) &&
-            (*(static_cast<float *>(allocation->getUnderlyingBuffer())) == EnqueueFillBufferHelper<>::Traits::pattern[0]) &&
-            (pCmdQ->taskCount == allocation->taskCount)) {
-            break;
-        }
-        allocation = allocation->next;
-    }
-
+    GraphicsAllocation *allocation = fillPatternPool.peekAllocation();
     ASSERT_NE(nullptr, allocation);
+
+    EXPECT_EQ(EnqueueFillBufferHelper<>::Traits::pattern[0], *(static_cast<float *>(allocation->getUnderlyingBuffer())));
+    EXPECT_EQ(pCmdQ->taskCount, fillPatternPool.peekSlotTaskCount(0));
     EXPECT_NE(&EnqueueFillBufferHelper<>::Traits::pattern[0], allocation->getUnderlyingBuffer());
 }
 
 HWTEST_F(EnqueueFillBufferCmdTests, patternShouldBeAligned) {
-    MemoryManager *mmgr = pCmdQ->getDevice().getMemoryManager();
-    ASSERT_TRUE(mmgr->graphicsAllocations.peekIsEmpty());
+    auto &fillPatternPool = pCmdQ->getFillPatternPool();
     EnqueueFillBufferHelper<>::enqueueFillBuffer(pCmdQ, buffer);
-    ASSERT_FALSE(mmgr->graphicsAllocations.peekIsEmpty());
-    GraphicsAllocation *allocation = mmgr->graphicsAllocations.peekHead();
-
-    while (allocation != nullptr) {
-        if ((allocation->getUnderlyingBufferSize() >= sizeof(float)) &&
-            (allocation->getUnderlyingBuffer() != nullptr) &&
-            (*(static_cast<float *>(allocation->getUnderlyingBuffer())) == EnqueueFillBufferHelper<>::Traits::pattern[0]) &&
-            (pCmdQ->taskCount == allocation->taskCount)) {
-            break;
-        }
-        allocation = allocation->next;
-    }
-
+    EnqueueFillBufferHelper<>::enqueueFillBuffer(pCmdQ, buffer);
+    GraphicsAllocation *allocation = fillPatternPool.peekAllocation();
     ASSERT_NE(nullptr, allocation);
+
+    auto secondPattern = ptrOffset(allocation->getUnderlyingBuffer(), FillPatternPool::slotSize);
+    EXPECT_EQ(EnqueueFillBufferHelper<>::Traits::pattern[0], *(static_cast<float *>(secondPattern)));
     EXPECT_EQ(alignUp(allocation->getUnderlyingBuffer(), MemoryConstants::cacheLineSize), allocation->getUnderlyingBuffer());
-    EXPECT_EQ(alignUp(allocation->getUnderlyingBufferSize(), MemoryConstants::cacheLineSize), allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(alignUp(secondPattern, MemoryConstants::cacheLineSize), secondPattern);
 }
 
 HWTEST_F(EnqueueFillBufferCmdTests, patternOfSizeOneByteShouldGetPreparedForMiddleKernel) {
@@ -460,9 +441,9 @@ HWTEST_F(EnqueueFillBufferCmdTests, patternOfSizeOneByteShouldGetPreparedForMidd
     ASSERT_EQ(CL_SUCCESS, retVal);
 
     ASSERT_TRUE(mmgr->allocationsForReuse.peekIsEmpty());
-    ASSERT_FALSE(mmgr->graphicsAllocations.peekIsEmpty());
+    ASSERT_TRUE(mmgr->graphicsAllocations.peekIsEmpty());
 
-    GraphicsAllocation *allocation = mmgr->graphicsAllocations.peekHead();
+    GraphicsAllocation *allocation = pCmdQ->getFillPatternPool().peekAllocation();
     ASSERT_NE(nullptr, allocation);
 
     EXPECT_EQ(0, memcmp(allocation->getUnderlyingBuffer(), output, size));
@@ -493,9 +474,9 @@ HWTEST_F(EnqueueFillBufferCmdTests, patternOfSizeTwoBytesShouldGetPreparedForMid
     ASSERT_EQ(CL_SUCCESS, retVal);
 
     ASSERT_TRUE(mmgr->allocationsForReuse.peekIsEmpty());
-    ASSERT_FALSE(mmgr->graphicsAllocations.peekIsEmpty());
+    ASSERT_TRUE(mmgr->graphicsAllocations.peekIsEmpty());
 
-    GraphicsAllocation *allocation = mmgr->graphicsAllocations.peekHead();
+    GraphicsAllocation *allocation = pCmdQ->getFillPatternPool().peekAllocation();
     ASSERT_NE(nullptr, allocation);
 
     EXPECT_EQ(0, memcmp(allocation->getUnderlyingBuffer(), output, size));
@@ -523,9 +504,9 @@ HWTEST_F(EnqueueFillBufferCmdTests, givenEnqueueFillBufferWhenPatternAllocationI
         nullptr);
     ASSERT_EQ(CL_SUCCESS, retVal);
 
-    ASSERT_FALSE(mmgr->graphicsAllocations.peekIsEmpty());
+    ASSERT_TRUE(mmgr->graphicsAllocations.peekIsEmpty());
 
-    GraphicsAllocation *patternAllocation = mmgr->graphicsAllocations.peekHead();
+    GraphicsAllocation *patternAllocation = pCmdQ->getFillPatternPool().peekAllocation();
     ASSERT_NE(nullptr, patternAllocation);
 
     EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, patternAllocation->getAllocationType());
@@ -32,6 +32,9 @@
 
 #include "test.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace OCLRT;
 
 HWTEST_F(EnqueueHandlerTest, enqueueHandlerWithKernelCallsProcessEvictionOnCSR) {
@@ -304,3 +307,88 @@ HWTEST_F(EnqueueHandlerTest, givenExternallySynchronizedParentEventWhenRequestin
     ouputEvent->release();
     mockCmdQ->release();
 }
+
+HWTEST_F(EnqueueHandlerTest, givenParallelCommandRecordingWhenDeviceIsOwnedByOtherThreadThenKernelIsRecordedBeforeDeviceIsReleased) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+
+    struct RecordingCommandQueue : public MockCommandQueueHw<FamilyType> {
+        RecordingCommandQueue(Context *context, Device *device) : MockCommandQueueHw<FamilyType>(context, device, 0) {}
+        void enqueueHandlerHook(const unsigned int commandType, const MultiDispatchInfo &dispatchInfo) override {
+            recorded = true;
+        }
+        std::atomic<bool> recorded{false};
+    };
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    auto mockCmdQ = std::unique_ptr<RecordingCommandQueue>(new RecordingCommandQueue(context, pDevice));
+    EXPECT_TRUE(mockCmdQ->peekOwnsIndirectHeaps());
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+
+    std::atomic<bool> deviceOwned{false};
+    uint32_t taskCountWhileRecorded = 0;
+    std::thread deviceOwner([&]() {
+        TakeOwnershipWrapper<Device> deviceOwnership(*pDevice);
+        deviceOwned = true;
+        while (!mockCmdQ->recorded)
+            ;
+        taskCountWhileRecorded = csr.peekTaskCount();
+    });
+    while (!deviceOwned)
+        ;
+
+    size_t gws[] = {1, 1, 1};
+    mockCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    deviceOwner.join();
+
+    EXPECT_EQ(0u, taskCountWhileRecorded);
+    EXPECT_EQ(1u, csr.peekTaskCount());
+    EXPECT_EQ(nullptr, csr.indirectHeap[IndirectHeap::INDIRECT_OBJECT]);
+    EXPECT_NE(0u, mockCmdQ->getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 0u).getUsed());
+}
+
+HWTEST_F(EnqueueHandlerTest, givenParallelCommandRecordingWhenKernelIsRecordedThenKernelIsOwnedUntilRecordingEnds) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+
+    struct RecordingCommandQueue : public MockCommandQueueHw<FamilyType> {
+        RecordingCommandQueue(Context *context, Device *device) : MockCommandQueueHw<FamilyType>(context, device, 0) {}
+        void enqueueHandlerHook(const unsigned int commandType, const MultiDispatchInfo &dispatchInfo) override {
+            kernelOwnedWhileRecording = dispatchInfo.begin()->getKernel()->hasOwnership();
+        }
+        bool kernelOwnedWhileRecording = false;
+    };
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    auto mockCmdQ = std::unique_ptr<RecordingCommandQueue>(new RecordingCommandQueue(context, pDevice));
+
+    size_t gws[] = {1, 1, 1};
+    mockCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+
+    EXPECT_TRUE(mockCmdQ->kernelOwnedWhileRecording);
+    EXPECT_FALSE(mockKernel.mockKernel->hasOwnership());
+}
+
+HWTEST_F(EnqueueHandlerTest, givenParallelCommandRecordingWhenEnqueueIsBlockedByUserEventThenCommandIsSubmittedOnUnblock) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableParallelCommandRecording.set(true);
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    auto mockCmdQ = std::unique_ptr<MockCommandQueueHw<FamilyType>>(new MockCommandQueueHw<FamilyType>(context, pDevice, 0));
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+
+    auto userEvent = clCreateUserEvent(context, nullptr);
+    size_t gws[] = {1, 1, 1};
+    mockCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 1, &userEvent, nullptr);
+    EXPECT_TRUE(mockCmdQ->isQueueBlocked());
+    EXPECT_EQ(0u, csr.peekTaskCount());
+
+    clSetUserEventStatus(userEvent, CL_COMPLETE);
+    EXPECT_FALSE(mockCmdQ->isQueueBlocked());
+    EXPECT_EQ(1u, csr.peekTaskCount());
+
+    mockCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(2u, csr.peekTaskCount());
+
+    clReleaseEvent(userEvent);
+}
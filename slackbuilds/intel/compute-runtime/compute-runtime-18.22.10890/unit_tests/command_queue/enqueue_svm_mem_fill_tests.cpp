@@ -69,8 +69,9 @@ HWTEST_P(EnqueueSvmMemFillTest, givenEnqueueSVMMemFillWhenUsingFillBufferBuilder
         }
         void validateInput(const BuiltinOpParams &conf) const override {
             auto patternAllocation = conf.srcMemObj->getGraphicsAllocation();
-            EXPECT_EQ(patternSize, patternAllocation->getUnderlyingBufferSize());
-            EXPECT_EQ(0, memcmp(pattern, patternAllocation->getUnderlyingBuffer(), patternSize));
+            EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, patternAllocation->getAllocationType());
+            EXPECT_EQ(alignUp(patternSize, 4), conf.srcMemObj->getSize());
+            EXPECT_EQ(0, memcmp(pattern, conf.srcMemObj->getCpuAddress(), patternSize));
         };
         const void *pattern;
         size_t patternSize;
@@ -455,12 +455,36 @@ TEST_F(EnqueueSvmTest, givenEnqueueSVMMemFillWhenPatternAllocationIsObtainedThen
         nullptr);
     EXPECT_EQ(CL_SUCCESS, retVal);
 
-    ASSERT_FALSE(mmgr->allocationsForReuse.peekIsEmpty());
+    ASSERT_TRUE(mmgr->allocationsForReuse.peekIsEmpty());
 
-    GraphicsAllocation *patternAllocation = mmgr->allocationsForReuse.peekHead();
+    GraphicsAllocation *patternAllocation = pCmdQ->getFillPatternPool().peekAllocation();
     ASSERT_NE(nullptr, patternAllocation);
 
     EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, patternAllocation->getAllocationType());
+    EXPECT_EQ(0, memcmp(patternAllocation->getUnderlyingBuffer(), pattern, patternSize));
+}
+
+TEST_F(EnqueueSvmTest, givenPatternLargerThanFillPatternSlotWhenSVMMemFillIsEnqueuedThenReusableAllocationIsUsed) {
+    MemoryManager *mmgr = pCmdQ->getDevice().getMemoryManager();
+    ASSERT_TRUE(mmgr->allocationsForReuse.peekIsEmpty());
+
+    const uint8_t pattern[2 * FillPatternPool::slotSize] = {};
+    const size_t patternSize = sizeof(pattern);
+    retVal = this->pCmdQ->enqueueSVMMemFill(
+        ptrSVM,
+        pattern,
+        patternSize,
+        patternSize,
+        0,
+        nullptr,
+        nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(nullptr, pCmdQ->getFillPatternPool().peekAllocation());
+    ASSERT_FALSE(mmgr->allocationsForReuse.peekIsEmpty());
+    auto allocation = mmgr->allocationsForReuse.getBucket(0).peekHead();
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, allocation->getAllocationType());
 }
 
 TEST_F(EnqueueSvmTest, enqueueTaskWithKernelExecInfo_success) {
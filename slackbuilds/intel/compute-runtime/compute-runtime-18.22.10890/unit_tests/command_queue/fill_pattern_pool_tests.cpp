@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/fill_pattern_pool.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+struct FillPatternPoolTest : public ::testing::Test {
+    OsAgnosticMemoryManager memoryManager;
+};
+
+TEST_F(FillPatternPoolTest, givenEmptyPoolWhenSlotIsObtainedThenAllocationIsCreatedAndFirstSlotIsReturned) {
+    FillPatternPool pool;
+    EXPECT_EQ(nullptr, pool.peekAllocation());
+
+    auto slot = pool.obtainSlot(memoryManager, 4, 0);
+    ASSERT_NE(nullptr, pool.peekAllocation());
+    EXPECT_EQ(pool.peekAllocation()->getUnderlyingBuffer(), slot);
+    EXPECT_EQ(FillPatternPool::slotsCount * FillPatternPool::slotSize, pool.peekAllocation()->getUnderlyingBufferSize());
+    EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, pool.peekAllocation()->getAllocationType());
+    EXPECT_EQ(FillPatternPool::slotInUse, pool.peekSlotTaskCount(0));
+
+    pool.releaseSlot(slot, 1);
+    EXPECT_EQ(1u, pool.peekSlotTaskCount(0));
+}
+
+TEST_F(FillPatternPoolTest, givenPatternLargerThanSlotWhenSlotIsObtainedThenNullptrIsReturned) {
+    FillPatternPool pool;
+    EXPECT_EQ(nullptr, pool.obtainSlot(memoryManager, FillPatternPool::slotSize + 1, 0));
+    EXPECT_EQ(nullptr, pool.peekAllocation());
+}
+
+TEST_F(FillPatternPoolTest, givenCompletedSlotsWhenSlotsAreObtainedThenTheyAreReusedInOrder) {
+    FillPatternPool pool;
+    auto base = pool.obtainSlot(memoryManager, 4, 0);
+    pool.releaseSlot(base, 1);
+
+    for (uint32_t i = 1; i < FillPatternPool::slotsCount; i++) {
+        auto slot = pool.obtainSlot(memoryManager, 4, 0);
+        EXPECT_EQ(ptrOffset(base, i * FillPatternPool::slotSize), slot);
+        pool.releaseSlot(slot, i + 1);
+    }
+
+    EXPECT_EQ(base, pool.obtainSlot(memoryManager, 4, 1));
+}
+
+TEST_F(FillPatternPoolTest, givenSlotStillUsedByGpuWhenItIsNextInRingThenNullptrIsReturnedAndRingDoesNotAdvance) {
+    FillPatternPool pool;
+    for (uint32_t i = 0; i < FillPatternPool::slotsCount; i++) {
+        pool.releaseSlot(pool.obtainSlot(memoryManager, 4, 0), 10);
+    }
+
+    EXPECT_EQ(nullptr, pool.obtainSlot(memoryManager, 4, 9));
+    EXPECT_EQ(10u, pool.peekSlotTaskCount(0));
+
+    auto slot = pool.obtainSlot(memoryManager, 4, 10);
+    EXPECT_EQ(pool.peekAllocation()->getUnderlyingBuffer(), slot);
+    pool.releaseSlot(slot, 11);
+}
+
+TEST_F(FillPatternPoolTest, givenObtainedSlotWhenItIsNotReleasedThenItIsNotHandedOutAgain) {
+    FillPatternPool pool;
+    auto slot = pool.obtainSlot(memoryManager, 4, 0);
+    for (uint32_t i = 1; i < FillPatternPool::slotsCount; i++) {
+        pool.releaseSlot(pool.obtainSlot(memoryManager, 4, 0), 0);
+    }
+
+    EXPECT_EQ(nullptr, pool.obtainSlot(memoryManager, 4, 0xFFFFFFFEu));
+    pool.releaseSlot(slot, 0);
+}
+
+TEST_F(FillPatternPoolTest, givenPoolWithAllocationWhenDestroyedThenAllocationIsStoredAsTemporaryWithLastTaskCount) {
+    {
+        FillPatternPool pool;
+        pool.releaseSlot(pool.obtainSlot(memoryManager, 4, 0), 7);
+        pool.releaseSlot(pool.obtainSlot(memoryManager, 4, 0), 5);
+    }
+    ASSERT_FALSE(memoryManager.graphicsAllocations.peekIsEmpty());
+    auto allocation = memoryManager.graphicsAllocations.peekHead();
+    EXPECT_EQ(GraphicsAllocation::ALLOCATION_TYPE_FILL_PATTERN, allocation->getAllocationType());
+    EXPECT_EQ(7u, allocation->taskCount);
+
+    memoryManager.cleanAllocationList(7, TEMPORARY_ALLOCATION);
+    EXPECT_TRUE(memoryManager.graphicsAllocations.peekIsEmpty());
+}
+
+TEST_F(FillPatternPoolTest, givenSlotNotReleasedWhenPoolIsDestroyedThenAllocationIsStoredWithLastReleasedTaskCount) {
+    {
+        FillPatternPool pool;
+        pool.releaseSlot(pool.obtainSlot(memoryManager, 4, 0), 3);
+        pool.obtainSlot(memoryManager, 4, 0);
+        EXPECT_EQ(FillPatternPool::slotInUse, pool.peekSlotTaskCount(1));
+    }
+    ASSERT_FALSE(memoryManager.graphicsAllocations.peekIsEmpty());
+    EXPECT_EQ(3u, memoryManager.graphicsAllocations.peekHead()->taskCount);
+
+    memoryManager.cleanAllocationList(3, TEMPORARY_ALLOCATION);
+    EXPECT_TRUE(memoryManager.graphicsAllocations.peekIsEmpty());
+}
+
+TEST(FillPatternPoolWritePatternTest, givenOneAndTwoBytePatternsWhenWrittenThenTheyAreReplicatedToDword) {
+    uint8_t storage[4] = {};
+    const uint8_t bytePattern = 0x5A;
+    FillPatternPool::writePattern(storage, &bytePattern, sizeof(bytePattern));
+    const uint8_t expectedBytes[4] = {0x5A, 0x5A, 0x5A, 0x5A};
+    EXPECT_EQ(0, memcmp(expectedBytes, storage, sizeof(storage)));
+
+    const uint16_t wordPattern = 0x1234;
+    FillPatternPool::writePattern(storage, &wordPattern, sizeof(wordPattern));
+    const uint16_t expectedWords[2] = {0x1234, 0x1234};
+    EXPECT_EQ(0, memcmp(expectedWords, storage, sizeof(storage)));
+
+    const uint32_t dwordPattern = 0xCAFEBABE;
+    FillPatternPool::writePattern(storage, &dwordPattern, sizeof(dwordPattern));
+    EXPECT_EQ(0, memcmp(&dwordPattern, storage, sizeof(storage)));
+}
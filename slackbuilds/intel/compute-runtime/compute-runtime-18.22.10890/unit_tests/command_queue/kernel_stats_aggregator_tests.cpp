@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/kernel_stats_aggregator.h"
+#include "runtime/event/event.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/program/kernel_info.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "test.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+
+using namespace OCLRT;
+
+class ControlledOSTime : public OSTime {
+  public:
+    bool getCpuGpuTime(TimeStampData *pGpuCpuTime) override {
+        *pGpuCpuTime = cpuGpuTime;
+        return true;
+    }
+    bool getCpuTime(uint64_t *timeStamp) override {
+        *timeStamp = cpuTime;
+        return true;
+    }
+    double getHostTimerResolution() const override {
+        return 0;
+    }
+    double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const override {
+        return 0;
+    }
+    uint64_t getCpuRawTimestamp() override {
+        return 0;
+    }
+
+    TimeStampData cpuGpuTime = {};
+    uint64_t cpuTime = 0;
+};
+
+struct KernelStatsAggregatorTest : public ::testing::Test {
+    void SetUp() override {
+        kernelInfoA.name = "kernelA";
+        kernelInfoB.name = "kernelB";
+        aggregator.reset(new KernelStatsAggregator(&memoryManager, &osTime, timerResolution, deviceId, ""));
+    }
+
+    // queued at cpu 10000 ns with gpu at 1000 ticks, submitted at cpu 10300 ns
+    KernelStatsAggregator::Measurement *dispatch(const KernelInfo &kernelInfo, uint64_t globalStart, uint64_t contextStart, uint64_t contextEnd) {
+        osTime.cpuGpuTime = {1000, 10000};
+        auto measurement = aggregator->obtainMeasurement(kernelInfo);
+        EXPECT_NE(nullptr, measurement);
+        osTime.cpuTime = 10300;
+        aggregator->setSubmitted(measurement);
+        measurement->timeStamps->tag->GlobalStartTS = globalStart;
+        measurement->timeStamps->tag->ContextStartTS = contextStart;
+        measurement->timeStamps->tag->ContextEndTS = contextEnd;
+        return measurement;
+    }
+
+    const uint32_t deviceId = 0x1912;
+    const double timerResolution = 2.0;
+    OsAgnosticMemoryManager memoryManager;
+    ControlledOSTime osTime;
+    KernelInfo kernelInfoA;
+    KernelInfo kernelInfoB;
+    std::unique_ptr<KernelStatsAggregator> aggregator;
+};
+
+TEST(KernelStatsHistogramTest, givenDurationsWhenAddedThenLog2BucketsAndSummaryAreUpdated) {
+    KernelStatsAggregator::Histogram histogram;
+    histogram.add(0);
+    histogram.add(1);
+    histogram.add(1000);
+    histogram.add(1023);
+    histogram.add(std::numeric_limits<uint64_t>::max());
+
+    EXPECT_EQ(5u, histogram.count);
+    EXPECT_EQ(0u, histogram.min);
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), histogram.max);
+    EXPECT_EQ(2u, histogram.buckets[0]);
+    EXPECT_EQ(2u, histogram.buckets[9]);
+    EXPECT_EQ(1u, histogram.buckets[KernelStatsAggregator::histogramBuckets - 1]);
+}
+
+TEST_F(KernelStatsAggregatorTest, givenCompletedDispatchWhenCollectedThenTimesAreConvertedWithCpuGpuCorrelation) {
+    // c0 = 10000 - 1000 * 2 = 8000, start = 1400 * 2 + 8000 = 10800
+    dispatch(kernelInfoA, 1400, 500, 800);
+    aggregator->collectMeasurements();
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ("kernelA", stats.kernelName);
+    EXPECT_EQ(1u, stats.queueToSubmit.count);
+    EXPECT_EQ(300u, stats.queueToSubmit.min);
+    EXPECT_EQ(500u, stats.submitToStart.min);
+    EXPECT_EQ(600u, stats.execution.min);
+    EXPECT_FALSE(aggregator->getKernelStats(kernelInfoB, stats));
+}
+
+TEST_F(KernelStatsAggregatorTest, givenDispatchNotCompletedOrNotSubmittedWhenCollectedThenItAndLaterDispatchesStayPending) {
+    osTime.cpuGpuTime = {1000, 10000};
+    auto notSubmitted = aggregator->obtainMeasurement(kernelInfoA);
+    ASSERT_NE(nullptr, notSubmitted);
+    notSubmitted->timeStamps->tag->ContextEndTS = 800;
+    auto notCompleted = dispatch(kernelInfoA, 1400, 500, 0);
+    dispatch(kernelInfoB, 1400, 500, 800);
+    aggregator->collectMeasurements();
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(0u, stats.execution.count);
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoB, stats));
+    EXPECT_EQ(0u, stats.execution.count);
+
+    aggregator->setSubmitted(notSubmitted);
+    aggregator->collectMeasurements();
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(1u, stats.execution.count);
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoB, stats));
+    EXPECT_EQ(0u, stats.execution.count);
+
+    notCompleted->timeStamps->tag->ContextEndTS = 800;
+    aggregator->collectMeasurements();
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(2u, stats.execution.count);
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoB, stats));
+    EXPECT_EQ(1u, stats.execution.count);
+}
+
+TEST_F(KernelStatsAggregatorTest, givenGpuStartBeforeSubmitWhenCollectedThenSubmitToStartIsZero) {
+    dispatch(kernelInfoA, 1000, 500, 800);
+    aggregator->collectMeasurements();
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(0u, stats.submitToStart.max);
+}
+
+TEST_F(KernelStatsAggregatorTest, givenKernelInfoReusedForOtherKernelWhenMeasuredThenStatsAreKeptSeparately) {
+    dispatch(kernelInfoA, 1400, 500, 800);
+    aggregator->collectMeasurements();
+
+    kernelInfoA.name = "kernelC";
+    dispatch(kernelInfoA, 1400, 500, 1012);
+    aggregator->collectMeasurements();
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ("kernelC", stats.kernelName);
+    EXPECT_EQ(1u, stats.execution.count);
+    EXPECT_EQ(1024u, stats.execution.min);
+
+    std::stringstream out;
+    aggregator->dump(out);
+    auto text = out.str();
+    EXPECT_EQ(0u, text.find("device=0x1912 kernels=2\n"));
+    EXPECT_NE(std::string::npos, text.find("kernel=kernelA metric=execution count=1 minNs=600"));
+    EXPECT_NE(std::string::npos, text.find("kernel=kernelC metric=execution count=1 minNs=1024"));
+}
+
+TEST_F(KernelStatsAggregatorTest, givenTooManyDispatchesInFlightWhenMeasurementIsObtainedThenNoneIsReturned) {
+    for (size_t i = 0; i < KernelStatsAggregator::maxPendingMeasurements; i++) {
+        ASSERT_NE(nullptr, aggregator->obtainMeasurement(kernelInfoA));
+    }
+    EXPECT_EQ(nullptr, aggregator->obtainMeasurement(kernelInfoA));
+}
+
+TEST_F(KernelStatsAggregatorTest, givenAllMeasurementsInFlightWhenOldestCompletesThenItIsCollectedAndReused) {
+    auto oldest = dispatch(kernelInfoA, 1400, 500, 0);
+    for (size_t i = 1; i < KernelStatsAggregator::maxPendingMeasurements; i++) {
+        ASSERT_NE(nullptr, aggregator->obtainMeasurement(kernelInfoA));
+    }
+    oldest->timeStamps->tag->ContextEndTS = 800;
+    EXPECT_EQ(oldest, aggregator->obtainMeasurement(kernelInfoB));
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(1u, stats.execution.count);
+}
+
+TEST_F(KernelStatsAggregatorTest, givenCollectedStatsWhenDumpedThenEachKernelMetricIsWritten) {
+    dispatch(kernelInfoA, 1400, 500, 800);
+    dispatch(kernelInfoB, 1400, 500, 1012);
+    aggregator->collectMeasurements();
+
+    std::stringstream out;
+    aggregator->dump(out);
+    auto text = out.str();
+    EXPECT_EQ(0u, text.find("device=0x1912 kernels=2\n"));
+    EXPECT_NE(std::string::npos, text.find("kernel=kernelA metric=queueToSubmit count=1 minNs=300 avgNs=300 maxNs=300 log2NsHistogram=8:1\n"));
+    EXPECT_NE(std::string::npos, text.find("kernel=kernelA metric=execution count=1 minNs=600 avgNs=600 maxNs=600 log2NsHistogram=9:1\n"));
+    EXPECT_NE(std::string::npos, text.find("kernel=kernelB metric=execution count=1 minNs=1024 avgNs=1024 maxNs=1024 log2NsHistogram=10:1\n"));
+}
+
+TEST_F(KernelStatsAggregatorTest, givenTimeStampsWrappingDuringDispatchWhenCollectedThenExecutionTimeIsWrapAware) {
+    const uint64_t contextStart = (1ULL << OCLRT_NUM_TIMESTAMP_BITS) - 100;
+    dispatch(kernelInfoA, 1400, contextStart, 200);
+    aggregator->collectMeasurements();
+
+    KernelStatsAggregator::KernelStats stats;
+    ASSERT_TRUE(aggregator->getKernelStats(kernelInfoA, stats));
+    EXPECT_EQ(static_cast<uint64_t>(Event::getDelta(contextStart, 200) * timerResolution), stats.execution.min);
+    EXPECT_NE(0u, stats.execution.min);
+}
+
+TEST_F(KernelStatsAggregatorTest, givenDumpRequestWhenMeasurementsAreCollectedThenStatsAreAppendedToFileOnce) {
+    std::string statsFile = "kernel_stats_test.txt";
+    std::remove(statsFile.c_str());
+    aggregator.reset(new KernelStatsAggregator(&memoryManager, &osTime, timerResolution, deviceId, statsFile));
+    dispatch(kernelInfoA, 1400, 500, 800);
+
+    aggregator->collectMeasurements();
+    EXPECT_FALSE(std::ifstream(statsFile).is_open());
+
+    KernelStatsAggregator::requestDump(0);
+    aggregator->collectMeasurements();
+    aggregator->collectMeasurements();
+
+    std::ifstream dumped(statsFile);
+    ASSERT_TRUE(dumped.is_open());
+    std::string line;
+    size_t headers = 0;
+    while (std::getline(dumped, line)) {
+        headers += line.find("device=") == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(1u, headers);
+    dumped.close();
+
+    aggregator.reset();
+    std::remove(statsFile.c_str());
+}
+
+#if !defined(_WIN32)
+TEST_F(KernelStatsAggregatorTest, givenInstalledDumpSignalWhenSignalIsRaisedThenNextCollectionDumpsStatsAndPreviousHandlerIsChained) {
+    static std::atomic<uint32_t> previousHandlerCalls{0};
+    struct PreviousHandler {
+        static void handle(int) { previousHandlerCalls++; }
+    };
+    std::signal(SIGUSR2, &PreviousHandler::handle);
+
+    std::string statsFile = "kernel_stats_signal_test.txt";
+    std::remove(statsFile.c_str());
+    aggregator.reset(new KernelStatsAggregator(&memoryManager, &osTime, timerResolution, deviceId, statsFile));
+    dispatch(kernelInfoA, 1400, 500, 800);
+
+    KernelStatsAggregator::installDumpSignal(SIGUSR2);
+    std::raise(SIGUSR2);
+    EXPECT_EQ(1u, previousHandlerCalls.load());
+    EXPECT_FALSE(std::ifstream(statsFile).is_open());
+
+    aggregator->collectMeasurements();
+    std::ifstream file(statsFile);
+    ASSERT_TRUE(file.is_open());
+    std::string header;
+    std::getline(file, header);
+    EXPECT_EQ("device=0x1912 kernels=1", header);
+    file.close();
+
+    aggregator.reset();
+    std::remove(statsFile.c_str());
+}
+#endif
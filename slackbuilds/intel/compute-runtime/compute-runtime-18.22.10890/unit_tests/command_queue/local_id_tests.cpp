@@ -23,12 +23,18 @@
 #include "runtime/command_queue/local_id_gen.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/ptr_math.h"
+#include "runtime/utilities/cpu_info.h"
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <cstdint>
 
 using namespace OCLRT;
 
+namespace OCLRT {
+struct uint16x8_t;
+struct uint16x32_t;
+} // namespace OCLRT
+
 TEST(LocalID, GRFsPerThread_SIMD8) {
     uint32_t simd = 8;
     EXPECT_EQ(1u, getGRFsPerThread(simd));
@@ -234,6 +240,22 @@ TEST_P(LocalIDFixture, sizeCalculationLocalIDs) {
     EXPECT_EQ(numGRFsExpected * sizeGRF, sizeTotalPerThreadData);
 }
 
+TEST_P(LocalIDFixture, givenAvx512SupportWhenGeneratingSimd32LocalIDsThenResultMatchesSse4) {
+    if (simd != 32 || !CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX512F | CpuInfo::featureAvX512Bw)) {
+        return;
+    }
+    const auto bufferSize = 32 * 3 * 16 * sizeof(uint16_t);
+    auto expected = reinterpret_cast<uint16_t *>(alignedMalloc(bufferSize, 32));
+    memset(expected, 0xff, bufferSize);
+
+    auto threadsPerWorkGroup = getThreadsPerWG(simd, localWorkSize);
+    generateLocalIDsSimd<uint16x8_t, 32>(expected, localWorkSizeX, localWorkSizeY, threadsPerWorkGroup);
+    generateLocalIDsSimd<uint16x32_t, 32>(buffer, localWorkSizeX, localWorkSizeY, threadsPerWorkGroup);
+    EXPECT_EQ(0, memcmp(expected, buffer, bufferSize));
+
+    alignedFree(expected);
+}
+
 #define SIMDParams ::testing::Values(8, 16, 32)
 #if HEAVY_DUTY_TESTING
 #define LWSXParams ::testing::Values(1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 64, 128, 256)
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/local_id_gen.h"
+#include "runtime/command_queue/local_ids_cache.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(LocalIdsCacheMtTest, givenConcurrentThreadsWhenGeneratingLocalIdsThenEachShapeIsCachedOnceAndIdsMatchGenerator) {
+    LocalIdsCache cache;
+    const uint32_t simds[] = {8, 16, 32};
+    const size_t numThreads = 8;
+    const size_t numShapes = 8;
+    const size_t bufferSize = 64 * 1024;
+
+    std::vector<int> mismatches(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++) {
+        threads.push_back(std::thread([&, t]() {
+            auto buffer = alignedMalloc(bufferSize, 32);
+            auto expected = alignedMalloc(bufferSize, 32);
+            for (size_t iteration = 0; iteration < 16; iteration++) {
+                for (size_t shape = 0; shape < numShapes; shape++) {
+                    auto simd = simds[shape % 3];
+                    const size_t localWorkSizes[3] = {shape + 1, 4, 2};
+                    auto size = getThreadsPerWG(simd, localWorkSizes[0] * localWorkSizes[1] * localWorkSizes[2]) * getPerThreadSizeLocalIDs(simd);
+                    memset(expected, 0, size);
+                    generateLocalIDs(expected, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+                    cache.generateLocalIds(buffer, size, simd, localWorkSizes);
+                    mismatches[t] += memcmp(expected, buffer, size) != 0;
+                }
+            }
+            alignedFree(expected);
+            alignedFree(buffer);
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (auto mismatchCount : mismatches) {
+        EXPECT_EQ(0, mismatchCount);
+    }
+    EXPECT_EQ(numShapes, cache.peekEntriesCount());
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/local_id_gen.h"
+#include "runtime/command_queue/local_ids_cache.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <memory>
+
+using namespace OCLRT;
+
+struct LocalIdsCacheTest : public ::testing::Test {
+    void SetUp() override {
+        buffer = alignedMalloc(bufferSize, 32);
+        expected = alignedMalloc(bufferSize, 32);
+    }
+
+    void TearDown() override {
+        alignedFree(expected);
+        alignedFree(buffer);
+    }
+
+    size_t getLocalIdsSize(uint32_t simd, const size_t localWorkSizes[3]) {
+        auto localWorkSize = localWorkSizes[0] * localWorkSizes[1] * localWorkSizes[2];
+        return getThreadsPerWG(simd, localWorkSize) * getPerThreadSizeLocalIDs(simd);
+    }
+
+    void expectLocalIds(uint32_t simd, const size_t localWorkSizes[3]) {
+        auto size = getLocalIdsSize(simd, localWorkSizes);
+        ASSERT_LE(size, bufferSize);
+        memset(buffer, 0, size);
+        memset(expected, 0, size);
+        cache.generateLocalIds(buffer, size, simd, localWorkSizes);
+        generateLocalIDs(expected, simd, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+        EXPECT_EQ(0, memcmp(expected, buffer, size));
+    }
+
+    const size_t bufferSize = 1024 * 1024;
+    void *buffer = nullptr;
+    void *expected = nullptr;
+    LocalIdsCache cache;
+};
+
+TEST_F(LocalIdsCacheTest, givenNewShapeWhenGeneratingLocalIdsThenIdsAreGeneratedAndCached) {
+    const size_t localWorkSizes[3] = {4, 4, 4};
+    expectLocalIds(16, localWorkSizes);
+
+    EXPECT_EQ(1u, cache.peekEntriesCount());
+    EXPECT_EQ(getLocalIdsSize(16, localWorkSizes), cache.peekCachedSize());
+}
+
+TEST_F(LocalIdsCacheTest, givenCachedShapeWhenGeneratingLocalIdsThenCachedIdsAreCopied) {
+    const size_t localWorkSizes[3] = {7, 5, 3};
+    expectLocalIds(32, localWorkSizes);
+    expectLocalIds(32, localWorkSizes);
+
+    EXPECT_EQ(1u, cache.peekEntriesCount());
+}
+
+TEST_F(LocalIdsCacheTest, givenShapesDifferingInSimdOrAnyDimensionWhenGeneratingLocalIdsThenSeparateEntriesAreCached) {
+    const size_t lws[][3] = {{8, 8, 1}, {8, 1, 8}, {1, 8, 8}};
+    for (uint32_t simd : {8u, 16u, 32u}) {
+        for (auto &localWorkSizes : lws) {
+            expectLocalIds(simd, localWorkSizes);
+        }
+    }
+
+    EXPECT_EQ(9u, cache.peekEntriesCount());
+}
+
+TEST_F(LocalIdsCacheTest, givenFullCacheWhenGeneratingLocalIdsForNewShapeThenIdsAreGeneratedWithoutCaching) {
+    for (size_t x = 1; x <= LocalIdsCache::maxEntries; x++) {
+        const size_t localWorkSizes[3] = {x, 1, 1};
+        expectLocalIds(8, localWorkSizes);
+    }
+    EXPECT_EQ(LocalIdsCache::maxEntries, cache.peekEntriesCount());
+    auto cachedSize = cache.peekCachedSize();
+
+    const size_t localWorkSizes[3] = {16, 16, 1};
+    expectLocalIds(8, localWorkSizes);
+
+    EXPECT_EQ(LocalIdsCache::maxEntries, cache.peekEntriesCount());
+    EXPECT_EQ(cachedSize, cache.peekCachedSize());
+}
+
+TEST_F(LocalIdsCacheTest, givenShapesExceedingCachedSizeLimitWhenGeneratingLocalIdsThenCachedSizeStaysWithinLimit) {
+    for (size_t z = 1; z <= 8; z++) {
+        const size_t localWorkSizes[3] = {8192, 1, z};
+        expectLocalIds(8, localWorkSizes);
+    }
+
+    EXPECT_LT(cache.peekEntriesCount(), 8u);
+    EXPECT_LE(cache.peekCachedSize(), LocalIdsCache::maxCachedSize);
+}
+
+TEST_F(LocalIdsCacheTest, givenFewerLocalIdChannelsWhenGeneratingLocalIdsThenOnlyRequestedSizeIsWrittenAndSizesAreCachedSeparately) {
+    const size_t localWorkSizes[3] = {16, 4, 1};
+    auto fullSize = getLocalIdsSize(16, localWorkSizes);
+    auto threads = getThreadsPerWG(16, localWorkSizes[0] * localWorkSizes[1] * localWorkSizes[2]);
+    memset(expected, 0, fullSize);
+    generateLocalIDs(expected, 16, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+
+    for (uint32_t numChannels : {1u, 2u, 3u}) {
+        auto size = threads * getPerThreadSizeLocalIDs(16, numChannels);
+        memset(buffer, 0xCD, fullSize);
+        cache.generateLocalIds(buffer, size, 16, localWorkSizes);
+        EXPECT_EQ(0, memcmp(expected, buffer, size));
+        for (size_t i = size; i < fullSize; i++) {
+            ASSERT_EQ(0xCD, static_cast<uint8_t *>(buffer)[i]) << "numChannels " << numChannels;
+        }
+    }
+
+    EXPECT_EQ(3u, cache.peekEntriesCount());
+    EXPECT_EQ(3 * fullSize, cache.peekCachedSize());
+}
+
+TEST_F(LocalIdsCacheTest, givenFullCacheAndFewerLocalIdChannelsWhenGeneratingLocalIdsThenOnlyRequestedSizeIsWritten) {
+    for (size_t x = 1; x <= LocalIdsCache::maxEntries; x++) {
+        const size_t localWorkSizes[3] = {x, 1, 1};
+        expectLocalIds(8, localWorkSizes);
+    }
+
+    const size_t localWorkSizes[3] = {16, 16, 1};
+    auto fullSize = getLocalIdsSize(8, localWorkSizes);
+    auto size = getThreadsPerWG(8, 16 * 16) * getPerThreadSizeLocalIDs(8, 1);
+    memset(expected, 0, fullSize);
+    generateLocalIDs(expected, 8, localWorkSizes[0], localWorkSizes[1], localWorkSizes[2]);
+    memset(buffer, 0xCD, fullSize);
+    cache.generateLocalIds(buffer, size, 8, localWorkSizes);
+
+    EXPECT_EQ(0, memcmp(expected, buffer, size));
+    EXPECT_EQ(0xCD, static_cast<uint8_t *>(buffer)[size]);
+    EXPECT_EQ(LocalIdsCache::maxEntries, cache.peekEntriesCount());
+}
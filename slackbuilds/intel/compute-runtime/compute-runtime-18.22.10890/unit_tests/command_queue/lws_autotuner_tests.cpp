@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/lws_autotuner.h"
+#include "runtime/event/event.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "test.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+using namespace OCLRT;
+
+struct LwsAutotunerTest : public ::testing::Test {
+    void SetUp() override {
+        autotuner.reset(new LwsAutotuner(&memoryManager, deviceId, ""));
+    }
+
+    // runs every tuning dispatch, timing candidate i with durations[i] ticks
+    void runTuning(LwsAutotuner &tuner, const std::vector<uint64_t> &durations, uint64_t startTimeStamp = 1000) {
+        const uint64_t timeStampMask = (1ULL << OCLRT_NUM_TIMESTAMP_BITS) - 1;
+        for (size_t dispatch = 0; dispatch < durations.size() * LwsAutotuner::samplesPerCandidate; dispatch++) {
+            Vec3<size_t> lws(0, 0, 0);
+            ASSERT_TRUE(tuner.selectLocalWorkSize(key, lws));
+            auto timeStamps = tuner.obtainTimeStamps(key, lws);
+            ASSERT_NE(nullptr, timeStamps);
+            auto candidate = std::find(candidates.begin(), candidates.end(), lws) - candidates.begin();
+            timeStamps->tag->ContextStartTS = startTimeStamp;
+            timeStamps->tag->ContextEndTS = (startTimeStamp + durations[candidate]) & timeStampMask;
+        }
+    }
+
+    const uint32_t deviceId = 0x1912;
+    OsAgnosticMemoryManager memoryManager;
+    std::unique_ptr<LwsAutotuner> autotuner;
+    LwsAutotuner::ProfileKey key = {0x1234, {1024, 64, 1}};
+    std::vector<Vec3<size_t>> candidates = {{32, 8, 1}, {256, 1, 1}, {16, 16, 1}};
+};
+
+TEST_F(LwsAutotunerTest, givenGwsWhenCandidatesAreGeneratedThenDefaultComesFirstAndAllShapesDivideGws) {
+    const size_t maxWorkItemSizes[3] = {256, 256, 256};
+    Vec3<size_t> gws(1920, 1080, 1);
+    Vec3<size_t> defaultLws(16, 8, 1);
+
+    auto generated = LwsAutotuner::generateCandidates(gws, 2, defaultLws, 256, maxWorkItemSizes, 16);
+    ASSERT_LE(generated.size(), LwsAutotuner::maxCandidates);
+    ASSERT_LT(1u, generated.size());
+    EXPECT_EQ(defaultLws, generated[0]);
+    for (auto &lws : generated) {
+        EXPECT_EQ(0u, gws.x % lws.x);
+        EXPECT_EQ(0u, gws.y % lws.y);
+        EXPECT_EQ(1u, lws.z);
+        EXPECT_LE(lws.x * lws.y * lws.z, 256u);
+        EXPECT_EQ(1u, std::count(generated.begin(), generated.end(), lws));
+    }
+}
+
+TEST_F(LwsAutotunerTest, givenNewShapeWhenTuningCompletesThenFastestCandidateIsSelected) {
+    autotuner->startTuning(key, candidates);
+    runTuning(*autotuner, {300, 100, 200});
+
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_TRUE(autotuner->selectLocalWorkSize(key, lws));
+    EXPECT_EQ(candidates[1], lws);
+    EXPECT_EQ(nullptr, autotuner->obtainTimeStamps(key, lws));
+}
+
+TEST_F(LwsAutotunerTest, givenTimeStampsWrappingDuringDispatchWhenTuningCompletesThenWrappedDurationsAreMeasured) {
+    const uint64_t startTimeStamp = (1ULL << OCLRT_NUM_TIMESTAMP_BITS) - 150;
+    autotuner->startTuning(key, candidates);
+    runTuning(*autotuner, {300, 200, 100}, startTimeStamp);
+
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_TRUE(autotuner->selectLocalWorkSize(key, lws));
+    EXPECT_EQ(candidates[2], lws);
+}
+
+TEST_F(LwsAutotunerTest, givenCandidatesInFlightWhenLwsIsSelectedThenHeuristicDefaultIsUsedWithoutMeasurement) {
+    autotuner->startTuning(key, candidates);
+    for (size_t dispatch = 0; dispatch < candidates.size() * LwsAutotuner::samplesPerCandidate; dispatch++) {
+        Vec3<size_t> lws(0, 0, 0);
+        autotuner->selectLocalWorkSize(key, lws);
+        EXPECT_NE(nullptr, autotuner->obtainTimeStamps(key, lws));
+    }
+
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_TRUE(autotuner->selectLocalWorkSize(key, lws));
+    EXPECT_EQ(candidates[0], lws);
+    EXPECT_EQ(nullptr, autotuner->obtainTimeStamps(key, lws));
+}
+
+TEST_F(LwsAutotunerTest, givenDispatchWithShapeOtherThanNextCandidateWhenTimeStampsAreObtainedThenNoMeasurementIsStarted) {
+    autotuner->startTuning(key, candidates);
+    EXPECT_EQ(nullptr, autotuner->obtainTimeStamps(key, candidates[2]));
+    EXPECT_EQ(nullptr, autotuner->obtainTimeStamps(LwsAutotuner::ProfileKey{0x5678, {1024, 64, 1}}, candidates[0]));
+}
+
+TEST_F(LwsAutotunerTest, givenUnknownShapeWhenLwsIsSelectedThenFalseIsReturned) {
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_FALSE(autotuner->selectLocalWorkSize(key, lws));
+}
+
+TEST_F(LwsAutotunerTest, givenSingleCandidateWhenTuningStartsThenItIsSelectedWithoutMeasurements) {
+    autotuner->startTuning(key, {candidates[0]});
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_TRUE(autotuner->selectLocalWorkSize(key, lws));
+    EXPECT_EQ(candidates[0], lws);
+    EXPECT_EQ(nullptr, autotuner->obtainTimeStamps(key, lws));
+}
+
+TEST_F(LwsAutotunerTest, givenTuningCompletedWhenAutotunerIsAliveThenProfilesAreSavedOnlyOnDestruction) {
+    const char *profileFile = "lws_profiles_test.txt";
+    std::remove(profileFile);
+    {
+        LwsAutotuner tuner(&memoryManager, deviceId, profileFile);
+        tuner.startTuning(key, candidates);
+        runTuning(tuner, {100, 300, 200});
+        Vec3<size_t> lws(0, 0, 0);
+        EXPECT_TRUE(tuner.selectLocalWorkSize(key, lws));
+        EXPECT_FALSE(std::ifstream(profileFile).good());
+    }
+    EXPECT_TRUE(std::ifstream(profileFile).good());
+
+    std::remove(profileFile);
+}
+
+TEST_F(LwsAutotunerTest, givenTunedShapeWhenNewAutotunerLoadsProfilesThenTunedLwsIsUsedAndOtherDevicesProfilesArePreserved) {
+    const char *profileFile = "lws_profiles_test.txt";
+    {
+        std::ofstream file(profileFile, std::ios::trunc);
+        file << "abcd 42 64 1 1 64 1 1\n";
+    }
+    {
+        LwsAutotuner tuner(&memoryManager, deviceId, profileFile);
+        tuner.startTuning(key, candidates);
+        runTuning(tuner, {100, 300, 200});
+        Vec3<size_t> lws(0, 0, 0);
+        EXPECT_TRUE(tuner.selectLocalWorkSize(key, lws));
+    }
+
+    LwsAutotuner tuner(&memoryManager, deviceId, profileFile);
+    Vec3<size_t> lws(0, 0, 0);
+    EXPECT_TRUE(tuner.selectLocalWorkSize(key, lws));
+    EXPECT_EQ(candidates[0], lws);
+    EXPECT_EQ(nullptr, tuner.obtainTimeStamps(key, lws));
+
+    LwsAutotuner otherDeviceTuner(&memoryManager, 0xabcd, profileFile);
+    EXPECT_TRUE(otherDeviceTuner.selectLocalWorkSize(LwsAutotuner::ProfileKey{0x42, {64, 1, 1}}, lws));
+    EXPECT_EQ(Vec3<size_t>(64, 1, 1), lws);
+
+    std::remove(profileFile);
+}
@@ -381,6 +381,104 @@ HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenGraphic
     memoryManager->freeGraphicsMemory(gfxAllocation);
 }
 
+HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenAllocationContentsDidNotChangeThenAllocationIsNotWrittenAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpSkipUnchangedAllocations.set(true);
+
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    std::unique_ptr<AUBCommandStreamReceiver::AubFileStream> mockAubFileStream(new MockAubFileStream());
+    MockAubFileStream *mockAubFileStreamPtr = static_cast<MockAubFileStream *>(mockAubFileStream.get());
+    mockAubFileStream.swap(aubCsr->stream);
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(sizeof(uint32_t), sizeof(uint32_t), false, false);
+    *reinterpret_cast<uint32_t *>(gfxAllocation->getUnderlyingBuffer()) = 1u;
+
+    EXPECT_CALL(*mockAubFileStreamPtr, addComment(_)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    *reinterpret_cast<uint32_t *>(gfxAllocation->getUnderlyingBuffer()) = 2u;
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    mockAubFileStream.swap(aubCsr->stream);
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenSkipUnchangedAllocationsEnabledWhenAubFileIsReopenedThenUnchangedAllocationIsWrittenAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpSkipUnchangedAllocations.set(true);
+
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    std::unique_ptr<AUBCommandStreamReceiver::AubFileStream> mockAubFileStream(new MockAubFileStream());
+    MockAubFileStream *mockAubFileStreamPtr = static_cast<MockAubFileStream *>(mockAubFileStream.get());
+    mockAubFileStream.swap(aubCsr->stream);
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(sizeof(uint32_t), sizeof(uint32_t), false, false);
+
+    EXPECT_CALL(*mockAubFileStreamPtr, addComment(_)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    mockAubFileStreamPtr->fileId++;
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    mockAubFileStream.swap(aubCsr->stream);
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenSkipUnchangedAllocationsEnabledWhenAllocationIsFreedThenNewAllocationAtSameAddressIsWritten) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpSkipUnchangedAllocations.set(true);
+
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    std::unique_ptr<AUBCommandStreamReceiver::AubFileStream> mockAubFileStream(new MockAubFileStream());
+    MockAubFileStream *mockAubFileStreamPtr = static_cast<MockAubFileStream *>(mockAubFileStream.get());
+    mockAubFileStream.swap(aubCsr->stream);
+
+    uint32_t hostMemory = 1u;
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(sizeof(hostMemory), &hostMemory);
+
+    EXPECT_CALL(*mockAubFileStreamPtr, addComment(_)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+
+    gfxAllocation = memoryManager->allocateGraphicsMemory(sizeof(hostMemory), &hostMemory);
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    mockAubFileStream.swap(aubCsr->stream);
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenSkipUnchangedAllocationsDisabledWhenAllocationContentsDidNotChangeThenAllocationIsWrittenAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpSkipUnchangedAllocations.set(false);
+
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    std::unique_ptr<AUBCommandStreamReceiver::AubFileStream> mockAubFileStream(new MockAubFileStream());
+    MockAubFileStream *mockAubFileStreamPtr = static_cast<MockAubFileStream *>(mockAubFileStream.get());
+    mockAubFileStream.swap(aubCsr->stream);
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(sizeof(uint32_t), sizeof(uint32_t), false, false);
+
+    EXPECT_CALL(*mockAubFileStreamPtr, addComment(_)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+
+    mockAubFileStream.swap(aubCsr->stream);
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
 HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenGraphicsAllocationTypeIsNonAubWritableThenWriteMemoryIsNotAllowed) {
     std::unique_ptr<MemoryManager> memoryManager(nullptr);
     std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
@@ -471,7 +569,7 @@ HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenForcedB
 
     size_t sizeBatchBuffer = 0xffffu;
 
-    std::unique_ptr<void, std::function<void(void *)>> flatBatchBuffer(flatBatchBufferHelper->flattenBatchBuffer(batchBuffer, sizeBatchBuffer, DispatchMode::AdaptiveDispatch), [&](void *ptr) { memoryManager->alignedFreeWrapper(ptr); });
+    std::unique_ptr<void, std::function<void(void *)>> flatBatchBuffer(flatBatchBufferHelper->flattenBatchBuffer(batchBuffer, sizeBatchBuffer, DispatchMode::DeviceDefault), [&](void *ptr) { memoryManager->alignedFreeWrapper(ptr); });
     EXPECT_EQ(nullptr, flatBatchBuffer.get());
     EXPECT_EQ(0xffffu, sizeBatchBuffer);
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/aub_command_stream_receiver.h"
+#include "runtime/command_stream/aub_file_writer.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+using namespace OCLRT;
+
+TEST(AubFileWriterTest, givenDataSmallerThanBufferWhenWrittenThenItReachesStreamOnlyAfterFlush) {
+    std::ostringstream output;
+    AubFileWriter writer(output, 64);
+
+    writer.write("abcd", 4);
+    EXPECT_TRUE(output.str().empty());
+
+    writer.flush();
+    EXPECT_EQ("abcd", output.str());
+}
+
+TEST(AubFileWriterTest, givenDataExceedingBufferWhenWrittenThenAllDataIsWrittenInOrder) {
+    std::ostringstream output;
+    std::string expected;
+    {
+        AubFileWriter writer(output, 16);
+        for (int i = 0; i < 1000; i++) {
+            auto record = std::to_string(i) + ";";
+            expected += record;
+            writer.write(record.c_str(), record.size());
+        }
+        EXPECT_GE(AubFileWriter::maxPendingBuffers, writer.peekPendingBuffersCount());
+    }
+    EXPECT_EQ(expected, output.str());
+}
+
+TEST(AubFileWriterTest, givenWriterWhenDestroyedThenPendingDataIsWritten) {
+    std::ostringstream output;
+    {
+        AubFileWriter writer(output, 1024);
+        writer.write("pending", 7);
+    }
+    EXPECT_EQ("pending", output.str());
+}
+
+TEST(AubFileStreamTest, givenDefaultSettingsWhenStreamIsOpenedThenRecordsAreWrittenSynchronously) {
+    AUBCommandStreamReceiver::AubFileStream stream;
+    stream.open("aub_file_writer_test.aub");
+    EXPECT_EQ(nullptr, stream.writer.get());
+    stream.close();
+    std::remove("aub_file_writer_test.aub");
+}
+
+TEST(AubFileStreamTest, givenStreamWhenFileIsReopenedThenFileIdChanges) {
+    AUBCommandStreamReceiver::AubFileStream stream;
+    auto initialFileId = stream.fileId;
+
+    stream.open("aub_file_writer_test.aub");
+    auto openedFileId = stream.fileId;
+    EXPECT_NE(initialFileId, openedFileId);
+    stream.close();
+
+    stream.open("aub_file_writer_test.aub");
+    EXPECT_NE(openedFileId, stream.fileId);
+    stream.close();
+    std::remove("aub_file_writer_test.aub");
+}
+
+TEST(AubFileStreamTest, givenZeroBufferSizeWhenStreamIsOpenedThenRecordsAreWrittenSynchronously) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpBufferSizeMB.set(0);
+
+    AUBCommandStreamReceiver::AubFileStream stream;
+    stream.open("aub_file_writer_test.aub");
+    EXPECT_EQ(nullptr, stream.writer.get());
+    stream.close();
+    std::remove("aub_file_writer_test.aub");
+}
+
+TEST(AubFileStreamTest, givenBufferSizeSetWhenStreamIsOpenedThenBufferedWriterIsUsed) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AubDumpBufferSizeMB.set(2);
+
+    AUBCommandStreamReceiver::AubFileStream stream;
+    stream.open("aub_file_writer_test.aub");
+    ASSERT_NE(nullptr, stream.writer.get());
+    EXPECT_EQ(2 * 1024 * 1024u, stream.writer->peekBufferSize());
+    stream.close();
+    EXPECT_EQ(nullptr, stream.writer.get());
+    std::remove("aub_file_writer_test.aub");
+}
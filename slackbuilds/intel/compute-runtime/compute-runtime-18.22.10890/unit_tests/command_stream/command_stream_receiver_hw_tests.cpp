@@ -41,6 +41,7 @@
 #include "unit_tests/fixtures/ult_command_stream_receiver_fixture.h"
 #include "unit_tests/helpers/hw_parse.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_submission_worker.h"
 #include "unit_tests/mocks/mock_buffer.h"
 #include "unit_tests/mocks/mock_command_queue.h"
 #include "unit_tests/mocks/mock_context.h"
@@ -2465,6 +2466,155 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrCreatedWithDedicatedDebugF
     EXPECT_EQ(DispatchMode::AdaptiveDispatch, mockCsr->dispatchMode);
 }
 
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInAdaptiveDispatchModeAndIdleGpuWhenTaskIsFlushedThenItIsSubmittedRightAway) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideDispatchPolicy(DispatchMode::AdaptiveDispatch);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    auto mockWorker = new MockSubmissionWorker(*mockCsr);
+    mockCsr->submissionWorker.reset(mockWorker);
+
+    configureCSRtoNonDirtyState<FamilyType>();
+    EXPECT_TRUE(mockCsr->isGpuIdle());
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
+    EXPECT_EQ(0u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_TRUE(mockedSubmissionsAggregator->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(0u, mockWorker->openThreadCalled);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInAdaptiveDispatchModeAndBusyGpuWhenTasksAreFlushedThenTheyAreBatchedAndHandedToWorker) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideDispatchPolicy(DispatchMode::AdaptiveDispatch);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    auto mockWorker = new MockSubmissionWorker(*mockCsr);
+    mockCsr->submissionWorker.reset(mockWorker);
+
+    configureCSRtoNonDirtyState<FamilyType>();
+    mockCsr->latestFlushedTaskCount = 1;
+    *mockCsr->getTagAddress() = 0;
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+    EXPECT_EQ(2u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_FALSE(mockedSubmissionsAggregator->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(2u, mockWorker->openThreadCalled);
+    EXPECT_TRUE(mockWorker->workPending);
+
+    *mockCsr->getTagAddress() = initialHardwareTag;
+    mockCsr->flushBatchedSubmissions();
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(0u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_EQ(2u, mockCsr->peekLatestFlushedTaskCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInAdaptiveDispatchModeAndBusyGpuWhenBlockingTaskIsFlushedThenBatchedBuffersAreSubmittedTogether) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideDispatchPolicy(DispatchMode::AdaptiveDispatch);
+
+    auto mockWorker = new MockSubmissionWorker(*mockCsr);
+    mockCsr->submissionWorker.reset(mockWorker);
+
+    configureCSRtoNonDirtyState<FamilyType>();
+    mockCsr->latestFlushedTaskCount = 1;
+    *mockCsr->getTagAddress() = 0;
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+
+    dispatchFlags.blocking = true;
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(1u, mockWorker->openThreadCalled);
+    EXPECT_EQ(0u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_TRUE(mockCsr->peekSubmissionAggregator()->peekCmdBufferList().peekIsEmpty());
+    *mockCsr->getTagAddress() = initialHardwareTag;
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchedDispatchWithCounterModeWhenCounterLimitIsReachedThenBatchedBuffersAreFlushedImplicitly) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.CsrDispatchMode.set(static_cast<uint32_t>(DispatchMode::BatchedDispatchWithCounter));
+    DebugManager.flags.BatchedDispatchCounterLimit.set(3);
+
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    EXPECT_EQ(DispatchMode::BatchedDispatchWithCounter, mockCsr->dispatchMode);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    auto mockWorker = new MockSubmissionWorker(*mockCsr, DispatchMode::BatchedDispatchWithCounter);
+    mockCsr->submissionWorker.reset(mockWorker);
+    EXPECT_EQ(3u, mockWorker->peekQueueDepth());
+
+    configureCSRtoNonDirtyState<FamilyType>();
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.outOfOrderExecutionAllowed = true;
+    dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+    EXPECT_EQ(2u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_EQ(2u, mockWorker->openThreadCalled);
+    auto noopedPipeControl = mockedSubmissionsAggregator->peekCommandBuffers().peekHead()->pipeControlThatMayBeErasedLocation;
+    ASSERT_NE(nullptr, noopedPipeControl);
+
+    mockCsr->flushTask(commandStream, 0, dsh, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(2u, mockWorker->openThreadCalled);
+    EXPECT_EQ(0u, mockCsr->peekBatchedCommandBuffersCount());
+    EXPECT_EQ(3u, mockCsr->peekLatestFlushedTaskCount());
+    EXPECT_TRUE(mockedSubmissionsAggregator->peekCommandBuffers().peekIsEmpty());
+
+    //aggregation removed pipe control between command buffers
+    char zeros[sizeof(typename FamilyType::PIPE_CONTROL)] = {};
+    EXPECT_EQ(0, memcmp(zeros, noopedPipeControl, sizeof(zeros)));
+}
+
 HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenBlockingCommandIsSendThenItIsFlushedAndNotBatched) {
     CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
     auto &commandStream = commandQueue.getCS(4096u);
@@ -3195,8 +3345,9 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrWhenTemporaryAndReusableAl
     commandStreamReceiver.latestFlushedTaskCount = 9;
     commandStreamReceiver.cleanupResources();
 
-    EXPECT_EQ(reusableToHold, memoryManager->allocationsForReuse.peekHead());
-    EXPECT_EQ(reusableToHold, memoryManager->allocationsForReuse.peekTail());
+    auto &reusableBucket = memoryManager->allocationsForReuse.getBucket(ReusableAllocationsPool::getBucketIndex(4096u));
+    EXPECT_EQ(reusableToHold, reusableBucket.peekHead());
+    EXPECT_EQ(reusableToHold, reusableBucket.peekTail());
 
     EXPECT_EQ(temporaryToHold, memoryManager->graphicsAllocations.peekHead());
     EXPECT_EQ(temporaryToHold, memoryManager->graphicsAllocations.peekTail());
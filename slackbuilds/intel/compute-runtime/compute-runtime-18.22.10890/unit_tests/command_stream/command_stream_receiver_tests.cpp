@@ -30,6 +30,7 @@
 #include "unit_tests/mocks/mock_buffer.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/libult/ult_command_stream_receiver.h"
 #include "unit_tests/mocks/mock_builtins.h"
 #include "unit_tests/mocks/mock_csr.h"
 #include "unit_tests/mocks/mock_program.h"
@@ -284,6 +285,115 @@ HWTEST_F(CommandStreamReceiverTest, givenCsrWhenAllocateHeapMemoryIsCalledThenHe
     delete dsh;
 }
 
+template <typename GfxFamily>
+struct RingWaitingCommandStreamReceiver : public UltCommandStreamReceiver<GfxFamily> {
+    RingWaitingCommandStreamReceiver(const HardwareInfo &hwInfoIn) : UltCommandStreamReceiver<GfxFamily>(hwInfoIn) {
+        this->ringBufferReuseEnabled = true;
+    }
+    void waitForFlushedTaskCount(uint32_t taskCountToWait) override {
+        waitedTaskCount = taskCountToWait;
+        *this->getTagAddress() = taskCountToWait;
+    }
+    uint32_t waitedTaskCount = 0;
+};
+
+HWTEST_F(CommandStreamReceiverTest, givenRingBufferReuseWhenHeapIsExhaustedAndItsSubmissionsRetiredThenHeapWrapsInSameAllocation) {
+    auto csr = new RingWaitingCommandStreamReceiver<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(csr);
+
+    auto &heap = csr->getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 10u);
+    auto allocation = heap.getGraphicsAllocation();
+    auto ringTracker = csr->getHeapRingTracker(IndirectHeap::DYNAMIC_STATE);
+    ASSERT_NE(nullptr, ringTracker);
+    EXPECT_EQ(ringTracker, heap.getRingTracker());
+
+    heap.getSpace(heap.getAvailableSpace() - 8);
+    ringTracker->registerSubmission(heap.getUsed(), 1);
+    csr->latestFlushedTaskCount = 1;
+    *csr->getTagAddress() = 1;
+
+    auto &wrappedHeap = csr->getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 1024u);
+    EXPECT_EQ(&heap, &wrappedHeap);
+    EXPECT_EQ(allocation, wrappedHeap.getGraphicsAllocation());
+    EXPECT_EQ(0u, wrappedHeap.getUsed());
+    EXPECT_EQ(1u, ringTracker->peekWrapCount());
+    EXPECT_EQ(0u, ringTracker->peekStallCount());
+    EXPECT_EQ(0u, csr->waitedTaskCount);
+}
+
+HWTEST_F(CommandStreamReceiverTest, givenRingBufferReuseWhenWrapNeedsFlushedTaskThenCsrStallsOnItAndWraps) {
+    auto csr = new RingWaitingCommandStreamReceiver<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(csr);
+
+    auto &heap = csr->getIndirectHeap(IndirectHeap::SURFACE_STATE, 10u);
+    auto ringTracker = heap.getRingTracker();
+    ASSERT_NE(nullptr, ringTracker);
+
+    heap.getSpace(heap.getAvailableSpace() - 8);
+    ringTracker->registerSubmission(heap.getUsed(), 5);
+    csr->latestFlushedTaskCount = 5;
+    *csr->getTagAddress() = 4;
+
+    auto &wrappedHeap = csr->getIndirectHeap(IndirectHeap::SURFACE_STATE, 1024u);
+    EXPECT_EQ(5u, csr->waitedTaskCount);
+    EXPECT_EQ(0u, wrappedHeap.getUsed());
+    EXPECT_EQ(1u, ringTracker->peekWrapCount());
+    EXPECT_EQ(1u, ringTracker->peekStallCount());
+    EXPECT_EQ(0u, ringTracker->peekSubmissionsCount());
+}
+
+HWTEST_F(CommandStreamReceiverTest, givenRingBufferReuseWhenWrapNeedsTaskNotFlushedYetThenNewAllocationIsUsed) {
+    auto csr = new RingWaitingCommandStreamReceiver<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(csr);
+
+    auto &heap = csr->getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 10u);
+    auto allocation = heap.getGraphicsAllocation();
+    auto ringTracker = heap.getRingTracker();
+    ASSERT_NE(nullptr, ringTracker);
+
+    heap.getSpace(heap.getAvailableSpace() - 8);
+    ringTracker->registerSubmission(heap.getUsed(), 5);
+    csr->latestFlushedTaskCount = 4;
+    *csr->getTagAddress() = 4;
+
+    auto &newHeap = csr->getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 1024u);
+    EXPECT_NE(allocation, newHeap.getGraphicsAllocation());
+    EXPECT_TRUE(pDevice->getMemoryManager()->allocationsForReuse.peekContains(*allocation));
+    EXPECT_EQ(0u, csr->waitedTaskCount);
+    EXPECT_EQ(0u, ringTracker->peekWrapCount());
+    EXPECT_EQ(0u, ringTracker->peekSubmissionsCount());
+}
+
+HWTEST_F(CommandStreamReceiverTest, givenRingBufferReuseWhenTaskIsFlushedThenHeapsAndCommandStreamRegisterSubmission) {
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    csr.ringBufferReuseEnabled = true;
+
+    auto &dsh = csr.getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 10u);
+    auto &ioh = csr.getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 10u);
+    auto &ssh = csr.getIndirectHeap(IndirectHeap::SURFACE_STATE, 10u);
+    dsh.getSpace(64);
+    ioh.getSpace(64);
+    ssh.getSpace(64);
+
+    auto graphicsAllocation = pDevice->getMemoryManager()->allocateGraphicsMemory(4096);
+    LinearStream commandStream(graphicsAllocation);
+    RingBufferTracker commandStreamRingTracker;
+    commandStream.setRingTracker(&commandStreamRingTracker);
+    commandStream.getSpace(64);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+    csr.flushTask(commandStream, 0, dsh, ioh, ssh, 0, dispatchFlags);
+
+    EXPECT_EQ(1u, commandStreamRingTracker.peekSubmissionsCount());
+    EXPECT_EQ(1u, csr.getHeapRingTracker(IndirectHeap::DYNAMIC_STATE)->peekSubmissionsCount());
+    EXPECT_EQ(1u, csr.getHeapRingTracker(IndirectHeap::INDIRECT_OBJECT)->peekSubmissionsCount());
+    EXPECT_EQ(1u, csr.getHeapRingTracker(IndirectHeap::SURFACE_STATE)->peekSubmissionsCount());
+    EXPECT_FALSE(commandStreamRingTracker.hasUnregisteredData(commandStream.getUsed()));
+
+    pDevice->getMemoryManager()->freeGraphicsMemory(graphicsAllocation);
+}
+
 TEST(CommandStreamReceiverSimpleTest, givenCSRWithoutTagAllocationWhenGetTagAllocationIsCalledThenNullptrIsReturned) {
     MockCommandStreamReceiver csr;
     EXPECT_EQ(nullptr, csr.getTagAllocation());
@@ -112,4 +112,36 @@ TEST_F(LinearStreamTest, givenNewGraphicsAllocationWhenReplaceIsCalledThenLinear
     EXPECT_NE(&newGraphicsAllocation, graphicsAllocation);
     linearStream.replaceGraphicsAllocation(&newGraphicsAllocation);
     EXPECT_EQ(&newGraphicsAllocation, linearStream.getGraphicsAllocation());
-}
\ No newline at end of file
+}
+
+TEST_F(LinearStreamTest, givenReservedSpaceWhenGetSpaceIsCalledThenUsedSizeIsPublishedOnCommit) {
+    linearStream.getSpace(sizeof(uint32_t));
+    linearStream.reserveSpace(4 * sizeof(uint64_t));
+    EXPECT_TRUE(linearStream.isSpaceReserved());
+
+    auto ptr1 = linearStream.getSpaceForCmd<uint64_t>();
+    auto ptr2 = linearStream.getSpaceForCmd<uint64_t>();
+    EXPECT_EQ(ptrOffset(static_cast<void *>(pCmdBuffer), sizeof(uint32_t)), ptr1);
+    EXPECT_EQ(ptr1 + 1, ptr2);
+    EXPECT_EQ(sizeof(uint32_t) + 2 * sizeof(uint64_t), linearStream.getUsed());
+    EXPECT_EQ(linearStream.getMaxAvailableSpace() - linearStream.getUsed(), linearStream.getAvailableSpace());
+
+    linearStream.commitReservedSpace();
+    EXPECT_FALSE(linearStream.isSpaceReserved());
+    EXPECT_EQ(sizeof(uint32_t) + 2 * sizeof(uint64_t), linearStream.getUsed());
+    EXPECT_EQ(static_cast<void *>(ptr2 + 1), linearStream.getSpace(0));
+}
+
+TEST_F(LinearStreamTest, givenNotEnoughSpaceWhenReserveSpaceIsCalledThenThrowException) {
+    linearStream.getSpace(sizeof(uint32_t));
+    EXPECT_THROW(linearStream.reserveSpace(linearStream.getMaxAvailableSpace()), std::exception);
+    EXPECT_FALSE(linearStream.isSpaceReserved());
+}
+
+TEST_F(LinearStreamTest, givenReservedSpaceWhenGetSpaceExceedsBufferThenThrowException) {
+    linearStream.reserveSpace(linearStream.getMaxAvailableSpace());
+    linearStream.getSpace(linearStream.getMaxAvailableSpace());
+    EXPECT_THROW(linearStream.getSpace(1), std::exception);
+    linearStream.commitReservedSpace();
+    EXPECT_EQ(linearStream.getMaxAvailableSpace(), linearStream.getUsed());
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/ring_buffer_tracker.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+TEST(RingBufferTrackerTest, givenRegisteredSubmissionsWhenTagPassesThemThenTheyAreRetiredInOrder) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.registerSubmission(200, 2);
+    tracker.registerSubmission(300, 3);
+    EXPECT_EQ(3u, tracker.peekSubmissionsCount());
+
+    tracker.retire(2);
+    EXPECT_EQ(1u, tracker.peekSubmissionsCount());
+    tracker.retire(3);
+    EXPECT_EQ(0u, tracker.peekSubmissionsCount());
+}
+
+TEST(RingBufferTrackerTest, givenSubmissionWithoutNewDataWhenRegisteredThenItIsIgnored) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.registerSubmission(100, 2);
+    EXPECT_EQ(1u, tracker.peekSubmissionsCount());
+    EXPECT_FALSE(tracker.hasUnregisteredData(100));
+    EXPECT_TRUE(tracker.hasUnregisteredData(150));
+}
+
+TEST(RingBufferTrackerTest, givenSubmissionsInCurrentLapWhenWrappingThenTaskCountOfLastOverlappedSubmissionIsRequired) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.registerSubmission(200, 2);
+    tracker.registerSubmission(300, 3);
+
+    EXPECT_EQ(1u, tracker.getTaskCountToWrap(50));
+    EXPECT_EQ(2u, tracker.getTaskCountToWrap(101));
+    EXPECT_EQ(3u, tracker.getTaskCountToWrap(250));
+
+    tracker.retire(1);
+    EXPECT_EQ(0u, tracker.getTaskCountToWrap(50));
+    EXPECT_EQ(2u, tracker.getTaskCountToWrap(150));
+}
+
+TEST(RingBufferTrackerTest, givenWrappedRingWhenReusingSpaceThenOnlyOverlappedPreviousLapSubmissionsAreWaitedFor) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.registerSubmission(200, 2);
+    tracker.registerSubmission(300, 3);
+    tracker.retire(1);
+    tracker.wrap();
+    EXPECT_EQ(1u, tracker.peekWrapCount());
+
+    EXPECT_EQ(0u, tracker.getTaskCountToReuse(0, 100));
+    EXPECT_EQ(2u, tracker.getTaskCountToReuse(0, 101));
+    EXPECT_EQ(3u, tracker.getTaskCountToReuse(150, 100));
+
+    tracker.registerSubmission(100, 4);
+    EXPECT_EQ(3u, tracker.getTaskCountToReuse(100, 150));
+    EXPECT_EQ(0u, tracker.getTaskCountToReuse(300, 100));
+}
+
+TEST(RingBufferTrackerTest, givenPreviousLapSubmissionsWhenWrappingAgainThenAllOfThemAreRequiredToRetire) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.registerSubmission(200, 2);
+    tracker.wrap();
+
+    EXPECT_EQ(2u, tracker.getTaskCountToWrap(10));
+
+    tracker.registerSubmission(50, 3);
+    tracker.registerSubmission(100, 4);
+    EXPECT_EQ(3u, tracker.getTaskCountToWrap(10));
+    tracker.retire(3);
+    EXPECT_EQ(0u, tracker.getTaskCountToWrap(10));
+}
+
+TEST(RingBufferTrackerTest, givenTrackerWhenResetThenSubmissionsAreDroppedAndCountersKept) {
+    RingBufferTracker tracker;
+    tracker.registerSubmission(100, 1);
+    tracker.wrap();
+    tracker.recordStall();
+    tracker.reset();
+
+    EXPECT_EQ(0u, tracker.peekSubmissionsCount());
+    EXPECT_EQ(0u, tracker.getTaskCountToWrap(100));
+    EXPECT_EQ(1u, tracker.peekWrapCount());
+    EXPECT_EQ(1u, tracker.peekStallCount());
+    EXPECT_FALSE(tracker.hasUnregisteredData(0));
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_submission_worker.h"
+#include "unit_tests/mocks/mock_csr.h"
+#include "test.h"
+#include <atomic>
+#include <thread>
+
+using namespace OCLRT;
+
+struct SubmissionWorkerTest : public ::testing::Test {
+    class CountingCommandStreamReceiver : public MockCommandStreamReceiver {
+      public:
+        void flushBatchedSubmissions() override {
+            flushBatchedSubmissionsCalled++;
+            batchedCommandBuffersCount = 0;
+        }
+        std::atomic<uint32_t> flushBatchedSubmissionsCalled{0};
+    };
+
+    void SetUp() override {
+        csr.reset(new CountingCommandStreamReceiver());
+        csr->tagAddress = &tag;
+        tag = 1;
+        csr->latestFlushedTaskCount = 2;
+    }
+
+    void makeGpuIdle() {
+        tag = csr->peekLatestFlushedTaskCount();
+    }
+
+    volatile uint32_t tag = 0;
+    std::unique_ptr<CountingCommandStreamReceiver> csr;
+};
+
+TEST_F(SubmissionWorkerTest, givenDebugVariablesSetWhenWorkerIsCreatedThenQueueDepthAndMaxDelayAreTakenFromThem) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AdaptiveDispatchQueueDepth.set(3);
+    DebugManager.flags.AdaptiveDispatchMaxDelayMicroseconds.set(20);
+
+    MockSubmissionWorker worker(*csr);
+    EXPECT_EQ(3u, worker.peekQueueDepth());
+    EXPECT_EQ(std::chrono::microseconds(20), worker.peekMaxSubmissionDelay());
+}
+
+TEST_F(SubmissionWorkerTest, givenBatchedDispatchWithCounterModeWhenWorkerIsCreatedThenCounterLimitAndDeadlineAreTakenFromDebugVariables) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AdaptiveDispatchQueueDepth.set(3);
+    DebugManager.flags.AdaptiveDispatchMaxDelayMicroseconds.set(20);
+    DebugManager.flags.BatchedDispatchCounterLimit.set(5);
+    DebugManager.flags.BatchedDispatchDeadlineMicroseconds.set(40);
+
+    MockSubmissionWorker worker(*csr, DispatchMode::BatchedDispatchWithCounter);
+    EXPECT_EQ(5u, worker.peekQueueDepth());
+    EXPECT_EQ(std::chrono::microseconds(40), worker.peekMaxSubmissionDelay());
+}
+
+TEST_F(SubmissionWorkerTest, givenNonPositiveQueueDepthWhenWorkerIsCreatedThenEachCommandBufferFillsTheQueue) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.AdaptiveDispatchQueueDepth.set(0);
+
+    MockSubmissionWorker worker(*csr);
+    EXPECT_EQ(1u, worker.peekQueueDepth());
+}
+
+TEST_F(SubmissionWorkerTest, givenIdleGpuWhenCheckingSubmissionWindowThenItIsOpen) {
+    MockSubmissionWorker worker(*csr);
+    worker.maxSubmissionDelay = std::chrono::microseconds::max();
+    csr->batchedCommandBuffersCount = 1;
+    makeGpuIdle();
+
+    EXPECT_TRUE(worker.isSubmissionWindowOpen(std::chrono::high_resolution_clock::now()));
+}
+
+TEST_F(SubmissionWorkerTest, givenBusyGpuAndQueueNotFilledWhenCheckingSubmissionWindowThenItIsClosed) {
+    MockSubmissionWorker worker(*csr);
+    worker.queueDepth = 4;
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 3;
+
+    EXPECT_FALSE(worker.isSubmissionWindowOpen(std::chrono::high_resolution_clock::now()));
+}
+
+TEST_F(SubmissionWorkerTest, givenBusyGpuAndFilledQueueWhenCheckingSubmissionWindowThenItIsOpen) {
+    MockSubmissionWorker worker(*csr);
+    worker.queueDepth = 4;
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 4;
+
+    EXPECT_TRUE(worker.isSubmissionWindowOpen(std::chrono::high_resolution_clock::now()));
+}
+
+TEST_F(SubmissionWorkerTest, givenBusyGpuAndElapsedMaxDelayWhenCheckingSubmissionWindowThenItIsOpen) {
+    MockSubmissionWorker worker(*csr);
+    worker.queueDepth = 4;
+    worker.maxSubmissionDelay = std::chrono::microseconds(0);
+    csr->batchedCommandBuffersCount = 1;
+
+    EXPECT_TRUE(worker.isSubmissionWindowOpen(std::chrono::high_resolution_clock::now()));
+}
+
+TEST_F(SubmissionWorkerTest, givenWorkerWhenWorkIsRecordedThenThreadIsOpenedOnFirstUseAndWorkIsMarkedPending) {
+    MockSubmissionWorker worker(*csr);
+    EXPECT_EQ(0u, worker.openThreadCalled);
+
+    worker.notifyWorkRecorded();
+    EXPECT_EQ(1u, worker.openThreadCalled);
+    EXPECT_TRUE(worker.workPending);
+}
+
+TEST_F(SubmissionWorkerTest, givenBusyGpuWhenWorkIsRecordedThenWorkerSubmitsItAfterGpuBecomesIdle) {
+    MockSubmissionWorker worker(*csr, DispatchMode::AdaptiveDispatch, true);
+    worker.queueDepth = 16;
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 1;
+
+    worker.notifyWorkRecorded();
+    EXPECT_NE(nullptr, worker.thread.get());
+    EXPECT_EQ(0u, csr->flushBatchedSubmissionsCalled);
+
+    makeGpuIdle();
+    while (csr->flushBatchedSubmissionsCalled == 0) {
+        std::this_thread::yield();
+    }
+    worker.closeThread();
+
+    EXPECT_EQ(1u, csr->flushBatchedSubmissionsCalled);
+    EXPECT_EQ(nullptr, worker.thread.get());
+}
+
+TEST_F(SubmissionWorkerTest, givenBusyGpuWhenWorkerWaitsForSubmissionWindowThenGpuIdlenessIsPolledAtPollInterval) {
+    MockSubmissionWorker worker(*csr, DispatchMode::AdaptiveDispatch, true);
+    worker.queueDepth = 16;
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 1;
+
+    auto waitStart = std::chrono::high_resolution_clock::now();
+    worker.notifyWorkRecorded();
+    while (worker.isSubmissionWindowOpenCalled == 0) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    worker.closeThread();
+    auto waitTime = std::chrono::high_resolution_clock::now() - waitStart;
+
+    auto maxPolls = static_cast<uint32_t>(2 * (waitTime / SubmissionWorker::gpuIdlePollInterval) + 2);
+    EXPECT_LE(worker.isSubmissionWindowOpenCalled.load(), maxPolls);
+    EXPECT_EQ(0u, csr->flushBatchedSubmissionsCalled);
+}
+
+TEST_F(SubmissionWorkerTest, givenWorkerWaitingForBusyGpuWhenThreadIsClosedThenPendingWorkIsLeftForOwner) {
+    MockSubmissionWorker worker(*csr, DispatchMode::AdaptiveDispatch, true);
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 1;
+
+    worker.notifyWorkRecorded();
+    worker.closeThread();
+
+    EXPECT_FALSE(worker.allowProcess);
+    EXPECT_EQ(0u, csr->flushBatchedSubmissionsCalled);
+    EXPECT_EQ(1u, csr->peekBatchedCommandBuffersCount());
+}
+
+TEST_F(SubmissionWorkerTest, givenBatchedDispatchWithCounterModeAndIdleGpuWhenCounterLimitIsNotReachedThenSubmissionIsNotRequired) {
+    MockSubmissionWorker worker(*csr, DispatchMode::BatchedDispatchWithCounter);
+    worker.queueDepth = 2;
+    csr->batchedCommandBuffersCount = 1;
+    makeGpuIdle();
+
+    EXPECT_FALSE(worker.isSubmissionRequired());
+
+    csr->batchedCommandBuffersCount = 2;
+    EXPECT_TRUE(worker.isSubmissionRequired());
+}
+
+TEST_F(SubmissionWorkerTest, givenBatchedDispatchWithCounterModeWhenWorkIsRecordedThenWorkerFlushesItAfterDeadline) {
+    MockSubmissionWorker worker(*csr, DispatchMode::BatchedDispatchWithCounter, true);
+    worker.queueDepth = 16;
+    worker.maxSubmissionDelay = std::chrono::microseconds(100);
+    csr->batchedCommandBuffersCount = 1;
+
+    auto recordTime = std::chrono::high_resolution_clock::now();
+    worker.notifyWorkRecorded();
+    while (csr->flushBatchedSubmissionsCalled == 0) {
+        std::this_thread::yield();
+    }
+    auto flushTime = std::chrono::high_resolution_clock::now();
+    worker.closeThread();
+
+    EXPECT_EQ(1u, csr->flushBatchedSubmissionsCalled);
+    EXPECT_LE(worker.maxSubmissionDelay, flushTime - recordTime);
+}
+
+TEST_F(SubmissionWorkerTest, givenBatchedDispatchWithCounterModeAndWorkerWaitingForDeadlineWhenThreadIsClosedThenItDoesNotWaitForDeadline) {
+    MockSubmissionWorker worker(*csr, DispatchMode::BatchedDispatchWithCounter, true);
+    worker.maxSubmissionDelay = std::chrono::hours(1);
+    csr->batchedCommandBuffersCount = 1;
+
+    worker.notifyWorkRecorded();
+    worker.closeThread();
+
+    EXPECT_EQ(0u, csr->flushBatchedSubmissionsCalled);
+    EXPECT_EQ(nullptr, worker.thread.get());
+}
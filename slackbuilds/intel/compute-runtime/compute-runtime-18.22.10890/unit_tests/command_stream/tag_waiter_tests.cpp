@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_tag_waiter.h"
+#include "unit_tests/mocks/mock_csr.h"
+#include "test.h"
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct TagWaiterTest : public ::testing::Test {
+    void SetUp() override {
+        csr.reset(new MockCommandStreamReceiver());
+        csr->tagAddress = &tag;
+        tag = 1;
+    }
+
+    volatile uint32_t tag = 0;
+    std::unique_ptr<MockCommandStreamReceiver> csr;
+};
+
+TEST_F(TagWaiterTest, givenDebugVariablesSetWhenWaiterIsCreatedThenSpinTimeAndPollIntervalAreTakenFromThem) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.WaitSpinMicroseconds.set(30);
+    DebugManager.flags.WaitWatcherPollMicroseconds.set(7);
+
+    MockTagWaiter waiter(*csr);
+    EXPECT_EQ(30, waiter.peekSpinMicroseconds());
+    EXPECT_EQ(7, waiter.peekPollMicroseconds());
+}
+
+TEST_F(TagWaiterTest, givenDefaultSettingsWhenTagIsNotReachedThenWaiterSpinsWithoutParking) {
+    MockTagWaiter waiter(*csr);
+    EXPECT_EQ(-1, waiter.peekSpinMicroseconds());
+
+    EXPECT_FALSE(waiter.waitForTag(2, true, 200));
+    EXPECT_EQ(1u, waiter.spinCalled);
+    EXPECT_EQ(0u, waiter.parkCalled);
+    EXPECT_EQ(nullptr, waiter.thread.get());
+}
+
+TEST_F(TagWaiterTest, givenNonPositivePollIntervalWhenWaiterIsCreatedThenWatcherPollsEveryMicrosecond) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.WaitWatcherPollMicroseconds.set(0);
+
+    MockTagWaiter waiter(*csr);
+    EXPECT_EQ(1, waiter.peekPollMicroseconds());
+}
+
+TEST_F(TagWaiterTest, givenReachedTagWhenWaitingThenReturnTrueWithoutSpinningOrParking) {
+    MockTagWaiter waiter(*csr);
+
+    EXPECT_TRUE(waiter.waitForTag(1, false, 0));
+    EXPECT_EQ(0u, waiter.spinCalled);
+    EXPECT_EQ(0u, waiter.parkCalled);
+}
+
+TEST_F(TagWaiterTest, givenNegativeTimeoutWhenTagIsNotReachedThenReturnFalseWithoutWaiting) {
+    MockTagWaiter waiter(*csr);
+
+    EXPECT_FALSE(waiter.waitForTag(2, true, -1));
+    EXPECT_EQ(0u, waiter.spinCalled);
+    EXPECT_EQ(0u, waiter.parkCalled);
+}
+
+TEST_F(TagWaiterTest, givenTimeoutShorterThanSpinTimeWhenTagIsNotReachedThenWaiterOnlySpins) {
+    MockTagWaiter waiter(*csr);
+    waiter.spinTime = std::chrono::microseconds(1000);
+
+    EXPECT_FALSE(waiter.waitForTag(2, true, 10));
+    EXPECT_EQ(1u, waiter.spinCalled);
+    EXPECT_EQ(0u, waiter.parkCalled);
+    EXPECT_EQ(nullptr, waiter.thread.get());
+}
+
+TEST_F(TagWaiterTest, givenNegativeSpinTimeWhenTagIsNotReachedThenWaiterNeverParks) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.WaitSpinMicroseconds.set(-1);
+
+    MockTagWaiter waiter(*csr);
+    EXPECT_FALSE(waiter.waitForTag(2, true, 200));
+    EXPECT_EQ(1u, waiter.spinCalled);
+    EXPECT_EQ(0u, waiter.parkCalled);
+}
+
+TEST_F(TagWaiterTest, givenTimeoutLongerThanSpinTimeWhenTagIsNotReachedThenWaiterParksUntilTimeout) {
+    MockTagWaiter waiter(*csr);
+    waiter.spinTime = std::chrono::microseconds(0);
+
+    auto waitStart = std::chrono::high_resolution_clock::now();
+    EXPECT_FALSE(waiter.waitForTag(2, true, 1000));
+    auto waitEnd = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(1u, waiter.spinCalled);
+    EXPECT_EQ(1u, waiter.parkCalled);
+    EXPECT_EQ(1u, waiter.openThreadCalled);
+    EXPECT_EQ(0u, waiter.parkedWaiters);
+    EXPECT_LE(std::chrono::microseconds(1000), waitEnd - waitStart);
+}
+
+TEST_F(TagWaiterTest, givenParkedWaitersWhenTagIsUpdatedThenWatcherWakesAllOfThem) {
+    MockTagWaiter waiter(*csr);
+    waiter.spinTime = std::chrono::microseconds(0);
+    const uint32_t waitersCount = 4;
+
+    std::atomic<uint32_t> tagsReached{0};
+    std::vector<std::thread> waiters;
+    for (uint32_t i = 0; i < waitersCount; i++) {
+        waiters.push_back(std::thread([&]() {
+            if (waiter.waitForTag(2, false, 0)) {
+                tagsReached++;
+            }
+        }));
+    }
+    while (waiter.parkedWaiters != waitersCount) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(0u, tagsReached);
+
+    tag = 2;
+    for (auto &thread : waiters) {
+        thread.join();
+    }
+
+    EXPECT_EQ(waitersCount, tagsReached);
+    EXPECT_EQ(0u, waiter.parkedWaiters);
+    EXPECT_NE(nullptr, waiter.thread.get());
+
+    waiter.closeThread();
+    EXPECT_FALSE(waiter.allowProcess);
+    EXPECT_EQ(nullptr, waiter.thread.get());
+}
+
+TEST_F(TagWaiterTest, givenParkedWaitersWithDifferentTaskCountsWhenTagReachesOnlyOneOfThemThenOtherStaysParked) {
+    MockTagWaiter waiter(*csr);
+    waiter.spinTime = std::chrono::microseconds(0);
+
+    std::atomic<bool> firstReached{false};
+    std::atomic<bool> secondReached{false};
+    std::thread first([&]() { firstReached = waiter.waitForTag(2, false, 0); });
+    std::thread second([&]() { secondReached = waiter.waitForTag(3, false, 0); });
+    while (waiter.parkedWaiters != 2) {
+        std::this_thread::yield();
+    }
+
+    tag = 2;
+    first.join();
+    EXPECT_TRUE(firstReached);
+    EXPECT_FALSE(secondReached);
+
+    tag = 3;
+    second.join();
+    EXPECT_TRUE(secondReached);
+}
+
+TEST_F(TagWaiterTest, givenCsrWhenWaitingForCompletionThenTagWaiterIsUsed) {
+    EXPECT_NE(nullptr, csr->tagWaiter.get());
+    EXPECT_TRUE(csr->waitForCompletionWithTimeout(false, 0, 1));
+    EXPECT_FALSE(csr->waitForCompletionWithTimeout(true, 1, 2));
+}
@@ -26,6 +26,10 @@
 #include "runtime/compiler_interface/compiler_interface.h"
 #include <runtime/helpers/string.h>
 #include <runtime/helpers/aligned_memory.h>
+#include <runtime/helpers/file_io.h>
+#include <runtime/os_interface/debug_settings_manager.h>
+#include <runtime/utilities/directory.h>
+#include <unit_tests/helpers/debug_manager_state_restore.h>
 #include <unit_tests/global_environment.h>
 #include <unit_tests/fixtures/device_fixture.h>
 #include <unit_tests/mocks/mock_context.h>
@@ -33,6 +37,7 @@
 
 #include <memory>
 #include <array>
+#include <limits>
 #include <list>
 
 #include "test.h"
@@ -99,6 +104,19 @@ class BinaryCacheMock : public BinaryCache {
     bool loadResult = false;
 };
 
+class MockBinaryCache : public BinaryCache {
+  public:
+    using BinaryCache::cacheDirectorySize;
+    using BinaryCache::directoryRescanInterval;
+    using BinaryCache::getCacheFilePath;
+    using BinaryCache::lruIndex;
+    using BinaryCache::maxCacheDirectorySize;
+    using BinaryCache::maxEntriesInMemory;
+    using BinaryCache::staleTempFileAgeInSeconds;
+    using BinaryCache::trimCacheDirectory;
+    using BinaryCache::writesSinceDirectoryScan;
+};
+
 class CompilerInterfaceCachedFixture : public DeviceFixture {
   public:
     void SetUp() {
@@ -342,6 +360,174 @@ TEST_F(BinaryCacheTests, cacheThenLoad) {
     EXPECT_TRUE(ret);
 }
 
+TEST(BinaryCacheLru, givenDebugVariablesWhenCacheIsCreatedThenLimitsAreTakenFromThem) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.BinaryCacheMaxEntriesInMemory.set(3);
+    DebugManager.flags.BinaryCacheMaxSizeMB.set(2);
+
+    MockBinaryCache cache;
+    EXPECT_EQ(3u, cache.maxEntriesInMemory);
+    EXPECT_EQ(2u * 1024u * 1024u, cache.maxCacheDirectorySize);
+}
+
+TEST(BinaryCacheLru, givenCachedBinaryWhenFileIsRemovedThenItIsStillLoadedFromMemory) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 4;
+    MockProgram program;
+    const char binary[] = "in memory binary";
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_0", binary, sizeof(binary)));
+    std::remove(cache.getCacheFilePath("LRU_HASH_0").c_str());
+
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_0", program));
+    size_t genBinarySize = 0;
+    auto genBinary = program.getGenBinary(genBinarySize);
+    ASSERT_EQ(sizeof(binary), genBinarySize);
+    EXPECT_EQ(0, memcmp(binary, genBinary, genBinarySize));
+}
+
+TEST(BinaryCacheLru, givenCachedBinaryWhenLoadedByManyProgramsThenAllShareOneMapping) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 4;
+    MockProgram program1;
+    MockProgram program2;
+    const char binary[] = "shared binary";
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_SHARED", binary, sizeof(binary)));
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_SHARED", program1));
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_SHARED", program2));
+
+    size_t genBinarySize1 = 0;
+    size_t genBinarySize2 = 0;
+    auto genBinary1 = program1.getGenBinary(genBinarySize1);
+    auto genBinary2 = program2.getGenBinary(genBinarySize2);
+    EXPECT_EQ(genBinary1, genBinary2);
+    EXPECT_EQ(sizeof(binary), genBinarySize1);
+    EXPECT_EQ(0, memcmp(binary, genBinary1, genBinarySize1));
+}
+
+TEST(BinaryCacheLru, givenMappedBinaryDroppedFromCacheWhenProgramStillUsesItThenMappingStaysValid) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 1;
+    MockProgram program;
+    const char binary[] = "first binary";
+    const char otherBinary[] = "second binary";
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_FIRST", binary, sizeof(binary)));
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_FIRST", program));
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_SECOND", otherBinary, sizeof(otherBinary)));
+    EXPECT_EQ(cache.lruIndex.end(), cache.lruIndex.find("LRU_HASH_FIRST"));
+
+    size_t genBinarySize = 0;
+    auto genBinary = program.getGenBinary(genBinarySize);
+    ASSERT_EQ(sizeof(binary), genBinarySize);
+    EXPECT_EQ(0, memcmp(binary, genBinary, genBinarySize));
+}
+
+TEST(BinaryCacheLru, givenFullMemoryTierWhenNewBinaryIsCachedThenLeastRecentlyUsedIsDropped) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 2;
+    MockProgram program;
+    const char binary[] = "binary";
+
+    cache.cacheBinary("LRU_HASH_A", binary, sizeof(binary));
+    cache.cacheBinary("LRU_HASH_B", binary, sizeof(binary));
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_A", program));
+    cache.cacheBinary("LRU_HASH_C", binary, sizeof(binary));
+
+    EXPECT_EQ(2u, cache.lruIndex.size());
+    EXPECT_NE(cache.lruIndex.end(), cache.lruIndex.find("LRU_HASH_A"));
+    EXPECT_EQ(cache.lruIndex.end(), cache.lruIndex.find("LRU_HASH_B"));
+    EXPECT_NE(cache.lruIndex.end(), cache.lruIndex.find("LRU_HASH_C"));
+}
+
+TEST(BinaryCacheLru, givenBinaryNotInMemoryWhenLoadedFromDiskThenItIsAddedToMemoryTier) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 0;
+    const char binary[] = "on disk binary";
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_DISK", binary, sizeof(binary)));
+    EXPECT_TRUE(fileExistsHasSize(cache.getCacheFilePath("LRU_HASH_DISK")));
+    EXPECT_TRUE(cache.lruIndex.empty());
+
+    MockProgram program;
+    cache.maxEntriesInMemory = 1;
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_DISK", program));
+    EXPECT_NE(cache.lruIndex.end(), cache.lruIndex.find("LRU_HASH_DISK"));
+}
+
+TEST(BinaryCacheLru, givenDirectorySizeLimitWhenItIsExceededThenOldestBinariesAreEvicted) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 0;
+    cache.maxCacheDirectorySize = 1;
+    MockProgram program;
+    const char binary[] = "binary bigger than limit";
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_EVICTED", binary, sizeof(binary)));
+    EXPECT_FALSE(fileExists(cache.getCacheFilePath("LRU_HASH_EVICTED")));
+    EXPECT_FALSE(cache.loadCachedBinary("LRU_HASH_EVICTED", program));
+}
+
+TEST(BinaryCacheLru, givenDirectorySizeLimitWhenItIsExceededThenLeastRecentlyAccessedBinariesAreEvicted) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 0;
+    cache.maxCacheDirectorySize = std::numeric_limits<uint64_t>::max();
+    MockProgram program;
+    const char binary[] = "binary";
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_USED", binary, sizeof(binary)));
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_UNUSED", binary, sizeof(binary)));
+    EXPECT_TRUE(Directory::setFileTimes(cache.getCacheFilePath("LRU_HASH_USED"), 0, 1));
+    EXPECT_TRUE(Directory::setFileTimes(cache.getCacheFilePath("LRU_HASH_UNUSED"), 0, 1));
+    EXPECT_TRUE(cache.loadCachedBinary("LRU_HASH_USED", program));
+
+    cache.writesSinceDirectoryScan = cache.directoryRescanInterval;
+    cache.trimCacheDirectory(0);
+    cache.maxCacheDirectorySize = cache.cacheDirectorySize + sizeof(binary) - 1;
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_NEWEST", binary, sizeof(binary)));
+
+    EXPECT_FALSE(fileExists(cache.getCacheFilePath("LRU_HASH_UNUSED")));
+    EXPECT_TRUE(fileExists(cache.getCacheFilePath("LRU_HASH_USED")));
+    EXPECT_TRUE(fileExists(cache.getCacheFilePath("LRU_HASH_NEWEST")));
+    std::remove(cache.getCacheFilePath("LRU_HASH_USED").c_str());
+    std::remove(cache.getCacheFilePath("LRU_HASH_NEWEST").c_str());
+}
+
+TEST(BinaryCacheLru, givenDirectorySizeBelowLimitWhenBinaryIsCachedThenDirectoryIsScannedOnlyPeriodically) {
+    MockBinaryCache cache;
+    cache.maxEntriesInMemory = 0;
+    cache.maxCacheDirectorySize = std::numeric_limits<uint64_t>::max();
+    const char binary[] = "binary";
+    std::string staleTempFile = cache.getCacheFilePath("LRU_HASH_STALE") + ".tmp";
+
+    cache.writesSinceDirectoryScan = 0;
+    cache.cacheDirectorySize = 0;
+    ASSERT_NE(0u, writeDataToFile(staleTempFile.c_str(), binary, sizeof(binary)));
+    EXPECT_TRUE(Directory::setFileTimes(staleTempFile, 1, 1));
+
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_PERIODIC", binary, sizeof(binary)));
+    EXPECT_EQ(sizeof(binary), cache.cacheDirectorySize.load());
+    EXPECT_TRUE(fileExists(staleTempFile));
+
+    cache.writesSinceDirectoryScan = cache.directoryRescanInterval - 1;
+    EXPECT_TRUE(cache.cacheBinary("LRU_HASH_PERIODIC", binary, sizeof(binary)));
+    EXPECT_EQ(0u, cache.writesSinceDirectoryScan.load());
+    EXPECT_FALSE(fileExists(staleTempFile));
+    std::remove(cache.getCacheFilePath("LRU_HASH_PERIODIC").c_str());
+}
+
+TEST(BinaryCacheLru, givenTempFileBeingWrittenWhenDirectoryIsScannedThenItIsNotRemoved) {
+    MockBinaryCache cache;
+    cache.maxCacheDirectorySize = std::numeric_limits<uint64_t>::max();
+    const char binary[] = "binary";
+    std::string tempFile = cache.getCacheFilePath("LRU_HASH_IN_FLIGHT") + ".tmp";
+    ASSERT_NE(0u, writeDataToFile(tempFile.c_str(), binary, sizeof(binary)));
+
+    cache.writesSinceDirectoryScan = cache.directoryRescanInterval;
+    cache.trimCacheDirectory(0);
+    EXPECT_TRUE(fileExists(tempFile));
+    std::remove(tempFile.c_str());
+}
+
 TEST_F(CompilerInterfaceCachedTests, canInjectCache) {
     std::unique_ptr<BinaryCache> cache(new BinaryCache());
     auto res1 = pCompilerInterface->replaceBinaryCache(cache.get());
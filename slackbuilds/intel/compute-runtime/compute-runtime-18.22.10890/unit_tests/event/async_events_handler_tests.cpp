@@ -24,8 +24,11 @@
 #include "runtime/event/event.h"
 #include "runtime/event/user_event.h"
 #include "runtime/platform/platform.h"
+#include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_async_event_handler.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
 #include "test.h"
 #include "gmock/gmock.h"
 
@@ -380,3 +383,139 @@ TEST_F(AsyncEventsHandlerTests, asyncProcessCallsProcessListBeforeReturning) {
 
     event->release();
 }
+
+class AsyncEventsHandlerCompletionHeapTests : public AsyncEventsHandlerTests {
+  public:
+    class CountingEvent : public Event {
+      public:
+        CountingEvent(CommandQueue *cmdQueue, uint32_t taskCount)
+            : Event(cmdQueue, CL_COMMAND_NDRANGE_KERNEL, 0, taskCount) {}
+        void updateExecutionStatus() override {
+            updateCount++;
+            Event::updateExecutionStatus();
+        }
+        uint32_t updateCount = 0;
+    };
+
+    void SetUp() override {
+        AsyncEventsHandlerTests::SetUp();
+        device.reset(DeviceHelper<>::create());
+        context.reset(new MockContext());
+        cmdQueue.reset(new MockCommandQueue(context.get(), device.get(), nullptr));
+        *device->getTagAddress() = 0;
+    }
+
+    void TearDown() override {
+        cmdQueue.reset();
+        context.reset();
+        device.reset();
+        AsyncEventsHandlerTests::TearDown();
+    }
+
+    CountingEvent *createEventWithCallback(uint32_t taskCount) {
+        auto event = new CountingEvent(cmdQueue.get(), taskCount);
+        event->addCallback(&this->callbackFcn, CL_COMPLETE, &counter);
+        event->updateCount = 0;
+        return event;
+    }
+
+    std::unique_ptr<Device> device;
+    std::unique_ptr<MockContext> context;
+    std::unique_ptr<MockCommandQueue> cmdQueue;
+};
+
+TEST_F(AsyncEventsHandlerCompletionHeapTests, givenSubmittedEventsWhenListIsProcessedThenTheyAreMovedToCompletionHeap) {
+    auto event = createEventWithCallback(2);
+    handler->registerEvent(event);
+
+    handler->process();
+    EXPECT_EQ(1u, event->updateCount);
+    EXPECT_EQ(CL_SUBMITTED, event->peekExecutionStatus());
+    ASSERT_EQ(1u, handler->completionHeaps.size());
+    EXPECT_EQ(device->getTagAddress(), handler->completionHeaps[0].tagAddress);
+    EXPECT_EQ(1u, handler->completionHeaps[0].entries.size());
+
+    *device->getTagAddress() = 2;
+    handler->process();
+    EXPECT_EQ(CL_COMPLETE, event->peekExecutionStatus());
+    EXPECT_EQ(1, counter);
+    EXPECT_TRUE(handler->peekIsListEmpty());
+
+    event->release();
+}
+
+TEST_F(AsyncEventsHandlerCompletionHeapTests, givenEventsInCompletionHeapWhenTagAdvancesThenOnlyEventsPassedByTagAreUpdated) {
+    const uint32_t eventsCount = 8;
+    CountingEvent *events[eventsCount];
+    // registered in reversed order, heap orders them by task count
+    for (uint32_t i = eventsCount; i > 0; i--) {
+        events[i - 1] = createEventWithCallback(i);
+        handler->registerEvent(events[i - 1]);
+    }
+    handler->process();
+
+    handler->process();
+    for (auto event : events) {
+        EXPECT_EQ(1u, event->updateCount);
+    }
+
+    *device->getTagAddress() = 3;
+    auto sleepCandidate = handler->process();
+    for (uint32_t i = 0; i < eventsCount; i++) {
+        EXPECT_EQ(i < 3 ? 2u : 1u, events[i]->updateCount);
+    }
+    EXPECT_EQ(3, counter);
+    EXPECT_EQ(events[3], sleepCandidate);
+
+    *device->getTagAddress() = eventsCount;
+    EXPECT_EQ(nullptr, handler->process());
+    EXPECT_EQ(static_cast<int>(eventsCount), counter);
+    EXPECT_TRUE(handler->peekIsListEmpty());
+
+    for (auto event : events) {
+        event->release();
+    }
+}
+
+TEST_F(AsyncEventsHandlerCompletionHeapTests, givenEventsInCompletionHeapAndNotReadyEventWhenProcessedThenOnlyNotReadyEventIsRescanned) {
+    auto submittedEvent = createEventWithCallback(2);
+    auto notReadyEvent = new CountingEvent(cmdQueue.get(), Event::eventNotReady);
+    notReadyEvent->taskLevel.store(Event::eventNotReady);
+    notReadyEvent->addCallback(&this->callbackFcn, CL_COMPLETE, &counter);
+    notReadyEvent->updateCount = 0;
+
+    handler->registerEvent(submittedEvent);
+    handler->registerEvent(notReadyEvent);
+    auto sleepCandidate = handler->process();
+    handler->process();
+
+    EXPECT_EQ(submittedEvent, sleepCandidate);
+    EXPECT_EQ(1u, submittedEvent->updateCount);
+    EXPECT_EQ(2u, notReadyEvent->updateCount);
+    EXPECT_FALSE(handler->peekIsListEmpty());
+
+    *device->getTagAddress() = 2;
+    notReadyEvent->setStatus(CL_COMPLETE);
+    handler->process();
+    EXPECT_EQ(2, counter);
+    EXPECT_TRUE(handler->peekIsListEmpty());
+
+    submittedEvent->release();
+    notReadyEvent->release();
+}
+
+TEST_F(AsyncEventsHandlerCompletionHeapTests, givenEventsInCompletionHeapWhenAsyncExecutionInterruptedThenUnreferenceAll) {
+    auto event = createEventWithCallback(2);
+    handler->registerEvent(event);
+    handler->process();
+    EXPECT_EQ(3, event->getRefInternalCount());
+
+    handler->allowAsyncProcess.store(false);
+    MockHandler::asyncProcess(reinterpret_cast<void *>(handler.get()));
+    EXPECT_EQ(2, event->getRefInternalCount());
+    EXPECT_TRUE(handler->peekIsListEmpty());
+
+    *device->getTagAddress() = 2;
+    event->updateExecutionStatus();
+    event->release();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/stream_copy.h"
+#include "runtime/utilities/cpu_info.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace OCLRT;
+
+typedef void (*StreamCopyFunction)(void *dst, const void *src, size_t size);
+
+struct StreamCopyTest : public ::testing::TestWithParam<StreamCopyFunction> {
+    void SetUp() override {
+        if (GetParam() == streamCopyAvx2 && !CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX2)) {
+            skip = true;
+        }
+        for (size_t i = 0; i < sizeof(src); i++) {
+            src[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+    }
+
+    bool skip = false;
+    alignas(64) uint8_t src[512];
+    alignas(64) uint8_t dst[512 + 64];
+};
+
+TEST_P(StreamCopyTest, givenAnySizeAndDestinationMisalignmentWhenCopiedThenOnlyRequestedBytesAreWritten) {
+    if (skip) {
+        return;
+    }
+    const size_t sizes[] = {0, 1, 15, 16, 31, 32, 33, 64, 100, 256, 511};
+    for (size_t dstOffset = 0; dstOffset < 40; dstOffset += 3) {
+        for (auto size : sizes) {
+            memset(dst, 0xCD, sizeof(dst));
+            GetParam()(dst + dstOffset, src + 1, size);
+
+            EXPECT_EQ(0, memcmp(dst + dstOffset, src + 1, size)) << "offset " << dstOffset << " size " << size;
+            for (size_t i = 0; i < dstOffset; i++) {
+                EXPECT_EQ(0xCD, dst[i]);
+            }
+            for (size_t i = dstOffset + size; i < sizeof(dst); i++) {
+                EXPECT_EQ(0xCD, dst[i]);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(StreamCopy,
+                        StreamCopyTest,
+                        ::testing::Values(streamCopySse4, streamCopyAvx2));
+
+TEST(StreamCopyHelper, givenCpuWithAvx2WhenHelperIsInitializedThenAvx2CopyIsSelected) {
+    bool supportsAVX2 = CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX2);
+    EXPECT_EQ(supportsAVX2 ? streamCopyAvx2 : streamCopySse4, StreamCopyHelper::copy);
+}
+
+TEST(StreamCopy, givenSizesAroundThresholdWhenStreamCopyIsCalledThenDataIsCopied) {
+    std::vector<uint8_t> src(2 * streamCopyMinSize);
+    std::vector<uint8_t> dst(2 * streamCopyMinSize);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<uint8_t>(i * 5 + 1);
+    }
+    for (auto size : {streamCopyMinSize - 1, streamCopyMinSize, 2 * streamCopyMinSize}) {
+        std::fill(dst.begin(), dst.end(), static_cast<uint8_t>(0));
+        streamCopy(dst.data(), src.data(), size);
+        EXPECT_EQ(0, memcmp(dst.data(), src.data(), size)) << "size " << size;
+    }
+}
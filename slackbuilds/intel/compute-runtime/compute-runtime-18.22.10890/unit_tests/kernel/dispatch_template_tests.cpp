@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/kernel/dispatch_template.h"
+#include "test.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace OCLRT;
+
+namespace {
+struct TestCommand {
+    uint32_t dwords[15];
+};
+
+WalkerTemplateKey createKey(uint64_t value) {
+    WalkerTemplateKey key = {};
+    key.localWorkSize[0] = value;
+    key.simd = 32;
+    return key;
+}
+
+TestCommand createCommand(uint32_t value) {
+    TestCommand cmd;
+    for (auto &dword : cmd.dwords) {
+        dword = value;
+    }
+    return cmd;
+}
+} // namespace
+
+TEST(CommandTemplateTest, givenNothingRecordedWhenLookupIsCalledThenItMisses) {
+    CommandTemplate<WalkerTemplateKey> commandTemplate;
+    TestCommand cmd = createCommand(0);
+    EXPECT_FALSE(commandTemplate.peekRecorded());
+    EXPECT_FALSE(commandTemplate.lookup(createKey(1), cmd));
+}
+
+TEST(CommandTemplateTest, givenRecordedCommandWhenLookupIsCalledWithSameKeyThenCommandIsCopied) {
+    CommandTemplate<WalkerTemplateKey> commandTemplate;
+    commandTemplate.record(createKey(1), createCommand(7));
+    EXPECT_TRUE(commandTemplate.peekRecorded());
+
+    TestCommand cmd = createCommand(0);
+    TestCommand expectedCmd = createCommand(7);
+    EXPECT_TRUE(commandTemplate.lookup(createKey(1), cmd));
+    EXPECT_EQ(0, memcmp(&expectedCmd, &cmd, sizeof(TestCommand)));
+
+    EXPECT_FALSE(commandTemplate.lookup(createKey(2), cmd));
+}
+
+TEST(CommandTemplateTest, givenInvalidatedTemplateWhenLookupIsCalledThenItMisses) {
+    CommandTemplate<WalkerTemplateKey> commandTemplate;
+    commandTemplate.record(createKey(1), createCommand(7));
+    commandTemplate.invalidate();
+
+    TestCommand cmd = createCommand(0);
+    EXPECT_FALSE(commandTemplate.peekRecorded());
+    EXPECT_FALSE(commandTemplate.lookup(createKey(1), cmd));
+}
+
+TEST(CommandTemplateTest, givenConcurrentRecordWhenLookupHitsThenKeyAndCommandAreFromSameRecord) {
+    CommandTemplate<WalkerTemplateKey> commandTemplate;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> tornReads{0};
+
+    std::thread recorder([&]() {
+        for (uint32_t i = 0; i < 100000; i++) {
+            uint32_t value = 1 + (i % 2);
+            commandTemplate.record(createKey(value), createCommand(value));
+        }
+        done = true;
+    });
+
+    while (!done) {
+        for (uint32_t value = 1; value <= 2; value++) {
+            TestCommand cmd = createCommand(0);
+            if (commandTemplate.lookup(createKey(value), cmd)) {
+                for (auto dword : cmd.dwords) {
+                    if (dword != value) {
+                        tornReads++;
+                    }
+                }
+            }
+        }
+    }
+    recorder.join();
+    EXPECT_EQ(0u, tornReads);
+}
@@ -299,7 +299,7 @@ TEST_F(MemoryAllocatorTest, addAllocationToReuseList) {
     auto allocation = memoryManager->allocateGraphicsMemory(1, host_ptr);
 
     memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
-    EXPECT_EQ(allocation, memoryManager->allocationsForReuse.peekHead());
+    EXPECT_TRUE(memoryManager->allocationsForReuse.peekContains(*allocation));
 }
 
 TEST_F(MemoryAllocatorTest, givenDebugFlagThatDisablesAllocationReuseWhenApiIsCalledThenAllocationIsReleased) {
@@ -309,7 +309,7 @@ TEST_F(MemoryAllocatorTest, givenDebugFlagThatDisablesAllocationReuseWhenApiIsCa
     auto allocation = memoryManager->allocateGraphicsMemory(1, host_ptr);
 
     memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
-    EXPECT_NE(allocation, memoryManager->allocationsForReuse.peekHead());
+    EXPECT_NE(allocation, memoryManager->allocationsForReuse.getBucket(0).peekHead());
     EXPECT_TRUE(memoryManager->allocationsForReuse.peekIsEmpty());
     DebugManager.flags.DisableResourceRecycling.set(false);
 }
@@ -435,6 +435,87 @@ TEST_F(MemoryAllocatorTest, givenInternalAllocationWhenItIsPutOnReusableListWhen
     memoryManager->freeGraphicsMemory(allocation);
 }
 
+TEST_F(MemoryAllocatorTest, givenAllocationsOfDifferentSizesOnReusableListWhenAllocationIsObtainedThenSmallestFittingOneIsReturned) {
+    auto allocation64k = memoryManager->allocateGraphicsMemory(64 * 1024, 4096);
+    auto allocation16k = memoryManager->allocateGraphicsMemory(16 * 1024, 4096);
+    auto allocation32k = memoryManager->allocateGraphicsMemory(32 * 1024, 4096);
+
+    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation64k), REUSABLE_ALLOCATION);
+    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation16k), REUSABLE_ALLOCATION);
+    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation32k), REUSABLE_ALLOCATION);
+    EXPECT_EQ(112u * 1024, memoryManager->allocationsForReuse.peekRetainedSize());
+
+    auto reusableAllocation = memoryManager->obtainReusableAllocation(20000, false);
+    EXPECT_EQ(allocation32k, reusableAllocation.get());
+    EXPECT_EQ(80u * 1024, memoryManager->allocationsForReuse.peekRetainedSize());
+
+    auto reusableAllocation2 = memoryManager->obtainReusableAllocation(16 * 1024, false);
+    EXPECT_EQ(allocation16k, reusableAllocation2.get());
+    EXPECT_EQ(64u * 1024, memoryManager->allocationsForReuse.peekRetainedSize());
+
+    memoryManager->freeGraphicsMemory(reusableAllocation.release());
+    memoryManager->freeGraphicsMemory(reusableAllocation2.release());
+}
+
+TEST_F(MemoryAllocatorTest, givenRetainedSizeLimitWhenReusableAllocationIsStoredOverTheLimitThenCompletedAllocationsAreReleased) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ReusableAllocationsMaxRetainedSizeMB.set(0);
+
+    auto allocation = memoryManager->allocateGraphicsMemory(4096, 4096);
+    memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
+
+    EXPECT_TRUE(memoryManager->allocationsForReuse.peekIsEmpty());
+    EXPECT_EQ(0u, memoryManager->allocationsForReuse.peekRetainedSize());
+}
+
+TEST_F(MemoryAllocatorTest, givenReusableAllocationsWhenTrimIsCalledThenAllocationsAreReleasedDownToRequestedSize) {
+    for (int i = 0; i < 4; i++) {
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(memoryManager->allocateGraphicsMemory(4096, 4096)), REUSABLE_ALLOCATION);
+    }
+    EXPECT_EQ(4 * 4096u, memoryManager->allocationsForReuse.peekRetainedSize());
+
+    memoryManager->trimReusableAllocations(2 * 4096);
+    EXPECT_EQ(2 * 4096u, memoryManager->allocationsForReuse.peekRetainedSize());
+    EXPECT_FALSE(memoryManager->allocationsForReuse.peekIsEmpty());
+
+    memoryManager->trimReusableAllocations(0);
+    EXPECT_EQ(0u, memoryManager->allocationsForReuse.peekRetainedSize());
+    EXPECT_TRUE(memoryManager->allocationsForReuse.peekIsEmpty());
+}
+
+TEST(ReusableAllocationsPoolTest, givenSizeWhenBucketIndexIsQueriedThenPowerOfTwoPageClassIsReturned) {
+    EXPECT_EQ(0u, ReusableAllocationsPool::getBucketIndex(1));
+    EXPECT_EQ(0u, ReusableAllocationsPool::getBucketIndex(MemoryConstants::pageSize));
+    EXPECT_EQ(1u, ReusableAllocationsPool::getBucketIndex(2 * MemoryConstants::pageSize));
+    EXPECT_EQ(1u, ReusableAllocationsPool::getBucketIndex(4 * MemoryConstants::pageSize - 1));
+    EXPECT_EQ(2u, ReusableAllocationsPool::getBucketIndex(4 * MemoryConstants::pageSize));
+    EXPECT_EQ(ReusableAllocationsPool::bucketsCount - 1, ReusableAllocationsPool::getBucketIndex(static_cast<size_t>(MemoryConstants::gigaByte)));
+}
+
+TEST(ReusableAllocationsPoolTest, givenAllocationsStillUsedByGpuWhenCompletedAllocationsAreDetachedThenOnlyCompletedOnesAreReturned) {
+    ReusableAllocationsPool pool;
+    volatile uint32_t tag = 5;
+    GraphicsAllocation busy(nullptr, 8 * MemoryConstants::pageSize);
+    GraphicsAllocation completed(nullptr, MemoryConstants::pageSize);
+    busy.taskCount = 10;
+    completed.taskCount = 2;
+    pool.pushAllocation(busy);
+    pool.pushAllocation(completed);
+
+    auto detached = pool.detachCompletedAllocations(0, &tag);
+    EXPECT_EQ(&completed, detached);
+    EXPECT_EQ(nullptr, detached->next);
+    EXPECT_TRUE(pool.peekContains(busy));
+    EXPECT_EQ(busy.getUnderlyingBufferSize(), pool.peekRetainedSize());
+
+    EXPECT_EQ(nullptr, pool.detachAllocation(1, &tag, false));
+    tag = 11;
+    auto reused = pool.detachAllocation(1, &tag, false);
+    EXPECT_EQ(&busy, reused.get());
+    EXPECT_TRUE(pool.peekIsEmpty());
+    reused.release();
+}
+
 TEST_F(MemoryAllocatorTest, AlignedHostPtrWithAlignedSizeWhenAskedForGraphicsAllocationReturnsNullStorageFromHostPtrManager) {
     auto ptr = (void *)0x1000;
     auto graphicsAllocation = memoryManager->allocateGraphicsMemory(4096, ptr);
@@ -574,6 +655,22 @@ TEST_F(MemoryAllocatorTest, getEventPerfCountAllocator) {
     EXPECT_EQ(allocator2, allocator);
 }
 
+TEST_F(MemoryAllocatorTest, givenConcurrentCallersWhenTagAllocatorsAreRequestedThenAllCallersGetTheSameAllocators) {
+    const size_t callerCount = 4;
+    std::vector<std::future<std::pair<TagAllocator<HwTimeStamps> *, TagAllocator<HwPerfCounter> *>>> callers;
+    for (size_t i = 0; i < callerCount; i++) {
+        callers.push_back(std::async(std::launch::async, [this]() {
+            return std::make_pair(memoryManager->getEventTsAllocator(), memoryManager->getEventPerfCountAllocator());
+        }));
+    }
+
+    for (auto &caller : callers) {
+        auto allocators = caller.get();
+        EXPECT_EQ(memoryManager->getEventTsAllocator(), allocators.first);
+        EXPECT_EQ(memoryManager->getEventPerfCountAllocator(), allocators.second);
+    }
+}
+
 TEST_F(MemoryAllocatorTest, givenMemoryManagerWhensetForce32BitAllocationsIsCalledWithTrueMutlipleTimesThenAllocatorIsReused) {
     memoryManager->setForce32BitAllocations(true);
     EXPECT_NE(nullptr, memoryManager->allocator32Bit.get());
@@ -27,6 +27,7 @@
 #include "unit_tests/helpers/memory_management.h"
 
 #include <memory>
+#include <vector>
 
 using namespace OCLRT;
 
@@ -146,6 +147,79 @@ TEST_F(PageTableTests48, pageWalkSimple) {
     EXPECT_EQ(lSize, walked);
 }
 
+TEST_F(PageTableTests48, givenFreshMappingWhenPagesAreWalkedAsRangesThenSingleContiguousRangeIsReported) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr + (8 * pageSize) + 0x10;
+    size_t lSize = 8 * pageSize;
+
+    std::vector<std::pair<uint64_t, size_t>> ranges;
+    pageTable->pageWalkRanges(addr1, lSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        EXPECT_EQ(0u, offset);
+        ranges.push_back({physAddress, size});
+    });
+
+    ASSERT_EQ(1u, ranges.size());
+    EXPECT_EQ(startAddress + 0x10, ranges[0].first);
+    EXPECT_EQ(lSize, ranges[0].second);
+    EXPECT_EQ(PTE::initialPage + 9u, this->getNextPage());
+}
+
+TEST_F(PageTableTests48, givenRangeCrossingLargePageBoundaryWhenPagesAreWalkedAsRangesThenRangeIsSplitAtBoundary) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr + (510 * pageSize);
+    size_t lSize = 4 * pageSize;
+
+    size_t walked = 0u;
+    std::vector<size_t> sizes;
+    pageTable->pageWalkRanges(addr1, lSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        EXPECT_EQ(walked, offset);
+        walked += size;
+        sizes.push_back(size);
+    });
+
+    ASSERT_EQ(2u, sizes.size());
+    EXPECT_EQ(2 * pageSize, sizes[0]);
+    EXPECT_EQ(2 * pageSize, sizes[1]);
+}
+
+TEST_F(PageTableTests48, givenPhysicallyDiscontiguousPagesWhenPagesAreWalkedAsRangesThenEachContiguousRunIsReported) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr;
+
+    pageTable->map(addr1 + pageSize, pageSize);
+
+    std::vector<std::pair<uint64_t, size_t>> ranges;
+    pageTable->pageWalkRanges(addr1, 3 * pageSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        ranges.push_back({physAddress, size});
+    });
+
+    ASSERT_EQ(3u, ranges.size());
+    EXPECT_EQ(startAddress + pageSize, ranges[0].first);
+    EXPECT_EQ(startAddress, ranges[1].first);
+    EXPECT_EQ(startAddress + 2 * pageSize, ranges[2].first);
+}
+
+TEST_F(PageTableTests48, givenWalkedRangesWhenComparedWithPageWalkThenSamePhysicalPagesAreCovered) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr + (500 * pageSize) + 0x123;
+    size_t lSize = 40 * pageSize;
+
+    std::vector<uint64_t> pages;
+    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        pages.push_back(physAddress);
+    };
+    pageTable->pageWalk(addr1, lSize, 0, walker);
+
+    std::vector<uint64_t> pagesFromRanges;
+    pageTable->pageWalkRanges(addr1, lSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        auto end = physAddress + size;
+        for (auto address = physAddress; address < end; address = (address & ~(pageSize - 1)) + pageSize) {
+            pagesFromRanges.push_back(address);
+        }
+    });
+    EXPECT_EQ(pages, pagesFromRanges);
+}
+
 TEST_F(PageTableTests48, mapPageMapByteInMapped) {
     std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
     uintptr_t addr1 = refAddr;
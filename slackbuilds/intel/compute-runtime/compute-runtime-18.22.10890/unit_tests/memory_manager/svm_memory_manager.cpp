@@ -145,3 +145,25 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
         EXPECT_EQ(0U, svmM.GetSVMAllocs().getNumAllocs());
     }
 }
+
+TEST(SVMAllocationTrackerTest, givenAdjacentAllocationsWhenInteriorPointersAreLookedUpThenOwningAllocationIsReturned) {
+    SVMAllocsManager::MapBasedAllocationTracker tracker;
+    GraphicsAllocation first(reinterpret_cast<void *>(0x10000), 0x1000);
+    GraphicsAllocation second(reinterpret_cast<void *>(0x11000), 0x2000);
+    tracker.insert(second);
+    tracker.insert(first);
+    EXPECT_EQ(2u, tracker.getNumAllocs());
+
+    EXPECT_EQ(nullptr, tracker.get(reinterpret_cast<void *>(0xFFFF)));
+    EXPECT_EQ(&first, tracker.get(reinterpret_cast<void *>(0x10000)));
+    EXPECT_EQ(&first, tracker.get(reinterpret_cast<void *>(0x10FFF)));
+    EXPECT_EQ(&second, tracker.get(reinterpret_cast<void *>(0x11000)));
+    EXPECT_EQ(&second, tracker.get(reinterpret_cast<void *>(0x12FFF)));
+    EXPECT_EQ(nullptr, tracker.get(reinterpret_cast<void *>(0x13000)));
+
+    tracker.remove(first);
+    EXPECT_EQ(nullptr, tracker.get(reinterpret_cast<void *>(0x10800)));
+    EXPECT_EQ(&second, tracker.get(reinterpret_cast<void *>(0x11800)));
+    tracker.remove(second);
+    EXPECT_EQ(0u, tracker.getNumAllocs());
+}
@@ -36,6 +36,7 @@ class MockHandler : public AsyncEventsHandler {
     using AsyncEventsHandler::allowAsyncProcess;
     using AsyncEventsHandler::asyncMtx;
     using AsyncEventsHandler::asyncProcess;
+    using AsyncEventsHandler::completionHeaps;
     using AsyncEventsHandler::openThread;
     using AsyncEventsHandler::thread;
 
@@ -68,7 +69,7 @@ class MockHandler : public AsyncEventsHandler {
         openThreadCalled = true;
     }
 
-    bool peekIsListEmpty() { return list.size() == 0; }
+    bool peekIsListEmpty() { return list.size() == 0 && completionHeaps.size() == 0; }
     bool peekIsRegisterListEmpty() { return registerList.size() == 0; }
 
     std::atomic<int> transferCounter;
@@ -63,6 +63,7 @@ void MockDevice::injectMemoryManager(MockMemoryManager *memoryManager) {
 
 void MockDevice::resetCommandStreamReceiver(CommandStreamReceiver *newCsr) {
     if (commandStreamReceiver) {
+        commandStreamReceiver->closeSubmissionWorker();
         delete commandStreamReceiver;
     }
     commandStreamReceiver = newCsr;
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/submission_worker.h"
+
+namespace OCLRT {
+class MockSubmissionWorker : public SubmissionWorker {
+  public:
+    using SubmissionWorker::allowProcess;
+    using SubmissionWorker::dispatchMode;
+    using SubmissionWorker::maxSubmissionDelay;
+    using SubmissionWorker::queueDepth;
+    using SubmissionWorker::thread;
+    using SubmissionWorker::workPending;
+
+    MockSubmissionWorker(CommandStreamReceiver &commandStreamReceiver, DispatchMode dispatchMode = DispatchMode::AdaptiveDispatch, bool allowThreadCreating = false)
+        : SubmissionWorker(commandStreamReceiver, dispatchMode), allowThreadCreating(allowThreadCreating) {}
+
+    bool isSubmissionWindowOpen(std::chrono::high_resolution_clock::time_point waitStart) override {
+        isSubmissionWindowOpenCalled++;
+        return SubmissionWorker::isSubmissionWindowOpen(waitStart);
+    }
+
+    void openThread() override {
+        if (allowThreadCreating) {
+            SubmissionWorker::openThread();
+        }
+        openThreadCalled++;
+    }
+
+    bool allowThreadCreating = false;
+    uint32_t openThreadCalled = 0;
+    std::atomic<uint32_t> isSubmissionWindowOpenCalled{0};
+};
+} // namespace OCLRT
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "gtest/gtest.h"
+
+#include <future>
+
+using namespace OCLRT;
+
+TEST(SVMAllocsManagerMtTest, givenAllocationsCreatedAndFreedConcurrentlyWhenInteriorPointersAreLookedUpThenOwningAllocationIsReturned) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *stablePtr = (char *)svmM.createSVMAlloc(4096);
+        ASSERT_NE(nullptr, stablePtr);
+        auto stableAllocation = svmM.getSVMAlloc(stablePtr);
+
+        auto lookups = std::async(std::launch::async, [&]() {
+            bool allFound = true;
+            for (int i = 0; i < 10000; i++) {
+                allFound &= (svmM.getSVMAlloc(stablePtr + i % 4096) == stableAllocation);
+            }
+            return allFound;
+        });
+        for (int i = 0; i < 100; i++) {
+            auto ptr = svmM.createSVMAlloc(4096);
+            svmM.freeSVMAlloc(ptr);
+        }
+
+        EXPECT_TRUE(lookups.get());
+        svmM.freeSVMAlloc(stablePtr);
+        EXPECT_EQ(0u, svmM.getNumAllocs());
+    }
+}
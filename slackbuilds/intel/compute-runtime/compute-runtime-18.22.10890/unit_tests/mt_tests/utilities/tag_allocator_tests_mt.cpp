@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct StressTag {
+    // tag memory is not initialized by the allocator, so only a distinct marker means "taken"
+    static const uint32_t takenMarker = 0x7a6e7a6e;
+    std::atomic<uint32_t> state;
+};
+
+struct TagAllocatorStressTest : public ::testing::Test {
+    static const uint32_t threadCount = 8;
+    static const uint32_t iterationsCount = 20000;
+    static const uint32_t tagsHeldCount = 4;
+
+    void SetUp() override {
+        memoryManager.reset(new OsAgnosticMemoryManager);
+        tagAllocator.reset(new TagAllocator<StressTag>(memoryManager.get(), 512, MemoryConstants::cacheLineSize));
+    }
+
+    void TearDown() override {
+        tagAllocator.reset();
+        memoryManager.reset();
+    }
+
+    void takeTag(TagNode<StressTag> *&node) {
+        node = tagAllocator->getTag();
+        if (node->tag->state.exchange(StressTag::takenMarker) == StressTag::takenMarker) {
+            duplicatedTags++;
+        }
+    }
+
+    void releaseTag(TagNode<StressTag> *node) {
+        if (node->tag->state.exchange(0) != StressTag::takenMarker) {
+            duplicatedTags++;
+        }
+        tagAllocator->returnTag(node);
+    }
+
+    void reportTagsPerSecond(const char *workloadName, std::chrono::high_resolution_clock::time_point start) {
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        auto tagsCount = static_cast<uint64_t>(threadCount) * iterationsCount * tagsHeldCount;
+        std::cout << workloadName << " threads: " << threadCount
+                  << " tags: " << tagsCount
+                  << " tags per second: " << (elapsedUs ? tagsCount * 1000000 / elapsedUs : 0)
+                  << std::endl;
+    }
+
+    std::unique_ptr<MemoryManager> memoryManager;
+    std::unique_ptr<TagAllocator<StressTag>> tagAllocator;
+    std::atomic<uint32_t> duplicatedTags{0};
+};
+
+TEST_F(TagAllocatorStressTest, givenManyThreadsTakingAndReturningTagsThenEachTagHasSingleOwnerAndThroughputIsReported) {
+    std::atomic<bool> startFlag{false};
+    std::vector<std::thread> threads;
+
+    for (uint32_t threadId = 0; threadId < threadCount; threadId++) {
+        threads.emplace_back([&]() {
+            TagNode<StressTag> *nodes[tagsHeldCount];
+            while (!startFlag) {
+            }
+            for (uint32_t i = 0; i < iterationsCount; i++) {
+                for (auto &node : nodes) {
+                    takeTag(node);
+                }
+                for (auto &node : nodes) {
+                    releaseTag(node);
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    startFlag = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    reportTagsPerSecond("same thread return", start);
+
+    EXPECT_EQ(0u, duplicatedTags);
+}
+
+TEST_F(TagAllocatorStressTest, givenTagsReturnedByDifferentThreadThenEachTagHasSingleOwnerAndThroughputIsReported) {
+    std::atomic<bool> startFlag{false};
+    std::vector<std::thread> threads;
+    std::vector<std::atomic<TagNode<StressTag> *>> handOff(threadCount * tagsHeldCount);
+    for (auto &slot : handOff) {
+        slot = nullptr;
+    }
+
+    // every thread leaves tags in its slots and returns tags left by its neighbour,
+    // like events created on one thread and released on another
+    for (uint32_t threadId = 0; threadId < threadCount; threadId++) {
+        threads.emplace_back([&, threadId]() {
+            auto neighbourId = (threadId + 1) % threadCount;
+            while (!startFlag) {
+            }
+            for (uint32_t i = 0; i < iterationsCount; i++) {
+                for (uint32_t j = 0; j < tagsHeldCount; j++) {
+                    TagNode<StressTag> *node = nullptr;
+                    takeTag(node);
+                    auto notTakenByNeighbour = handOff[threadId * tagsHeldCount + j].exchange(node);
+                    if (notTakenByNeighbour != nullptr) {
+                        releaseTag(notTakenByNeighbour);
+                    }
+                }
+                for (uint32_t j = 0; j < tagsHeldCount; j++) {
+                    auto node = handOff[neighbourId * tagsHeldCount + j].exchange(nullptr);
+                    if (node != nullptr) {
+                        releaseTag(node);
+                    }
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    startFlag = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    reportTagsPerSecond("cross thread return", start);
+
+    for (auto &slot : handOff) {
+        if (slot != nullptr) {
+            releaseTag(slot);
+        }
+    }
+    EXPECT_EQ(0u, duplicatedTags);
+}
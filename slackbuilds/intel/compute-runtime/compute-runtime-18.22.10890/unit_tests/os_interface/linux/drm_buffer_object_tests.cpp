@@ -89,6 +89,70 @@ TEST_F(DrmBufferObjectTest, exec_ioctlFailed) {
     EXPECT_THROW(bo->exec(0, 0, 0), std::exception);
 }
 
+TEST_F(DrmBufferObjectTest, givenExecObjectsIdsWhenUnchangedSoftPinnedBoIsExecutedAgainThenItsExecObjectIsNotRefilled) {
+    mock->ioctl_expected.total = 3;
+    mock->ioctl_res = 0;
+
+    uint64_t execObjectsIds[256] = {};
+    bo->setExecObjectsStorage(execObjectsStorage, execObjectsIds);
+
+    std::unique_ptr<TestedBufferObject> residentBo(new TestedBufferObject(this->mock));
+    residentBo->softPin(0x10000);
+    std::vector<BufferObject *> residency = {residentBo.get()};
+
+    bo->swapResidencyVector(&residency);
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(&execObjectsStorage[0], residentBo->execObjectPointerFilled);
+    EXPECT_EQ(residentBo->peekExecObjectId(), execObjectsIds[0]);
+
+    residentBo->execObjectPointerFilled = nullptr;
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(nullptr, residentBo->execObjectPointerFilled);
+    EXPECT_EQ(0x10000u, execObjectsStorage[0].offset);
+
+    residentBo->softPin(0x20000);
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(&execObjectsStorage[0], residentBo->execObjectPointerFilled);
+    EXPECT_EQ(0x20000u, execObjectsStorage[0].offset);
+
+    bo->swapResidencyVector(&residency);
+}
+
+TEST_F(DrmBufferObjectTest, givenReusedExecObjectWhenLowPriorityContextIdChangesThenItIsRewritten) {
+    mock->ioctl_expected.total = 2;
+    mock->ioctl_res = 0;
+
+    uint64_t execObjectsIds[256] = {};
+    bo->setExecObjectsStorage(execObjectsStorage, execObjectsIds);
+
+    std::unique_ptr<TestedBufferObject> residentBo(new TestedBufferObject(this->mock));
+    residentBo->softPin(0x10000);
+    std::vector<BufferObject *> residency = {residentBo.get()};
+
+    bo->swapResidencyVector(&residency);
+    mock->lowPriorityContextId = 0;
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(0u, execObjectsStorage[0].rsvd1);
+
+    residentBo->execObjectPointerFilled = nullptr;
+    mock->lowPriorityContextId = 5;
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(nullptr, residentBo->execObjectPointerFilled);
+    EXPECT_EQ(5u, execObjectsStorage[0].rsvd1);
+
+    bo->swapResidencyVector(&residency);
+}
+
+TEST_F(DrmBufferObjectTest, givenResidencyGenerationWhenBoIsMarkedResidentTwiceThenOnlyFirstMarkSucceeds) {
+    auto generation = BufferObject::createResidencyGeneration();
+    EXPECT_TRUE(bo->markResident(generation));
+    EXPECT_FALSE(bo->markResident(generation));
+
+    auto nextGeneration = BufferObject::createResidencyGeneration();
+    EXPECT_NE(generation, nextGeneration);
+    EXPECT_TRUE(bo->markResident(nextGeneration));
+}
+
 TEST_F(DrmBufferObjectTest, setTiling_success) {
     mock->ioctl_expected.total = 1; //set_tiling
     auto ret = bo->setTiling(I915_TILING_X, 0);
@@ -1423,6 +1423,33 @@ TEST_F(DrmCommandStreamLeaksTest, ClearResidencyWhenFlushNotCalled) {
     mm->freeGraphicsMemory(allocation2);
 }
 
+TEST_F(DrmCommandStreamLeaksTest, givenAllocationListedTwiceWhenResidencyIsProcessedThenItsBufferObjectIsExecutedOnce) {
+    auto allocation = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, allocation);
+    ResidencyContainer allocationsForResidency = {allocation, allocation};
+
+    csr->processResidency(&allocationsForResidency);
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+
+    auto &cs = csr->getCS();
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+
+    // allocation BO and batch buffer
+    EXPECT_EQ(2u, this->mock->execBuffer.buffer_count);
+    EXPECT_EQ(0u, tCsr->getResidencyVector()->size());
+
+    // next exec list starts a new generation
+    csr->processResidency(&allocationsForResidency);
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+    EXPECT_TRUE(isResident(allocation->getBO()));
+
+    tCsr->getResidencyVector()->clear();
+    mm->freeGraphicsMemory(allocation);
+}
+
 TEST_F(DrmCommandStreamLeaksTest, FlushMultipleTimes) {
     auto &cs = csr->getCS();
     auto commandBuffer = static_cast<DrmAllocation *>(cs.getGraphicsAllocation());
@@ -26,6 +26,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "runtime/command_stream/device_command_stream.h"
 #include "hw_cmds.h"
@@ -95,6 +96,9 @@ class DrmGemCloseWorkerFixture {
   protected:
     class BufferObjectWrapper : public BufferObject {
       public:
+        using BufferObject::nextToClose;
+        using BufferObject::pendingCloses;
+
         BufferObjectWrapper(Drm *drm, int handle) : BufferObject(drm, handle, false) {
         }
     };
@@ -196,3 +200,72 @@ TEST_F(DrmGemCloseWorkerTests, givenDrmGemCloseWorkerWhenCloseIsCalledMultipleTi
     worker->close(true);
     EXPECT_EQ(nullptr, worker->thread);
 }
+
+TEST_F(DrmGemCloseWorkerTests, givenBufferObjectsPushedFromManyThreadsWhenWorkerDrainsThemThenAllAreClosed) {
+    const int threadsCount = 4;
+    const int bosPerThread = 256;
+    this->drmMock->gem_close_expected = threadsCount * bosPerThread;
+
+    auto worker = new DrmGemCloseWorker(*mm);
+    std::vector<std::thread> producers;
+    for (int i = 0; i < threadsCount; i++) {
+        producers.emplace_back([&]() {
+            for (int j = 0; j < bosPerThread; j++) {
+                worker->push(new BufferObjectWrapper(this->drmMock, j));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    while (!worker->isEmpty() && (deadCnt-- > 0))
+        pthread_yield(); //yield to another threads
+
+    EXPECT_TRUE(worker->isEmpty());
+    delete worker;
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenSameBufferObjectPushedTwiceWhenWorkerIsClosedThenBothReferencesAreReleased) {
+    this->drmMock->gem_close_expected = 1;
+
+    auto worker = new DrmGemCloseWorker(*mm);
+    auto bo = new BufferObjectWrapper(this->drmMock, 1);
+
+    bo->reference();
+    worker->push(bo);
+    worker->push(bo);
+    worker->close(true);
+
+    EXPECT_TRUE(worker->isEmpty());
+    delete worker;
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenBufferObjectPushedAgainBeforeItIsClosedWhenBatchIsClosedThenItIsLinkedOnceAndAllReferencesAreReleased) {
+    struct mockDrmGemCloseWorker : DrmGemCloseWorker {
+        using DrmGemCloseWorker::closeBatch;
+        using DrmGemCloseWorker::DrmGemCloseWorker;
+        using DrmGemCloseWorker::pendingWork;
+        using DrmGemCloseWorker::takePendingWork;
+    };
+    this->drmMock->gem_close_expected = 1;
+
+    std::unique_ptr<mockDrmGemCloseWorker> worker(new mockDrmGemCloseWorker(*mm));
+    worker->close(true);
+    auto bo = new BufferObjectWrapper(this->drmMock, 1);
+
+    bo->reference();
+    bo->reference();
+    worker->push(bo);
+    worker->push(bo);
+    worker->push(bo);
+
+    EXPECT_EQ(3u, bo->pendingCloses.load());
+    EXPECT_EQ(bo, worker->pendingWork.load());
+    EXPECT_EQ(nullptr, bo->nextToClose);
+    EXPECT_FALSE(worker->isEmpty());
+
+    worker->closeBatch(worker->takePendingWork());
+    EXPECT_TRUE(worker->isEmpty());
+    EXPECT_EQ(nullptr, worker->pendingWork.load());
+}
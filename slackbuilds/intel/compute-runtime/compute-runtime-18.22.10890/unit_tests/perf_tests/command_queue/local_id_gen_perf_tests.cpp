@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/local_id_gen.h"
+#include "runtime/command_queue/local_ids_cache.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/utilities/cpu_info.h"
+#include "test.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace OCLRT {
+struct uint16x8_t;
+struct uint16x16_t;
+struct uint16x32_t;
+} // namespace OCLRT
+
+namespace ULT {
+
+typedef void (*LocalIdsGenerator)(void *buffer, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup);
+
+const uint32_t iterationsPerShape = 200;
+const size_t maxWorkGroupSize = 1024;
+
+struct LocalIdsVariant {
+    std::string name;
+    LocalIdsGenerator simd8;
+    LocalIdsGenerator simd16;
+    LocalIdsGenerator simd32;
+
+    LocalIdsGenerator get(uint32_t simd) const {
+        return simd == 32 ? simd32 : simd == 16 ? simd16 : simd8;
+    }
+};
+
+struct WorkGroupShape {
+    size_t lws[3];
+    size_t dimensions;
+};
+
+class LocalIdGenPerfTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        bufferSize = getThreadsPerWG(8, maxWorkGroupSize) * getPerThreadSizeLocalIDs(8);
+        buffer = alignedMalloc(bufferSize, 32);
+        reference = alignedMalloc(bufferSize, 32);
+        memset(buffer, 0, bufferSize);
+        memset(reference, 0, bufferSize);
+
+        auto &cpuInfo = CpuInfo::getInstance();
+        variants.push_back({"SSE4", generateLocalIDsSimd<uint16x8_t, 8>, generateLocalIDsSimd<uint16x8_t, 16>, generateLocalIDsSimd<uint16x8_t, 32>});
+        if (cpuInfo.isFeatureSupported(CpuInfo::featureAvX2)) {
+            variants.push_back({"AVX2", generateLocalIDsSimd<uint16x8_t, 8>, generateLocalIDsSimd<uint16x16_t, 16>, generateLocalIDsSimd<uint16x16_t, 32>});
+        }
+        if (cpuInfo.isFeatureSupported(CpuInfo::featureAvX512F | CpuInfo::featureAvX512Bw)) {
+            variants.push_back({"AVX512", nullptr, nullptr, generateLocalIDsSimd<uint16x32_t, 32>});
+        }
+
+        // every power of two shape up to the max work group size, plus odd shapes
+        // that leave partially filled threads
+        for (size_t x = 1; x <= maxWorkGroupSize; x *= 2) {
+            for (size_t y = 1; x * y <= maxWorkGroupSize; y *= 2) {
+                for (size_t z = 1; x * y * z <= maxWorkGroupSize; z *= 2) {
+                    shapes.push_back({{x, y, z}, z > 1 ? 3u : y > 1 ? 2u : 1u});
+                }
+            }
+        }
+        shapes.push_back({{7, 1, 1}, 1});
+        shapes.push_back({{33, 1, 1}, 1});
+        shapes.push_back({{17, 3, 1}, 2});
+        shapes.push_back({{31, 31, 1}, 2});
+        shapes.push_back({{7, 5, 3}, 3});
+        shapes.push_back({{9, 9, 9}, 3});
+    }
+
+    void TearDown() override {
+        alignedFree(reference);
+        alignedFree(buffer);
+    }
+
+    size_t getLocalIdsSize(uint32_t simd, const size_t lws[3]) {
+        return getThreadsPerWG(simd, lws[0] * lws[1] * lws[2]) * getPerThreadSizeLocalIDs(simd);
+    }
+
+    long long timeGenerator(LocalIdsGenerator generator, uint32_t simd, const size_t lws[3]) {
+        auto threadsPerWorkGroup = getThreadsPerWG(simd, lws[0] * lws[1] * lws[2]);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iterationsPerShape; i++) {
+            generator(buffer, lws[0], lws[1], threadsPerWorkGroup);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    long long timeCache(uint32_t simd, const size_t lws[3]) {
+        auto size = getLocalIdsSize(simd, lws);
+        LocalIdsCache cache;
+        cache.generateLocalIds(buffer, size, simd, lws);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < iterationsPerShape; i++) {
+            cache.generateLocalIds(buffer, size, simd, lws);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    void runWorkload(uint32_t simd) {
+        const char *dimensionNames[] = {"1D", "2D", "3D"};
+        for (size_t dimensions = 1; dimensions <= 3; dimensions++) {
+            std::vector<long long> times(variants.size() + 1, 0);
+            size_t shapesCount = 0;
+            for (auto &shape : shapes) {
+                if (shape.dimensions != dimensions) {
+                    continue;
+                }
+                auto size = getLocalIdsSize(simd, shape.lws);
+                variants[0].get(simd)(reference, shape.lws[0], shape.lws[1], getThreadsPerWG(simd, shape.lws[0] * shape.lws[1] * shape.lws[2]));
+
+                for (size_t v = 0; v < variants.size(); v++) {
+                    auto generator = variants[v].get(simd);
+                    if (generator == nullptr) {
+                        continue;
+                    }
+                    times[v] += timeGenerator(generator, simd, shape.lws);
+                    EXPECT_EQ(0, memcmp(reference, buffer, size)) << variants[v].name << " SIMD" << simd << " " << shape.lws[0] << "x" << shape.lws[1] << "x" << shape.lws[2];
+                }
+                times[variants.size()] += timeCache(simd, shape.lws);
+                EXPECT_EQ(0, memcmp(reference, buffer, size)) << "Cache SIMD" << simd << " " << shape.lws[0] << "x" << shape.lws[1] << "x" << shape.lws[2];
+                shapesCount++;
+            }
+
+            std::cout << "SIMD" << simd << " " << dimensionNames[dimensions - 1] << " shapes: " << shapesCount;
+            for (size_t v = 0; v <= variants.size(); v++) {
+                if (v < variants.size() && variants[v].get(simd) == nullptr) {
+                    continue;
+                }
+                std::cout << " " << (v < variants.size() ? variants[v].name : std::string("Cache"))
+                          << " avg [ns]: " << times[v] / static_cast<long long>(shapesCount * iterationsPerShape);
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    void *buffer = nullptr;
+    void *reference = nullptr;
+    size_t bufferSize = 0;
+    std::vector<LocalIdsVariant> variants;
+    std::vector<WorkGroupShape> shapes;
+};
+
+TEST_F(LocalIdGenPerfTest, givenAllSimdSizesAndWorkGroupShapesWhenGeneratingLocalIdsThenTimePerDispatchIsReportedForEachVariant) {
+    for (uint32_t simd : {8u, 16u, 32u}) {
+        runWorkload(simd);
+    }
+}
+} // namespace ULT
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/command_queue_hw.h"
+#include "runtime/command_stream/preemption.h"
+#include "runtime/device/device.h"
+#include "runtime/helpers/options.h"
+#include "unit_tests/fixtures/ult_command_stream_receiver_fixture.h"
+#include "unit_tests/mocks/mock_csr.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// cost model of the simulated device
+const std::chrono::microseconds execBufferIoctlCost(30);
+const std::chrono::microseconds kernelExecutionTime(20);
+const uint32_t enqueuesCount = 256;
+
+template <typename GfxFamily>
+class SimulatedGpuCsr : public MockCsrHw2<GfxFamily> {
+  public:
+    SimulatedGpuCsr(const HardwareInfo &hwInfoIn) : MockCsrHw2<GfxFamily>(hwInfoIn) {}
+
+    FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) override {
+        auto start = std::chrono::high_resolution_clock::now();
+        while (std::chrono::high_resolution_clock::now() - start < execBufferIoctlCost) {
+        }
+        submissions++;
+        return MockCsrHw2<GfxFamily>::flush(batchBuffer, engineType, allocationsForResidency);
+    }
+
+    std::atomic<uint32_t> submissions{0};
+};
+
+// Retires one task per kernelExecutionTime out of everything submitted to the device
+struct SimulatedGpu {
+    SimulatedGpu(CommandStreamReceiver &csr, uint32_t tasksCount) : csr(csr), completionTimes(tasksCount + 1) {
+        *csr.getTagAddress() = 0;
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~SimulatedGpu() {
+        running = false;
+        thread.join();
+    }
+
+    void run() {
+        while (running) {
+            auto completed = *csr.getTagAddress();
+            if (completed < csr.peekLatestFlushedTaskCount()) {
+                std::this_thread::sleep_for(kernelExecutionTime);
+                completionTimes[completed + 1] = std::chrono::high_resolution_clock::now();
+                *csr.getTagAddress() = completed + 1;
+            }
+        }
+    }
+
+    CommandStreamReceiver &csr;
+    std::vector<std::chrono::high_resolution_clock::time_point> completionTimes;
+    std::atomic<bool> running{true};
+    std::thread thread;
+};
+
+struct DispatchModePerfTest : public UltCommandStreamReceiverTest {
+    template <typename FamilyType>
+    void runWorkload(DispatchMode dispatchMode, const char *modeName) {
+        CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+        auto &queueStream = commandQueue.getCS(enqueuesCount * 4 * MemoryConstants::cacheLineSize);
+
+        auto csr = new SimulatedGpuCsr<FamilyType>(*platformDevices[0]);
+        pDevice->resetCommandStreamReceiver(csr);
+        csr->overrideDispatchPolicy(dispatchMode);
+        configureCSRtoNonDirtyState<FamilyType>();
+
+        DispatchFlags dispatchFlags;
+        dispatchFlags.guardCommandBufferWithPipeControl = true;
+        dispatchFlags.preemptionMode = PreemptionHelper::getDefaultPreemptionMode(pDevice->getHardwareInfo());
+
+        std::vector<std::chrono::high_resolution_clock::time_point> enqueueTimes(enqueuesCount + 1);
+        {
+            SimulatedGpu gpu(*csr, enqueuesCount);
+            auto start = std::chrono::high_resolution_clock::now();
+            for (uint32_t i = 1; i <= enqueuesCount; i++) {
+                TakeOwnershipWrapper<Device> deviceOwnership(*pDevice);
+                enqueueTimes[i] = std::chrono::high_resolution_clock::now();
+                auto taskStart = queueStream.getUsed();
+                memset(queueStream.getSpace(MemoryConstants::cacheLineSize), 0, MemoryConstants::cacheLineSize);
+                csr->flushTask(queueStream, taskStart, dsh, ioh, ssh, taskLevel, dispatchFlags);
+            }
+            // equivalent of clFinish
+            csr->waitForCompletionWithTimeout(false, 0, enqueuesCount);
+            auto end = std::chrono::high_resolution_clock::now();
+            csr->closeSubmissionWorker();
+
+            long long totalLatency = 0;
+            long long maxLatency = 0;
+            for (uint32_t i = 1; i <= enqueuesCount; i++) {
+                auto latency = std::chrono::duration_cast<std::chrono::microseconds>(gpu.completionTimes[i] - enqueueTimes[i]).count();
+                totalLatency += latency;
+                maxLatency = std::max(maxLatency, static_cast<long long>(latency));
+            }
+
+            std::cout << modeName
+                      << " execbuffer ioctls: " << csr->submissions
+                      << " avg enqueue-to-completion [us]: " << totalLatency / enqueuesCount
+                      << " max enqueue-to-completion [us]: " << maxLatency
+                      << " total [us]: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                      << std::endl;
+            submissions[static_cast<uint32_t>(dispatchMode)] = csr->submissions;
+        }
+        *csr->getTagAddress() = initialHardwareTag;
+    }
+
+    uint32_t submissions[static_cast<uint32_t>(DispatchMode::BatchedDispatch) + 1] = {};
+};
+
+HWTEST_F(DispatchModePerfTest, givenSmallEnqueuesWhenSubmittedInDifferentDispatchModesThenIoctlCountAndLatencyAreReported) {
+    runWorkload<FamilyType>(DispatchMode::ImmediateDispatch, "ImmediateDispatch");
+    runWorkload<FamilyType>(DispatchMode::BatchedDispatch, "BatchedDispatch");
+    runWorkload<FamilyType>(DispatchMode::AdaptiveDispatch, "AdaptiveDispatch");
+    runWorkload<FamilyType>(DispatchMode::BatchedDispatchWithCounter, "BatchedDispatchWithCounter");
+
+    EXPECT_EQ(enqueuesCount, submissions[static_cast<uint32_t>(DispatchMode::ImmediateDispatch)]);
+    EXPECT_EQ(1u, submissions[static_cast<uint32_t>(DispatchMode::BatchedDispatch)]);
+    EXPECT_GT(enqueuesCount, submissions[static_cast<uint32_t>(DispatchMode::AdaptiveDispatch)]);
+    EXPECT_GT(enqueuesCount, submissions[static_cast<uint32_t>(DispatchMode::BatchedDispatchWithCounter)]);
+}
+} // namespace ULT
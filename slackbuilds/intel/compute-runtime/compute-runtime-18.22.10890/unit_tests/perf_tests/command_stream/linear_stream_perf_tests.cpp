@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/linear_stream.h"
+#include "test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+struct alignas(8) PerfTestCmd {
+    uint32_t dwords[8];
+};
+
+const size_t cmdsPerBatch = 64;
+const size_t batchesCount = 200000;
+
+class LinearStreamPerfTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        buffer.reset(new uint8_t[bufferSize]);
+    }
+
+    // Emits batches of commands the way a walker dispatch does and reports commands emitted per second.
+    template <bool reserve>
+    void emitCommands(const char *name) {
+        LinearStream stream(buffer.get(), bufferSize);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t batch = 0; batch < batchesCount; batch++) {
+            stream.replaceBuffer(buffer.get(), bufferSize);
+            if (reserve) {
+                stream.reserveSpace(bufferSize);
+            }
+            for (size_t cmd = 0; cmd < cmdsPerBatch; cmd++) {
+                auto pCmd = stream.getSpaceForCmd<PerfTestCmd>();
+                pCmd->dwords[0] = static_cast<uint32_t>(cmd);
+            }
+            if (reserve) {
+                stream.commitReservedSpace();
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(bufferSize, stream.getUsed());
+
+        auto seconds = std::chrono::duration<double>(end - start).count();
+        auto cmdsPerSecond = batchesCount * cmdsPerBatch / seconds;
+        std::cout << name << " commands per second: " << cmdsPerSecond << std::endl;
+    }
+
+    const size_t bufferSize = cmdsPerBatch * sizeof(PerfTestCmd);
+    std::unique_ptr<uint8_t[]> buffer;
+};
+
+TEST_F(LinearStreamPerfTest, givenReservedSpaceWhenCommandsAreEmittedThenThroughputIsReportedAlongsideAtomicGetSpace) {
+    emitCommands<false>("Warm-up");
+    emitCommands<false>("Atomic getSpace");
+    emitCommands<true>("Reserved getSpace");
+}
+} // namespace ULT
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/tag_waiter.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_csr.h"
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+const uint32_t tasksCount = 32;
+const uint32_t waitersCount = 4;
+
+struct WaitResult {
+    long long avgWakeUpLatency;
+    long long maxWakeUpLatency;
+    double cpuTimePerTask;
+};
+
+class TagWaiterPerfTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        csr.reset(new MockCommandStreamReceiver());
+        csr->tagAddress = &tag;
+    }
+
+    // Every waiter waits for each task in turn, simulated GPU completes one task per taskDuration.
+    // Wake-up latency is the time between tag update and waiter noticing it,
+    // CPU time is consumed by the whole process, including the simulated GPU.
+    WaitResult runWorkload(const char *waiterName, int32_t spinMicroseconds, std::chrono::microseconds taskDuration) {
+        DebugManagerStateRestore stateRestore;
+        DebugManager.flags.WaitSpinMicroseconds.set(spinMicroseconds);
+        TagWaiter waiter(*csr);
+        tag = 0;
+
+        std::vector<std::chrono::high_resolution_clock::time_point> completionTimes(tasksCount + 1);
+        std::vector<long long> latencies(waitersCount * tasksCount);
+        std::atomic<uint32_t> waitersReady{0};
+        std::vector<std::thread> waiters;
+
+        auto cpuStart = std::clock();
+        for (uint32_t waiterId = 0; waiterId < waitersCount; waiterId++) {
+            waiters.emplace_back([&, waiterId]() {
+                waitersReady++;
+                for (uint32_t task = 1; task <= tasksCount; task++) {
+                    waiter.waitForTag(task, false, 0);
+                    auto wakeUp = std::chrono::high_resolution_clock::now();
+                    latencies[waiterId * tasksCount + task - 1] = std::chrono::duration_cast<std::chrono::microseconds>(wakeUp - completionTimes[task]).count();
+                }
+            });
+        }
+        while (waitersReady != waitersCount) {
+            std::this_thread::yield();
+        }
+        for (uint32_t task = 1; task <= tasksCount; task++) {
+            std::this_thread::sleep_for(taskDuration);
+            completionTimes[task] = std::chrono::high_resolution_clock::now();
+            tag = task;
+        }
+        for (auto &thread : waiters) {
+            thread.join();
+        }
+        auto cpuEnd = std::clock();
+        waiter.closeThread();
+
+        WaitResult result = {};
+        long long totalLatency = 0;
+        for (auto latency : latencies) {
+            totalLatency += latency;
+            result.maxWakeUpLatency = std::max(result.maxWakeUpLatency, latency);
+        }
+        result.avgWakeUpLatency = totalLatency / static_cast<long long>(latencies.size());
+        result.cpuTimePerTask = 1000000.0 * (cpuEnd - cpuStart) / CLOCKS_PER_SEC / tasksCount;
+
+        std::cout << waiterName
+                  << " task duration [us]: " << taskDuration.count()
+                  << " avg wake-up latency [us]: " << result.avgWakeUpLatency
+                  << " max wake-up latency [us]: " << result.maxWakeUpLatency
+                  << " cpu time per task [us]: " << result.cpuTimePerTask
+                  << std::endl;
+        return result;
+    }
+
+    volatile uint32_t tag = 0;
+    std::unique_ptr<MockCommandStreamReceiver> csr;
+};
+
+TEST_F(TagWaiterPerfTest, givenShortAndLongTasksWhenWaitingWithSpinOnlyAndHybridWaiterThenWakeUpLatencyAndCpuTimeAreReported) {
+    const std::chrono::microseconds shortTask(20);
+    const std::chrono::microseconds longTask(5000);
+
+    runWorkload("SpinOnly", -1, shortTask);
+    runWorkload("Hybrid", 100, shortTask);
+    auto spinOnly = runWorkload("SpinOnly", -1, longTask);
+    auto hybrid = runWorkload("Hybrid", 100, longTask);
+
+    EXPECT_LT(hybrid.cpuTimePerTask, spinOnly.cpuTimePerTask);
+}
+} // namespace ULT
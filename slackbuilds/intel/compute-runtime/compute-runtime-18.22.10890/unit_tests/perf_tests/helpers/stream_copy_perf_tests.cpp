@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/stream_copy.h"
+#include "runtime/utilities/cpu_info.h"
+#include "test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+typedef void (*CopyFunction)(void *dst, const void *src, size_t size);
+
+const size_t heapSize = 64 * 1024 * 1024;
+const size_t hostWorkingSetSize = 256 * 1024;
+const size_t maxCopySize = 64 * 1024;
+const uint32_t copiesPerSize = 20000;
+
+struct CopyVariant {
+    std::string name;
+    CopyFunction copy;
+};
+
+void memcpyCopy(void *dst, const void *src, size_t size) {
+    memcpy(dst, src, size);
+}
+
+// Copies are written into a heap much larger than caches, like consecutive dispatches fill indirect heaps,
+// and host working set is read between them, so the cost of evicting it is part of the measurement.
+class StreamCopyPerfTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        heap = static_cast<uint8_t *>(alignedMalloc(heapSize, MemoryConstants::pageSize));
+        // page faults are not part of the measurement
+        memset(heap, 0, heapSize);
+        source.resize(maxCopySize);
+        hostWorkingSet.resize(hostWorkingSetSize, 1);
+        for (size_t i = 0; i < source.size(); i++) {
+            source[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+
+        variants.push_back({"memcpy", memcpyCopy});
+        variants.push_back({"SSE4", streamCopySse4});
+        if (CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX2)) {
+            variants.push_back({"AVX2", streamCopyAvx2});
+        }
+        variants.push_back({"streamCopy", streamCopy});
+    }
+
+    void TearDown() override {
+        alignedFree(heap);
+    }
+
+    long long timeCopies(CopyFunction copy, size_t size) {
+        size_t offset = 0;
+        uint64_t checksum = 0;
+        uint8_t *lastCopy = heap;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < copiesPerSize; i++) {
+            lastCopy = heap + offset;
+            copy(lastCopy, source.data(), size);
+            offset = (offset + alignUp(size, MemoryConstants::cacheLineSize)) % (heapSize - maxCopySize);
+            for (size_t j = 0; j < hostWorkingSetSize; j += MemoryConstants::pageSize) {
+                checksum += hostWorkingSet[(j + i * MemoryConstants::cacheLineSize) % hostWorkingSetSize];
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(0, memcmp(lastCopy, source.data(), size));
+        EXPECT_NE(0u, checksum);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / copiesPerSize;
+    }
+
+    uint8_t *heap = nullptr;
+    std::vector<uint8_t> source;
+    std::vector<uint8_t> hostWorkingSet;
+    std::vector<CopyVariant> variants;
+};
+
+TEST_F(StreamCopyPerfTest, givenHeapSizedCopiesWhenCopiedWithEachVariantThenTimePerCopyIsReported) {
+    const size_t sizes[] = {64, 256, 1024, 2048, streamCopyMinSize, 16 * 1024, maxCopySize};
+    for (auto size : sizes) {
+        std::cout << "size " << size;
+        for (auto &variant : variants) {
+            std::cout << " " << variant.name << " avg [ns]: " << timeCopies(variant.copy, size);
+        }
+        std::cout << std::endl;
+    }
+}
+} // namespace ULT
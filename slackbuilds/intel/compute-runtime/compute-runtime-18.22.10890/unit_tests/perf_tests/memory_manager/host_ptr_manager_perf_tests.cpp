@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/host_ptr_manager.h"
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+const uintptr_t fragmentsBase = 0x10000000u;
+const size_t storedFragmentsCount = 4096;
+const size_t lookupsPerThread = 200000;
+// every n-th lookup is accompanied by storing and releasing a fragment
+const size_t updatesInterval = 64;
+
+class HostPtrManagerPerfTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        // every other page is stored, leaving a free page between fragments
+        for (size_t i = 0; i < storedFragmentsCount; i++) {
+            FragmentStorage fragment;
+            fragment.fragmentCpuPointer = getStoredFragmentPtr(i);
+            fragment.fragmentSize = MemoryConstants::pageSize;
+            hostPtrManager.storeFragment(fragment);
+        }
+    }
+
+    void TearDown() override {
+        for (size_t i = 0; i < storedFragmentsCount; i++) {
+            hostPtrManager.releaseHostPtr(getStoredFragmentPtr(i));
+        }
+        EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+    }
+
+    static void *getStoredFragmentPtr(size_t index) {
+        return reinterpret_cast<void *>(fragmentsBase + 2 * index * MemoryConstants::pageSize);
+    }
+
+    static void *getFreePagePtr(size_t index) {
+        return ptrOffset(getStoredFragmentPtr(index), MemoryConstants::pageSize);
+    }
+
+    template <typename LookupT>
+    void runWorkload(const char *workloadName, uint32_t threadsCount, LookupT lookup) {
+        std::atomic<bool> startFlag(false);
+        std::atomic<uint32_t> unexpectedStatuses(0);
+        std::vector<std::thread> threads;
+
+        for (uint32_t threadId = 0; threadId < threadsCount; threadId++) {
+            threads.emplace_back([&, threadId]() {
+                while (!startFlag) {
+                }
+                for (size_t i = 0; i < lookupsPerThread; i++) {
+                    if (!lookup(threadId, i)) {
+                        unexpectedStatuses++;
+                    }
+                    if (i % updatesInterval == 0) {
+                        // free pages are never queried, so storing one does not change lookup results
+                        FragmentStorage fragment;
+                        fragment.fragmentCpuPointer = getFreePagePtr(threadId);
+                        fragment.fragmentSize = MemoryConstants::pageSize;
+                        hostPtrManager.storeFragment(fragment);
+                        hostPtrManager.releaseHostPtr(fragment.fragmentCpuPointer);
+                    }
+                }
+            });
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        startFlag = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        auto lookupsCount = static_cast<uint64_t>(threadsCount) * lookupsPerThread;
+
+        std::cout << workloadName << " threads: " << threadsCount
+                  << " lookups per second: " << (elapsedUs ? lookupsCount * 1000000 / elapsedUs : 0) << std::endl;
+        EXPECT_EQ(0u, unexpectedStatuses);
+        EXPECT_EQ(storedFragmentsCount, hostPtrManager.getFragmentCount());
+    }
+
+    static std::vector<uint32_t> getThreadCounts() {
+        uint32_t maxThreads = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+        std::vector<uint32_t> threadCounts;
+        for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        return threadCounts;
+    }
+
+    HostPtrManager hostPtrManager;
+};
+
+TEST_F(HostPtrManagerPerfTest, givenThreadsLookingUpDisjointFragmentsThenLookupsPerSecondAreReported) {
+    for (auto threadsCount : getThreadCounts()) {
+        runWorkload("disjoint", threadsCount, [&](uint32_t threadId, size_t iteration) {
+            // each thread walks its own slice of stored fragments
+            auto slice = storedFragmentsCount / threadsCount;
+            auto fragmentPtr = getStoredFragmentPtr(threadId * slice + iteration % slice);
+            OverlapStatus overlapStatus;
+            auto fragment = hostPtrManager.getFragmentAndCheckForOverlaps(fragmentPtr, MemoryConstants::pageSize, overlapStatus);
+            return fragment != nullptr && overlapStatus == OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT &&
+                   hostPtrManager.getFragment(ptrOffset(fragmentPtr, MemoryConstants::cacheLineSize)) == fragment;
+        });
+    }
+}
+
+TEST_F(HostPtrManagerPerfTest, givenThreadsCheckingOverlapsOnSharedFragmentsThenLookupsPerSecondAreReported) {
+    const size_t sharedFragmentsCount = 16;
+    for (auto threadsCount : getThreadCounts()) {
+        runWorkload("overlap heavy", threadsCount, [&](uint32_t threadId, size_t iteration) {
+            // all threads hit the same few fragments with ranges inside, around and across them
+            auto fragmentPtr = getStoredFragmentPtr((iteration + threadId) % sharedFragmentsCount);
+            OverlapStatus overlapStatus;
+            switch (iteration % 3) {
+            case 0:
+                hostPtrManager.getFragmentAndCheckForOverlaps(ptrOffset(fragmentPtr, MemoryConstants::cacheLineSize), MemoryConstants::cacheLineSize, overlapStatus);
+                return overlapStatus == OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
+            case 1:
+                hostPtrManager.getFragmentAndCheckForOverlaps(ptrOffset(fragmentPtr, MemoryConstants::pageSize / 2), MemoryConstants::pageSize, overlapStatus);
+                return overlapStatus == OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
+            default:
+                hostPtrManager.getFragmentAndCheckForOverlaps(ptrOffset(fragmentPtr, MemoryConstants::pageSize + 1), 2 * MemoryConstants::pageSize, overlapStatus);
+                return overlapStatus == OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
+            }
+        });
+    }
+}
+} // namespace ULT
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/segregated_heap_allocator.h"
+#include "test.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+const uint64_t heapBase = 0x100000llu;
+const uint64_t heapSize = 1024 * 1024 * 1024llu;
+const size_t smallAllocationsCount = 20000;
+const uint32_t fragmentationRounds = 20;
+
+// Fills the heap with small allocations, frees every other one and then keeps
+// allocating and freeing mixed sizes through the resulting holes with bounded live set.
+long long runFragmentationWorkload(HeapAllocator &heapAllocator, size_t &failedAllocations) {
+    std::mt19937 generator(0);
+    std::vector<std::pair<uint64_t, size_t>> allocations;
+    allocations.reserve(smallAllocationsCount * 2);
+    failedAllocations = 0;
+
+    auto freeRandomAllocation = [&]() {
+        auto index = generator() % allocations.size();
+        heapAllocator.free(allocations[index].first, allocations[index].second);
+        allocations[index] = allocations.back();
+        allocations.pop_back();
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < smallAllocationsCount; i++) {
+        size_t size = (generator() % 4 + 1) * MemoryConstants::pageSize;
+        auto ptr = heapAllocator.allocate(size);
+        allocations.emplace_back(ptr, size);
+    }
+    for (size_t i = 0; i < smallAllocationsCount; i += 2) {
+        heapAllocator.free(allocations[i].first, allocations[i].second);
+    }
+    for (size_t i = 0; i < smallAllocationsCount / 2; i++) {
+        allocations[i] = allocations[2 * i + 1];
+    }
+    allocations.resize(smallAllocationsCount / 2);
+
+    for (uint32_t round = 0; round < fragmentationRounds; round++) {
+        for (size_t i = 0; i < smallAllocationsCount / 2; i++) {
+            size_t size = (generator() % 8 + 1) * MemoryConstants::pageSize;
+            if (generator() % 64 == 0) {
+                size *= 64;
+            }
+            auto ptr = heapAllocator.allocate(size);
+            if (ptr == 0llu) {
+                failedAllocations++;
+                continue;
+            }
+            allocations.emplace_back(ptr, size);
+        }
+        while (allocations.size() > smallAllocationsCount / 2) {
+            freeRandomAllocation();
+        }
+    }
+
+    while (!allocations.empty()) {
+        freeRandomAllocation();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+TEST(HeapAllocatorPerfTest, givenFragmentationHeavyWorkloadThenTimeOfBothBackendsIsReported) {
+    size_t failedAllocations[2] = {};
+
+    std::unique_ptr<HeapAllocator> heapAllocator(new HeapAllocator(heapBase, heapSize));
+    auto defaultTime = runFragmentationWorkload(*heapAllocator, failedAllocations[0]);
+    EXPECT_EQ(heapSize, heapAllocator->getLeftSize());
+
+    heapAllocator.reset(new SegregatedHeapAllocator(heapBase, heapSize));
+    auto segregatedTime = runFragmentationWorkload(*heapAllocator, failedAllocations[1]);
+    EXPECT_EQ(heapSize, heapAllocator->getLeftSize());
+
+    std::cout << "HeapAllocator [us]: " << defaultTime
+              << " failed allocations: " << failedAllocations[0] << std::endl
+              << "SegregatedHeapAllocator [us]: " << segregatedTime
+              << " failed allocations: " << failedAllocations[1] << std::endl;
+}
+} // namespace ULT
@@ -269,3 +269,26 @@ TEST(KernelInfo, givenKernelInfoWhenStoreNonTransformableArgThenArgInfoIsNotTran
     const auto &argInfo = kernelInfo->kernelArgInfo[argumentNumber];
     EXPECT_FALSE(argInfo.isTransformable);
 }
+
+TEST(KernelInfo, givenKernelInfoWhenIsaHashIsQueriedAgainThenCachedHashIsReturned) {
+    char kernelHeap[64] = {};
+    SKernelBinaryHeaderCommon kernelHeader = {};
+    kernelHeader.KernelHeapSize = sizeof(kernelHeap);
+    KernelInfo kernelInfo;
+    kernelInfo.name = "kernel";
+    kernelInfo.heapInfo.pKernelHeader = &kernelHeader;
+    kernelInfo.heapInfo.pKernelHeap = kernelHeap;
+
+    auto hash = kernelInfo.getIsaHash();
+    EXPECT_NE(0u, hash);
+
+    kernelHeap[0] = 1;
+    EXPECT_EQ(hash, kernelInfo.getIsaHash());
+
+    // a fresh KernelInfo hashes the modified heap
+    KernelInfo otherKernelInfo;
+    otherKernelInfo.name = "kernel";
+    otherKernelInfo.heapInfo.pKernelHeader = &kernelHeader;
+    otherKernelInfo.heapInfo.pKernelHeap = kernelHeap;
+    EXPECT_NE(hash, otherKernelInfo.getIsaHash());
+}
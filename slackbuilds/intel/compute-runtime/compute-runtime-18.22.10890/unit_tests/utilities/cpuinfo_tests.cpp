@@ -58,4 +58,21 @@ TEST(CpuInfo, cpuidex) {
     uint32_t cpuRegsInfo[4];
     uint32_t subleaf = 0;
     cpuInfo.cpuidex(cpuRegsInfo, 4, subleaf);
-}
\ No newline at end of file
+}
+uint64_t mockXgetbvWithoutAvxState(uint32_t index) {
+    return CpuInfo::xcr0AvxState & ~BIT(2);
+}
+
+TEST(CpuInfo, givenOsNotSavingAvxStateWhenFeaturesAreDetectedThenAvxFeaturesAreNotSupported) {
+    auto xgetbvFunc = CpuInfo::xgetbvFunc;
+    CpuInfo::xgetbvFunc = mockXgetbvWithoutAvxState;
+
+    CpuInfo cpuInfo;
+    EXPECT_TRUE(cpuInfo.isFeatureSupported(CpuInfo::featureSse));
+    EXPECT_FALSE(cpuInfo.isFeatureSupported(CpuInfo::featureAvx));
+    EXPECT_FALSE(cpuInfo.isFeatureSupported(CpuInfo::featureAvX2));
+    EXPECT_FALSE(cpuInfo.isFeatureSupported(CpuInfo::featureAvX512F));
+    EXPECT_FALSE(cpuInfo.isFeatureSupported(CpuInfo::featureAvX512Bw));
+
+    CpuInfo::xgetbvFunc = xgetbvFunc;
+}
@@ -42,3 +42,43 @@ TEST(Directory, GetFiles) {
     EXPECT_LT(0u, files.size());
     remove("temp_file_that_does_not_exist.tmp");
 }
+
+TEST(Directory, GetFileInfo) {
+    ofstream tempfile("temp_file_with_size.tmp");
+    tempfile << "0123456789";
+    tempfile.flush();
+    tempfile.close();
+
+    size_t size = 0;
+    uint64_t lastModified = 0;
+    uint64_t lastAccessed = 0;
+    EXPECT_TRUE(Directory::getFileInfo("temp_file_with_size.tmp", size, lastModified, lastAccessed));
+    EXPECT_EQ(10u, size);
+    EXPECT_NE(0u, lastModified);
+    EXPECT_NE(0u, lastAccessed);
+    remove("temp_file_with_size.tmp");
+
+    EXPECT_FALSE(Directory::getFileInfo("temp_file_that_does_not_exist.tmp", size, lastModified, lastAccessed));
+}
+
+TEST(Directory, SetFileTimes) {
+    ofstream tempfile("temp_file_with_times.tmp");
+    tempfile << "0123456789";
+    tempfile.close();
+
+    size_t size = 0;
+    uint64_t lastModified = 0;
+    uint64_t lastAccessed = 0;
+    EXPECT_TRUE(Directory::setFileTimes("temp_file_with_times.tmp", 1000000, 2000000));
+    EXPECT_TRUE(Directory::getFileInfo("temp_file_with_times.tmp", size, lastModified, lastAccessed));
+    EXPECT_EQ(1000000u, lastModified);
+    EXPECT_EQ(2000000u, lastAccessed);
+
+    EXPECT_TRUE(Directory::setFileTimes("temp_file_with_times.tmp", 0, 3000000));
+    EXPECT_TRUE(Directory::getFileInfo("temp_file_with_times.tmp", size, lastModified, lastAccessed));
+    EXPECT_EQ(1000000u, lastModified);
+    EXPECT_EQ(3000000u, lastAccessed);
+    remove("temp_file_with_times.tmp");
+
+    EXPECT_FALSE(Directory::setFileTimes("temp_file_that_does_not_exist.tmp", 1000000, 2000000));
+}
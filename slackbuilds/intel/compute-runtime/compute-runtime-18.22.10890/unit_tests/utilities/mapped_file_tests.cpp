@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/mapped_file.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace OCLRT;
+
+TEST(MappedFile, givenExistingFileWhenOpenedThenWholeContentIsMapped) {
+    const char content[] = "mapped file content";
+    {
+        std::ofstream tempFile("temp_mapped_file.tmp", std::ios::binary);
+        tempFile.write(content, sizeof(content));
+    }
+
+    auto mappedFile = MappedFile::open("temp_mapped_file.tmp");
+    ASSERT_NE(nullptr, mappedFile);
+    ASSERT_EQ(sizeof(content), mappedFile->size());
+    EXPECT_EQ(0, memcmp(content, mappedFile->data(), sizeof(content)));
+
+    mappedFile.reset();
+    std::remove("temp_mapped_file.tmp");
+}
+
+TEST(MappedFile, givenEmptyFileWhenOpenedThenNullptrIsReturned) {
+    {
+        std::ofstream tempFile("temp_empty_mapped_file.tmp");
+    }
+
+    EXPECT_EQ(nullptr, MappedFile::open("temp_empty_mapped_file.tmp"));
+    std::remove("temp_empty_mapped_file.tmp");
+}
+
+TEST(MappedFile, givenNonExistingFileWhenOpenedThenNullptrIsReturned) {
+    EXPECT_EQ(nullptr, MappedFile::open("temp_file_that_does_not_exist.tmp"));
+}
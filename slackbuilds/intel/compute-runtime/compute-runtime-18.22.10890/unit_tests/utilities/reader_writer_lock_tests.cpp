@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/reader_writer_lock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(ReaderWriterLockTest, givenReaderHoldingLockWhenAnotherReaderLocksThenItDoesNotWait) {
+    ReaderWriterLock lock;
+    std::atomic<bool> secondReaderEntered(false);
+
+    lock.lock_shared();
+    std::thread reader([&]() {
+        SharedLockGuard<ReaderWriterLock> guard(lock);
+        secondReaderEntered = true;
+    });
+    reader.join();
+    EXPECT_TRUE(secondReaderEntered);
+    lock.unlock_shared();
+}
+
+TEST(ReaderWriterLockTest, givenReaderHoldingLockWhenWriterLocksThenWriterWaitsForReader) {
+    ReaderWriterLock lock;
+    std::atomic<bool> writerStarted(false);
+    std::atomic<bool> writerEntered(false);
+
+    lock.lock_shared();
+    std::thread writer([&]() {
+        writerStarted = true;
+        std::lock_guard<ReaderWriterLock> guard(lock);
+        writerEntered = true;
+    });
+    while (!writerStarted) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(writerEntered);
+
+    lock.unlock_shared();
+    writer.join();
+    EXPECT_TRUE(writerEntered);
+}
+
+struct ReaderWriterLockWithWaitingWriters : public ReaderWriterLock {
+    uint32_t peekWaitingWriters() {
+        std::lock_guard<std::mutex> guard(mtx);
+        return waitingWriters;
+    }
+};
+
+TEST(ReaderWriterLockTest, givenWriterWaitingForReaderWhenAnotherReaderLocksThenItWaitsForWriter) {
+    ReaderWriterLockWithWaitingWriters lock;
+    std::atomic<bool> writerEntered(false);
+    std::atomic<bool> secondReaderEntered(false);
+
+    lock.lock_shared();
+    std::thread writer([&]() {
+        std::lock_guard<ReaderWriterLock> guard(lock);
+        writerEntered = true;
+    });
+    while (lock.peekWaitingWriters() == 0) {
+        std::this_thread::yield();
+    }
+    std::thread reader([&]() {
+        SharedLockGuard<ReaderWriterLock> guard(lock);
+        EXPECT_TRUE(writerEntered);
+        secondReaderEntered = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(writerEntered);
+
+    lock.unlock_shared();
+    writer.join();
+    reader.join();
+    EXPECT_TRUE(secondReaderEntered);
+}
+
+TEST(ReaderWriterLockTest, givenManyReadersAndWritersThenWritersAreExclusive) {
+    ReaderWriterLock lock;
+    const int threadsCount = 4;
+    const int iterationsCount = 10000;
+    int value[2] = {};
+    std::atomic<int> tornReads(0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < threadsCount; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterationsCount; j++) {
+                std::lock_guard<ReaderWriterLock> guard(lock);
+                value[0]++;
+                value[1]++;
+            }
+        });
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterationsCount; j++) {
+                SharedLockGuard<ReaderWriterLock> guard(lock);
+                if (value[0] != value[1]) {
+                    tornReads++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(threadsCount * iterationsCount, value[0]);
+    EXPECT_EQ(value[0], value[1]);
+    EXPECT_EQ(0, tornReads);
+}
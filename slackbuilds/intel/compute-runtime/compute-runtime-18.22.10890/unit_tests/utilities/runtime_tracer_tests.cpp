@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/runtime_tracer.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace OCLRT;
+
+class RuntimeTracerTest : public ::testing::Test {
+  public:
+    void TearDown() override {
+        RuntimeTracer::reset();
+    }
+};
+
+TEST_F(RuntimeTracerTest, givenDisabledTracerWhenScopeEndsThenNothingIsRecorded) {
+    EXPECT_FALSE(RuntimeTracer::isEnabled());
+    {
+        TRACE_SCOPE(Api, "clFinish");
+    }
+    EXPECT_EQ(0u, RuntimeTracer::getBuffersCount());
+    EXPECT_FALSE(RuntimeTracer::exportChromeTrace());
+}
+
+TEST_F(RuntimeTracerTest, givenEnabledTracerWhenScopesEndThenCompleteEventsAreExported) {
+    RuntimeTracer::enable(16, "");
+    {
+        TRACE_SCOPE(Api, "clEnqueueNDRangeKernel");
+        {
+            TRACE_SCOPE(Flush, "flushTask");
+        }
+    }
+    EXPECT_EQ(1u, RuntimeTracer::getBuffersCount());
+
+    std::stringstream trace;
+    RuntimeTracer::exportChromeTrace(trace);
+    auto json = trace.str();
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    auto flushEvent = json.find("{\"name\":\"flushTask\",\"cat\":\"flush\",\"ph\":\"X\",\"ts\":");
+    auto apiEvent = json.find("{\"name\":\"clEnqueueNDRangeKernel\",\"cat\":\"api\",\"ph\":\"X\",\"ts\":");
+    EXPECT_NE(std::string::npos, flushEvent);
+    EXPECT_NE(std::string::npos, apiEvent);
+    EXPECT_LT(flushEvent, apiEvent);
+    EXPECT_NE(std::string::npos, json.find("\"pid\":1,\"tid\":0}"));
+    EXPECT_NE(std::string::npos, json.find("],\"displayTimeUnit\":\"ns\"}"));
+}
+
+TEST_F(RuntimeTracerTest, givenDisabledTracerWhenScopeStartedBeforeDisableEndsThenEventIsStillRecorded) {
+    RuntimeTracer::enable(16, "");
+    {
+        TRACE_SCOPE(Wait, "waitForCompletionWithTimeout");
+        RuntimeTracer::disable();
+        {
+            TRACE_SCOPE(Wait, "notTraced");
+        }
+    }
+    std::stringstream trace;
+    RuntimeTracer::exportChromeTrace(trace);
+    EXPECT_NE(std::string::npos, trace.str().find("waitForCompletionWithTimeout"));
+    EXPECT_EQ(std::string::npos, trace.str().find("notTraced"));
+}
+
+TEST(TraceBufferTest, givenFullBufferWhenEventIsRecordedThenOldestEventIsOverwritten) {
+    TraceBuffer buffer(4, 0);
+    const char *names[] = {"a", "b", "c", "d", "e", "f"};
+    for (uint64_t i = 0; i < 6; i++) {
+        buffer.record(TraceCategory::Allocation, names[i], i, i + 1);
+    }
+    EXPECT_EQ(6u, buffer.peekWrittenCount());
+
+    auto events = buffer.getEvents();
+    ASSERT_EQ(4u, events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+        EXPECT_EQ(names[i + 2], events[i].name);
+        EXPECT_EQ(i + 2, events[i].start);
+        EXPECT_EQ(TraceCategory::Allocation, events[i].category);
+    }
+}
+
+TEST_F(RuntimeTracerTest, givenEventsPerThreadNotPowerOfTwoWhenEnabledThenBufferCapacityIsRoundedUp) {
+    RuntimeTracer::enable(5, "");
+    RuntimeTracer::record(TraceCategory::Submit, "execbuffer", 0, 1);
+    ASSERT_EQ(1u, RuntimeTracer::getBuffersCount());
+
+    std::stringstream trace;
+    RuntimeTracer::exportChromeTrace(trace);
+    EXPECT_NE(std::string::npos, trace.str().find("\"cat\":\"submit\""));
+}
+
+TEST_F(RuntimeTracerTest, givenTwoThreadsWhenTracingThenEachThreadRecordsToItsOwnBuffer) {
+    RuntimeTracer::enable(16, "");
+    {
+        TRACE_SCOPE(Enqueue, "mainThread");
+    }
+    std::thread worker([]() {
+        TRACE_SCOPE(Enqueue, "workerThread");
+    });
+    worker.join();
+    EXPECT_EQ(2u, RuntimeTracer::getBuffersCount());
+
+    std::stringstream trace;
+    RuntimeTracer::exportChromeTrace(trace);
+    auto json = trace.str();
+    auto workerEvent = json.find("workerThread");
+    ASSERT_NE(std::string::npos, workerEvent);
+    EXPECT_NE(std::string::npos, json.find("\"tid\":1}", workerEvent));
+}
+
+TEST_F(RuntimeTracerTest, givenResetTracerWhenEnabledAgainThenThreadObtainsNewBuffer) {
+    RuntimeTracer::enable(16, "");
+    RuntimeTracer::record(TraceCategory::Api, "first", 0, 1);
+    RuntimeTracer::reset();
+    EXPECT_EQ(0u, RuntimeTracer::getBuffersCount());
+
+    RuntimeTracer::enable(16, "");
+    RuntimeTracer::record(TraceCategory::Api, "second", 0, 1);
+    EXPECT_EQ(1u, RuntimeTracer::getBuffersCount());
+
+    std::stringstream trace;
+    RuntimeTracer::exportChromeTrace(trace);
+    EXPECT_EQ(std::string::npos, trace.str().find("first"));
+    EXPECT_NE(std::string::npos, trace.str().find("second"));
+}
+
+TEST_F(RuntimeTracerTest, givenThreadHoldingBufferWhenTracerIsResetThenThreadKeepsRecordingIntoRetiredBuffer) {
+    RuntimeTracer::enable(16, "");
+    std::atomic<bool> bufferObtained{false};
+    std::atomic<bool> tracerReset{false};
+    std::thread worker([&]() {
+        RuntimeTracer::record(TraceCategory::Api, "beforeReset", 0, 1);
+        bufferObtained = true;
+        while (!tracerReset)
+            ;
+        for (uint64_t i = 0; i < 64; i++) {
+            RuntimeTracer::record(TraceCategory::Api, "afterReset", i, i + 1);
+        }
+    });
+    while (!bufferObtained)
+        ;
+    RuntimeTracer::reset();
+    tracerReset = true;
+    worker.join();
+
+    EXPECT_EQ(0u, RuntimeTracer::getBuffersCount());
+}
+
+TEST(TraceBufferTest, givenEventsOverwrittenWhileExportingWhenEventsAreReadThenOnlyCompleteEventsAreReturned) {
+    TraceBuffer buffer(4, 0);
+    const char *name = "event";
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (uint64_t i = 0; i < 100000; i++) {
+            buffer.record(TraceCategory::Flush, name, i, i);
+        }
+        done = true;
+    });
+    while (!done) {
+        for (auto &event : buffer.getEvents()) {
+            EXPECT_EQ(name, event.name);
+            EXPECT_EQ(event.start, event.end);
+        }
+    }
+    writer.join();
+    EXPECT_EQ(4u, buffer.getEvents().size());
+}
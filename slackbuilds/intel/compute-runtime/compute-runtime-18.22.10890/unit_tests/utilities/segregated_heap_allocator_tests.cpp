@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace OCLRT;
+
+const size_t sizeThreshold = 16 * 4096;
+
+class SegregatedHeapAllocatorUnderTest : public SegregatedHeapAllocator {
+  public:
+    SegregatedHeapAllocatorUnderTest(uint64_t address, uint64_t size, size_t threshold) : SegregatedHeapAllocator(address, size, threshold) {}
+
+    using SegregatedHeapAllocator::freeChunksByAddress;
+    using SegregatedHeapAllocator::getSizeClass;
+    using SegregatedHeapAllocator::nonEmptySizeClasses;
+    using SegregatedHeapAllocator::sizeClasses;
+};
+
+TEST(SegregatedHeapAllocatorTest, givenNewAllocatorThenWholeRangeIsOneFreeChunk) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    ASSERT_EQ(1u, heapAllocator.freeChunksByAddress.size());
+    EXPECT_EQ(ptrBase, heapAllocator.freeChunksByAddress.begin()->first);
+    EXPECT_EQ(size, heapAllocator.freeChunksByAddress.begin()->second);
+    EXPECT_EQ(1ull << heapAllocator.getSizeClass(size), heapAllocator.nonEmptySizeClasses);
+    EXPECT_EQ(size, heapAllocator.getLeftSize());
+}
+
+TEST(SegregatedHeapAllocatorTest, givenSmallAndBigAllocationsThenSmallAreTakenFromTopAndBigFromBottom) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    size_t smallSize = 4096;
+    size_t bigSize = 2 * sizeThreshold;
+    auto smallPtr = heapAllocator.allocate(smallSize);
+    auto bigPtr = heapAllocator.allocate(bigSize);
+
+    EXPECT_EQ(ptrBase + size - smallSize, smallPtr);
+    EXPECT_EQ(ptrBase, bigPtr);
+    EXPECT_EQ(size - smallSize - bigSize, heapAllocator.getLeftSize());
+}
+
+TEST(SegregatedHeapAllocatorTest, givenUnalignedSizeWhenAllocatingThenSizeIsAlignedToPage) {
+    SegregatedHeapAllocatorUnderTest heapAllocator(0x100000llu, 1024 * 4096, sizeThreshold);
+
+    size_t sizeToAllocate = 100;
+    auto ptr = heapAllocator.allocate(sizeToAllocate);
+    EXPECT_NE(0llu, ptr);
+    EXPECT_EQ(MemoryConstants::pageSize, sizeToAllocate);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenTooBigSizeWhenAllocatingThenZeroIsReturned) {
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(0x100000llu, size, sizeThreshold);
+
+    size_t sizeToAllocate = size + 4096;
+    EXPECT_EQ(0llu, heapAllocator.allocate(sizeToAllocate));
+}
+
+TEST(SegregatedHeapAllocatorTest, givenFreedNeighboursWhenFreeIsCalledThenChunksAreCoalesced) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    size_t sizes[3] = {4096, 4096, 4096};
+    uint64_t ptrs[3];
+    for (int i = 0; i < 3; i++) {
+        ptrs[i] = heapAllocator.allocate(sizes[i]);
+    }
+
+    heapAllocator.free(ptrs[0], sizes[0]);
+    heapAllocator.free(ptrs[2], sizes[2]);
+    EXPECT_EQ(2u, heapAllocator.freeChunksByAddress.size());
+
+    heapAllocator.free(ptrs[1], sizes[1]);
+    ASSERT_EQ(1u, heapAllocator.freeChunksByAddress.size());
+    EXPECT_EQ(ptrBase, heapAllocator.freeChunksByAddress.begin()->first);
+    EXPECT_EQ(size, heapAllocator.freeChunksByAddress.begin()->second);
+    EXPECT_EQ(size, heapAllocator.getLeftSize());
+}
+
+TEST(SegregatedHeapAllocatorTest, givenFreedHolesWhenAllocatingThenBestFittingHoleIsUsed) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    size_t sizes[4] = {3 * 4096, 4096, 2 * 4096, 4096};
+    uint64_t ptrs[4];
+    for (int i = 0; i < 4; i++) {
+        ptrs[i] = heapAllocator.allocate(sizes[i]);
+    }
+    heapAllocator.free(ptrs[0], sizes[0]);
+    heapAllocator.free(ptrs[2], sizes[2]);
+
+    size_t sizeToAllocate = 2 * 4096;
+    EXPECT_EQ(ptrs[2], heapAllocator.allocate(sizeToAllocate));
+}
+
+TEST(SegregatedHeapAllocatorTest, givenOnlyBiggerSizeClassAvailableWhenAllocatingThenChunkIsSplit) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 64 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    size_t sizeToAllocate = 3 * 4096;
+    auto ptr = heapAllocator.allocate(sizeToAllocate);
+    EXPECT_EQ(ptrBase + size - sizeToAllocate, ptr);
+    ASSERT_EQ(1u, heapAllocator.freeChunksByAddress.size());
+    EXPECT_EQ(size - sizeToAllocate, heapAllocator.freeChunksByAddress.begin()->second);
+    EXPECT_TRUE(heapAllocator.sizeClasses[heapAllocator.getSizeClass(size)].empty());
+}
+
+TEST(SegregatedHeapAllocatorTest, givenRandomAllocationsAndFreesThenAllocationsDoNotOverlapAndWholeSpaceIsReclaimed) {
+    uint64_t ptrBase = 0x100000llu;
+    size_t size = 1024 * 4096;
+    SegregatedHeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    std::mt19937 generator(0);
+    std::vector<std::pair<uint64_t, size_t>> allocations;
+    for (int i = 0; i < 2000; i++) {
+        if (allocations.empty() || generator() % 2) {
+            size_t sizeToAllocate = (generator() % 32 + 1) * 4096;
+            auto ptr = heapAllocator.allocate(sizeToAllocate);
+            if (ptr == 0llu) {
+                continue;
+            }
+            EXPECT_LE(ptrBase, ptr);
+            EXPECT_GE(ptrBase + size, ptr + sizeToAllocate);
+            for (auto &allocation : allocations) {
+                EXPECT_TRUE(ptr + sizeToAllocate <= allocation.first || allocation.first + allocation.second <= ptr);
+            }
+            allocations.emplace_back(ptr, sizeToAllocate);
+        } else {
+            auto index = generator() % allocations.size();
+            heapAllocator.free(allocations[index].first, allocations[index].second);
+            allocations.erase(allocations.begin() + index);
+        }
+    }
+    for (auto &allocation : allocations) {
+        heapAllocator.free(allocation.first, allocation.second);
+    }
+
+    EXPECT_EQ(size, heapAllocator.getLeftSize());
+    EXPECT_EQ(1u, heapAllocator.freeChunksByAddress.size());
+    size_t sizeToAllocate = size;
+    EXPECT_EQ(ptrBase, heapAllocator.allocate(sizeToAllocate));
+}
+
+TEST(SegregatedHeapAllocatorTest, givenDebugVariableWhenHeapAllocatorIsCreatedThenProperBackendIsUsed) {
+    DebugManagerStateRestore restorer;
+
+    DebugManager.flags.UseSegregatedHeapAllocator.set(false);
+    auto heapAllocator = createHeapAllocator(0x100000llu, 1024 * 4096);
+    EXPECT_EQ(nullptr, dynamic_cast<SegregatedHeapAllocator *>(heapAllocator.get()));
+
+    DebugManager.flags.UseSegregatedHeapAllocator.set(true);
+    heapAllocator = createHeapAllocator(0x100000llu, 1024 * 4096);
+    EXPECT_NE(nullptr, dynamic_cast<SegregatedHeapAllocator *>(heapAllocator.get()));
+}
@@ -26,6 +26,7 @@
 #include "unit_tests/fixtures/memory_allocator_fixture.h"
 
 #include <cstdint>
+#include <thread>
 
 using namespace OCLRT;
 
@@ -38,6 +39,13 @@ struct timeStamps {
 
 class MockTagAllocator : public TagAllocator<timeStamps> {
   public:
+    using TagAllocator<timeStamps>::abaCounterIncrement;
+    using TagAllocator<timeStamps>::freeTagsHead;
+    using TagAllocator<timeStamps>::popFreeTag;
+    using TagAllocator<timeStamps>::pushFreeTags;
+    using TagAllocator<timeStamps>::threadCacheBatchSize;
+    using TagAllocator<timeStamps>::threadCacheSize;
+
     MockTagAllocator(MemoryManager *memMngr, size_t tagCount, size_t tagAlignment) : TagAllocator<timeStamps>(memMngr, tagCount, tagAlignment) {
     }
 
@@ -46,19 +54,35 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     }
 
     TagNode<timeStamps> *getFreeTagsHead() {
-        return TagAllocator<timeStamps>::freeTags.peekHead();
+        return getNode(freeTagsHead.load());
+    }
+
+    uint32_t getThreadCacheCount() {
+        auto &threadCache = getThreadCache();
+        return (threadCache.allocatorId == allocatorId) ? threadCache.count : 0u;
     }
 
-    TagNode<timeStamps> *getUsedTagsHead() {
-        return TagAllocator<timeStamps>::usedTags.peekHead();
+    bool isOnFreeList(TagNode<timeStamps> *node) {
+        for (auto freeNode = getFreeTagsHead(); freeNode != nullptr; freeNode = getNextFree(freeNode)) {
+            if (freeNode == node) {
+                return true;
+            }
+        }
+        return false;
     }
 
-    IDList<TagNode<timeStamps>> &getFreeTags() {
-        return TagAllocator<timeStamps>::freeTags;
+    bool isInThreadCache(TagNode<timeStamps> *node) {
+        auto &threadCache = getThreadCache();
+        for (uint32_t i = 0; i < getThreadCacheCount(); i++) {
+            if (threadCache.nodes[i] == node) {
+                return true;
+            }
+        }
+        return false;
     }
 
-    IDList<TagNode<timeStamps>> &getUsedTags() {
-        return TagAllocator<timeStamps>::usedTags;
+    bool isFree(TagNode<timeStamps> *node) {
+        return isOnFreeList(node) || isInThreadCache(node);
     }
 
     size_t getGraphicsAllocationsCount() {
@@ -77,7 +101,7 @@ TEST_F(TagAllocatorTest, Initialize) {
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
 
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.getThreadCacheCount());
 
     void *gfxMemory = tagAllocator.getGraphicsAllocation()->getUnderlyingBuffer();
     void *head = reinterpret_cast<void *>(tagAllocator.getFreeTagsHead()->tag);
@@ -90,28 +114,17 @@ TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
 
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.getThreadCacheCount());
 
     TagNode<timeStamps> *tagNode = tagAllocator.getTag();
 
     EXPECT_NE(nullptr, tagNode);
-
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    IDList<TagNode<timeStamps>> &usedList = tagAllocator.getUsedTags();
-
-    bool isFoundOnUsedList = usedList.peekContains(*tagNode);
-    bool isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_FALSE(isFoundOnFreeList);
-    EXPECT_TRUE(isFoundOnUsedList);
+    EXPECT_FALSE(tagAllocator.isFree(tagNode));
 
     tagAllocator.returnTag(tagNode);
 
-    isFoundOnUsedList = usedList.peekContains(*tagNode);
-    isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_TRUE(isFoundOnFreeList);
-    EXPECT_FALSE(isFoundOnUsedList);
+    EXPECT_TRUE(tagAllocator.isFree(tagNode));
+    EXPECT_TRUE(tagAllocator.isInThreadCache(tagNode));
 }
 
 TEST_F(TagAllocatorTest, TagAlignment) {
@@ -175,27 +188,21 @@ TEST_F(TagAllocatorTest, GetTagsAndReturnInDifferentOrder) {
     EXPECT_EQ(2u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(2u, tagAllocator.getTagPoolCount());
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    bool isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
-    EXPECT_FALSE(isFoundOnFreeList);
+    EXPECT_FALSE(tagAllocator.isFree(tagNodes[0]));
 
     tagAllocator.returnTag(tagNodes[2]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[2]);
-    EXPECT_TRUE(isFoundOnFreeList);
-    EXPECT_NE(nullptr, tagAllocator.getFreeTagsHead());
+    EXPECT_TRUE(tagAllocator.isFree(tagNodes[2]));
 
     tagAllocator.returnTag(tagNodes[3]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[3]);
-    EXPECT_TRUE(isFoundOnFreeList);
+    EXPECT_TRUE(tagAllocator.isFree(tagNodes[3]));
 
     tagAllocator.returnTag(tagNodes[1]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[1]);
-    EXPECT_TRUE(isFoundOnFreeList);
+    EXPECT_TRUE(tagAllocator.isFree(tagNodes[1]));
 
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
-    EXPECT_FALSE(isFoundOnFreeList);
+    EXPECT_FALSE(tagAllocator.isFree(tagNodes[0]));
 
     tagAllocator.returnTag(tagNodes[0]);
+    EXPECT_TRUE(tagAllocator.isFree(tagNodes[0]));
 }
 
 TEST_F(TagAllocatorTest, GetTagsFromTwoPools) {
@@ -251,3 +258,77 @@ TEST_F(TagAllocatorTest, CleanupResources) {
     EXPECT_EQ(0u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(0u, tagAllocator.getTagPoolCount());
 }
+
+TEST_F(TagAllocatorTest, givenEmptyThreadCacheWhenTagIsTakenThenBatchOfTagsIsMovedFromFreeList) {
+    MockTagAllocator tagAllocator(memoryManager, 100, 64);
+
+    auto tagNode = tagAllocator.getTag();
+    EXPECT_EQ(MockTagAllocator::threadCacheBatchSize - 1, tagAllocator.getThreadCacheCount());
+    EXPECT_FALSE(tagAllocator.isFree(tagNode));
+
+    tagAllocator.returnTag(tagNode);
+}
+
+TEST_F(TagAllocatorTest, givenFullThreadCacheWhenTagIsReturnedThenOldestTagsAreMovedToFreeList) {
+    MockTagAllocator tagAllocator(memoryManager, 100, 64);
+
+    const uint32_t tagsCount = MockTagAllocator::threadCacheSize + 1;
+    TagNode<timeStamps> *tagNodes[tagsCount];
+    for (uint32_t i = 0; i < tagsCount; i++) {
+        tagNodes[i] = tagAllocator.getTag();
+    }
+    for (uint32_t i = 0; i < tagsCount; i++) {
+        tagAllocator.returnTag(tagNodes[i]);
+    }
+
+    EXPECT_LE(tagAllocator.getThreadCacheCount(), MockTagAllocator::threadCacheSize);
+    EXPECT_TRUE(tagAllocator.isInThreadCache(tagNodes[tagsCount - 1]));
+    for (uint32_t i = 0; i < tagsCount; i++) {
+        EXPECT_TRUE(tagAllocator.isFree(tagNodes[i]));
+    }
+}
+
+TEST_F(TagAllocatorTest, givenTagsReturnedOnOtherThreadWhenThreadExitsThenTagsGoBackToFreeList) {
+    MockTagAllocator tagAllocator(memoryManager, 100, 64);
+    auto tagNode = tagAllocator.getTag();
+
+    std::thread returningThread([&]() {
+        tagAllocator.returnTag(tagNode);
+    });
+    returningThread.join();
+
+    EXPECT_TRUE(tagAllocator.isOnFreeList(tagNode));
+    EXPECT_FALSE(tagAllocator.isInThreadCache(tagNode));
+}
+
+TEST_F(TagAllocatorTest, givenCleanedUpAllocatorWhenTagIsTakenThenStaleThreadCacheIsDropped) {
+    MockTagAllocator tagAllocator(memoryManager, 100, 64);
+    auto tagNode = tagAllocator.getTag();
+    tagAllocator.returnTag(tagNode);
+    EXPECT_NE(0u, tagAllocator.getThreadCacheCount());
+
+    tagAllocator.cleanUpResources();
+    EXPECT_EQ(0u, tagAllocator.getThreadCacheCount());
+    EXPECT_EQ(nullptr, tagAllocator.getFreeTagsHead());
+
+    tagNode = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode);
+    EXPECT_EQ(tagAllocator.getGraphicsAllocation(0), tagNode->getGraphicsAllocation());
+    EXPECT_EQ(1u, tagAllocator.getGraphicsAllocationsCount());
+}
+
+TEST_F(TagAllocatorTest, givenMoreThan16BitsOfFreeListUpdatesWhenHeadIsReadThenCounterHasNotWrapped) {
+    MockTagAllocator tagAllocator(memoryManager, 100, 64);
+    auto counterBefore = tagAllocator.freeTagsHead.load() / MockTagAllocator::abaCounterIncrement;
+
+    const uint64_t iterations = (1u << 16) + 1;
+    for (uint64_t i = 0; i < iterations; i++) {
+        auto tagNode = tagAllocator.popFreeTag();
+        ASSERT_NE(nullptr, tagNode);
+        tagAllocator.pushFreeTags(tagNode, tagNode);
+        ASSERT_EQ(tagNode, tagAllocator.getFreeTagsHead());
+    }
+
+    auto counterAfter = tagAllocator.freeTagsHead.load() / MockTagAllocator::abaCounterIncrement;
+    EXPECT_EQ(counterBefore + 2 * iterations, counterAfter);
+}